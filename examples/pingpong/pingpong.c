@@ -24,19 +24,19 @@ static void PingPong_dispatch(Active *const me, ACT_Evt const *const e)
     }
     case PING:
     {
-      ACT_DBGPRINT("%p received Ping from %p!\n\n", me, e->_sender);
-      if (e->_sender)
+      ACT_DBGPRINT("%p received Ping from %p!\n\n", me, ACT_EVT_SENDER(e));
+      if (ACT_EVT_SENDER(e))
       {
-        ACT_postEvt(e->_sender, EVT_UPCAST(&pongSignal));
+        ACT_postEvt(ACT_EVT_SENDER(e), EVT_UPCAST(&pongSignal));
       }
       break;
     }
     case PONG:
     {
-      ACT_DBGPRINT("%p received Pong from %p!\n\n", me, e->_sender);
-      if (e->_sender)
+      ACT_DBGPRINT("%p received Pong from %p!\n\n", me, ACT_EVT_SENDER(e));
+      if (ACT_EVT_SENDER(e))
       {
-        ACT_postEvt(e->_sender, EVT_UPCAST(&pingSignal));
+        ACT_postEvt(ACT_EVT_SENDER(e), EVT_UPCAST(&pingSignal));
       }
       break;
     }
@@ -47,12 +47,12 @@ static void PingPong_dispatch(Active *const me, ACT_Evt const *const e)
     }
     case TIMEPING:
     {
-      ACT_DBGPRINT("%p received TimePing from %p!\n\n", me, e->_sender);
+      ACT_DBGPRINT("%p received TimePing from %p!\n\n", me, ACT_EVT_SENDER(e));
       break;
     }
     case TIMEPONG:
     {
-      ACT_DBGPRINT("%p received TimePong from %p!\n\n", me, e->_sender);
+      ACT_DBGPRINT("%p received TimePong from %p!\n\n", me, ACT_EVT_SENDER(e));
       break;
     }
 
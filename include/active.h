@@ -4,11 +4,24 @@
 #include <active_config_loader.h>
 
 #include <active_assert.h>
+#include <active_batch.h>
+#include <active_bcast.h>
+#include <active_boost.h>
+#include <active_defer.h>
+#include <active_group.h>
+#include <active_isr.h>
 #include <active_mem.h>
+#include <active_mempool.h>
 #include <active_msg.h>
 #include <active_psmsg.h>
 #include <active_port.h>
+#include <active_reactor.h>
+#include <active_recorder.h>
+#include <active_rpc.h>
+#include <active_mbox.h>
+#include <active_stream.h>
 #include <active_timer.h>
+#include <active_trace.h>
 #include <active_types.h>
 
 /***************************
@@ -18,9 +31,6 @@
 /* Upcast Active object implementatios */
 #define ACT_UPCAST(ptr) ((Active *const)(ptr))
 
-/* Dispatch handler function pointer type for active object implementations */
-typedef void (*ACT_DispatchFn)(Active *me, ACT_Evt const *const e);
-
 /* Active object data structure. To be used by active object implementations through polymorphism */
 /**
  * @brief Active object data structure. Do not access from application
@@ -31,6 +41,30 @@ struct active_object
   ACT_THREADPTR(thread);
   ACT_QPTR(queue);
   ACT_DispatchFn dispatch;
+#if ACT_ACTOR_REGISTRY == 1
+  ACT_Handle _id; // Handle of active object, set by ACT_init
+#endif
+#if ACT_CFG_SHM == 1
+  ACT_PostFn _post; // Replaces queuing in ACT_postEvt if set. NULL for local Active objects
+#endif
+#if ACT_CFG_DEFER == 1
+  ACT_DeferQueue _defer; // Deferred events, see ACT_defer
+#endif
+#if ACT_CFG_ISR_POST == 1
+  ACT_IsrSources _isr; // Interrupt sources posting with ACT_postFromISR
+#endif
+#if ACT_CFG_MEM_QUOTA == 1
+  uint8_t _memClass; // Memory class charged for events allocated by the Active object, see ACT_setMemClass
+#endif
+#if ACT_CFG_BOOST == 1
+  ACT_Boost _boost; // Priority boost when the queue fills, see ACT_setBoost
+#endif
+#if ACT_CFG_BATCH == 1
+  ACT_Batches _batch; // Batch handlers, see ACT_setBatch
+#endif
+#if ACT_CFG_EVT_TIMESTAMP == 1
+  uint32_t _postedAt; // Post time stamp of the event taken last, recalled events are stamped when recalled
+#endif
 };
 
 /**
@@ -62,6 +96,57 @@ struct active_queueData
   size_t maxMsg;
 };
 
+/**
+ * @brief Entry of the actor table, one per Active object defined with ACT_DEFINE. The linker collects the entries in
+ * a table that ACT_startAll, tools and statistics iterate with ACT_ACTOR_FOREACH.
+ */
+struct active_actorDef
+{
+  char const *name;        // Name of the Active object symbol
+  Active *me;              // Active object
+  ACT_DispatchFn dispatch; // Dispatch function
+  ACT_QueueData qd;        // Queue related data
+  ACT_ThreadData td;       // Thread related data
+};
+
+/**
+ * @brief Define an Active object of an application type embedding Active as first member, with its queue, thread and
+ * stack, and add it to the actor table. The Active object is initialized and started by ACT_startAll.
+ *
+ * @param type Application Active object type
+ * @param symbol Symbol of the Active object
+ * @param dispatchFn Dispatch function
+ * @param qlen Max number of queued events
+ * @param stackSize Thread stack size
+ * @param prio Thread priority, see ACT_THREAD_PRI
+ */
+#define ACT_DEFINE_TYPE(type, symbol, dispatchFn, qlen, stackSize, prio)                                               \
+  type symbol;                                                                                                         \
+  static ACT_QBUF(symbol##_qBuf, qlen);                                                                                \
+  static ACT_Q(symbol##_q);                                                                                            \
+  static ACT_THREAD(symbol##_thread);                                                                                  \
+  static ACT_THREAD_STACK_DEFINE(symbol##_stack, stackSize);                                                           \
+  ACT_ACTOR_TABLE_ENTRY(symbol##_actorDef) = {.name = #symbol,                                                         \
+                                              .me = (Active *)&symbol,                                                 \
+                                              .dispatch = (dispatchFn),                                                \
+                                              .qd = {.queue = &symbol##_q, .queBuf = symbol##_qBuf, .maxMsg = (qlen)}, \
+                                              .td = {.thread = &symbol##_thread,                                       \
+                                                     .stack = symbol##_stack,                                          \
+                                                     .stack_size = ACT_THREAD_STACK_SIZEOF(symbol##_stack),            \
+                                                     .pri = (prio)}}
+
+/* Define an Active object with its queue, thread and stack, see ACT_DEFINE_TYPE */
+#define ACT_DEFINE(symbol, dispatchFn, qlen, stackSize, prio) ACT_DEFINE_TYPE(Active, symbol, dispatchFn, qlen, stackSize, prio)
+
+/* Iterate the actor table. defPtr is declared as ACT_ActorDef const pointer */
+#define ACT_ACTOR_FOREACH(defPtr) ACT_ACTOR_TABLE_FOREACH(defPtr)
+
+/**
+ * @brief Initialize all Active objects of the actor table, then start them. Active objects defined with ACT_DEFINE
+ * can post to each other from their start events.
+ */
+void ACT_startAll(void);
+
 /**
  * @brief Initialize an active object data structure beforing using it.
  *
@@ -82,6 +167,26 @@ void ACT_start(Active *const me);
 /* @private - Thread function for all active obects. Used by Active framework ports */
 void ACT_threadFn(Active *me);
 
+/* @private - Let active object process the start event. Used by ports that do not run ACT_threadFn (e.g. simulation) */
+void ACT_threadInit(Active *me);
+
+/* @private - Let active object process one event taken from its queue. Used by ports that do not run ACT_threadFn */
+void ACT_threadProcess(Active *me, ACT_Evt *e);
+
+/* @private - Take the next event to process: a recalled or held event, else from the queue (blocking on threaded ports).
+Returns NULL if the queue dropped a stale event instead. Shared by ACT_threadFn and ports that do not run it */
+ACT_Evt *ACT_threadNext(Active *me);
+
+/* @private - Take the next event from the queue (blocking on threaded ports) and keep its post time stamp.
+Returns NULL if the queue dropped a stale event instead. Used by ACT_threadNext and batching */
+ACT_Evt *ACT_threadTake(Active *me);
+
+/* @private - Check if the active object holds events to process outside its queue (recalled or batch held events) */
+bool ACT_threadHasHeld(Active const *me);
+
+/* @private - Initialize the port independent fields and the queue of an active object. Called by ACT_init of all ports */
+void ACT_initCommon(Active *const me, ACT_DispatchFn dispatch, ACT_QueueData const *qd, ACT_ThreadData const *td);
+
 /* Post event directly to receiver */
 /**
  * @brief Post an event directly to a receiving active object
@@ -92,9 +197,70 @@ void ACT_threadFn(Active *me);
  */
 int ACT_postEvt(Active const *const receiver, ACT_Evt const *const e);
 
+/**
+ * @brief Get the number of events waiting in the queue of an active object
+ *
+ * @param me Pointer to the active object
+ * @return size_t Number of queued events
+ */
+size_t ACT_getQueueUsed(Active const *const me);
+
+#if ACT_CFG_RPC == 1
+/* @private - Post event tagged with a correlation ID. Used by request/reply */
+int ACT_postEvtCorr(Active const *const receiver, ACT_Evt const *const e, uint16_t corrId);
+#endif
+
 /* @private: Interface for Active timer to post time back to sender object (delegation)*/
 int ACT_postTimEvt(ACT_TimEvt *te);
 
+#if ACT_ACTOR_REGISTRY == 1
+/* @private - Register an active object to give it a handle. Used by ACT_initCommon */
+void ACT_register(Active *const me);
+
+/**
+ * @brief Get the handle of an initialized active object
+ *
+ * @param me Pointer to the active object
+ * @return ACT_Handle Handle of the active object, ACT_HANDLE_NONE for NULL
+ */
+ACT_Handle ACT_getHandle(Active const *const me);
+
+/**
+ * @brief Get an active object from its handle
+ *
+ * @param h Handle of the active object
+ * @return Active* Pointer to the active object, NULL for ACT_HANDLE_NONE
+ */
+Active *ACT_fromHandle(ACT_Handle h);
+#endif /* ACT_ACTOR_REGISTRY == 1 */
+
+#if ACT_CFG_EVT_HANDLES == 1
+/* @internal - Convert between events and event references of queue entries. Handles of static events are counted */
+#define ACT_QEVTREF_FROM_EVT(e) ACT_mem_toHandle(e)
+#define ACT_QEVTREF_TO_EVT(ref) ACT_mem_fromHandle(ref)
+#define ACT_QEVTREF_RETAIN(ref) ACT_mem_retainHandle(ref)
+#define ACT_QEVTREF_RELEASE(ref) ACT_mem_releaseHandle(ref)
+#else
+#define ACT_QEVTREF_FROM_EVT(e) ((ACT_QEvtRef)(e))
+#define ACT_QEVTREF_TO_EVT(ref) (ref)
+#define ACT_QEVTREF_RETAIN(ref) ((void)(ref))
+#define ACT_QEVTREF_RELEASE(ref) ((void)(ref))
+#endif /* ACT_CFG_EVT_HANDLES == 1 */
+
+#if ACT_CFG_EVT_TIMESTAMP == 1
+/* @internal - Convert between events and queue entries. An entry made from an event is time stamped */
+#define ACT_QENTRY_FROM_EVT(e) ((ACT_QEntry){.evt = ACT_QEVTREF_FROM_EVT(e), .postedAt = ACT_CYCLES_GET()})
+#define ACT_QENTRY_EVTREF(entry) ((entry).evt)
+#else
+#define ACT_QENTRY_FROM_EVT(e) ACT_QEVTREF_FROM_EVT(e)
+#define ACT_QENTRY_EVTREF(entry) (entry)
+#endif /* ACT_CFG_EVT_TIMESTAMP == 1 */
+#define ACT_QENTRY_TO_EVT(entry) ACT_QEVTREF_TO_EVT(ACT_QENTRY_EVTREF(entry))
+
+/* @internal - Count another queued copy of an entry made by ACT_QENTRY_FROM_EVT. Release entries taken or dropped from a queue */
+#define ACT_QENTRY_RETAIN(entry) ACT_QEVTREF_RETAIN(ACT_QENTRY_EVTREF(entry))
+#define ACT_QENTRY_RELEASE(entry) ACT_QEVTREF_RELEASE(ACT_QENTRY_EVTREF(entry))
+
 /**
  * @brief Helper macros
  *
@@ -102,4 +268,10 @@ int ACT_postTimEvt(ACT_TimEvt *te);
 
 #define ACT_ARG_UNUSED(param) (void)(param)
 
+/* Coroutine Active objects, shared memory proxies, state machines and offload workers embed the Active object data structure */
+#include <active_coro.h>
+#include <active_hsm.h>
+#include <active_offload.h>
+#include <active_shm.h>
+
 #endif /* ACTIVE_H */
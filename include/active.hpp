@@ -0,0 +1,429 @@
+#ifndef ACTIVE_HPP
+#define ACTIVE_HPP
+
+#if __cplusplus < 201703L
+#error "active.hpp requires C++17"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/* The C headers use the C11 atomic typedefs and alignment keywords */
+using std::atomic_bool;
+using std::atomic_uint;
+using std::atomic_ushort;
+
+#ifndef _Alignas
+#define _Alignas(x) alignas(x)
+#endif
+#ifndef _Alignof
+#define _Alignof(x) alignof(x)
+#endif
+
+extern "C"
+{
+#include <active.h>
+}
+
+/**
+ * @brief Header-only C++17 layer over Active objects and events.
+ *
+ * Application events are plain structs with a constexpr event type:
+ *
+ *   struct Sample { static constexpr ACT_EvtType type = act::evtType(0); uint32_t timestamp; };
+ *
+ * They are allocated from an EventPool with make_event, which returns a move-only EventPtr holding one reference.
+ * The event is posted with EventPtr::post, and freed when the handle and all receivers are done with it.
+ *
+ * Actor<Derived, Events...> dispatches through a jump table generated at compile time from the listed events. Derived
+ * implements on(Event const &) for each listed event, on(act::Sig<SIG>) for each listed signal, and optionally
+ * on(ACT_Signal const &) or on(ACT_Message const &) for the remaining signals and messages. Events without a handler
+ * are dropped. Handlers are resolved statically: there are no virtual calls, and no heap allocations.
+ *
+ * C Active objects can receive the events too. The struct is stored after the ACT_Evt base, at offset
+ * act::EventInfo<T>::offset, so C code can declare { ACT_Evt super; <same fields> } to read it.
+ */
+
+namespace act
+{
+
+static_assert(sizeof(std::atomic<unsigned int>) == sizeof(unsigned int) &&
+                  sizeof(std::atomic<unsigned short>) == sizeof(unsigned short) &&
+                  sizeof(std::atomic<bool>) == sizeof(bool),
+              "C++ atomics must match the layout of the C atomics");
+
+/* Event type of the n-th application event type */
+constexpr ACT_EvtType evtType(unsigned int n)
+{
+  return static_cast<ACT_EvtType>(ACT_USER_EVT + n);
+}
+
+/* Signal tag. List Sig<SIG> in the events of an Actor to dispatch the signal to on(Sig<SIG>) */
+template <uint16_t S>
+struct Sig
+{
+  static constexpr uint16_t sig = S;
+};
+
+/* Layout of events of type T in their pool block: the ACT_Evt base, then T */
+template <typename T>
+struct EventInfo
+{
+  static_assert(T::type >= ACT_USER_EVT && T::type < ACT_CFG_MAX_EVT_TYPES,
+                "Event type must be ACT_USER_EVT to ACT_CFG_MAX_EVT_TYPES - 1, see act::evtType");
+
+  static constexpr ACT_EvtType type = T::type;
+  static constexpr size_t align = std::max({alignof(ACT_Evt), alignof(T), alignof(void *)});
+  static constexpr size_t offset = (sizeof(ACT_Evt) + alignof(T) - 1) / alignof(T) * alignof(T);
+  static constexpr size_t blockSize = (offset + sizeof(T) + align - 1) / align * align;
+
+  static T *get(ACT_Evt *e)
+  {
+    return std::launder(reinterpret_cast<T *>(reinterpret_cast<char *>(e) + offset));
+  }
+  static T const &get(ACT_Evt const *e)
+  {
+    return *std::launder(reinterpret_cast<T const *>(reinterpret_cast<char const *>(e) + offset));
+  }
+};
+
+/* Built-in signals and messages are dispatched as themselves */
+template <>
+struct EventInfo<ACT_Signal>
+{
+  static constexpr ACT_EvtType type = ACT_SIGNAL;
+  static ACT_Signal const &get(ACT_Evt const *e) { return *reinterpret_cast<ACT_Signal const *>(e); }
+};
+
+template <>
+struct EventInfo<ACT_Message>
+{
+  static constexpr ACT_EvtType type = ACT_MESSAGE;
+  static ACT_Message const &get(ACT_Evt const *e) { return *reinterpret_cast<ACT_Message const *>(e); }
+};
+
+/* Base event of an application event allocated with make_event, e.g. to get its sender with ACT_EVT_SENDER */
+template <typename T>
+ACT_Evt const *evtOf(T const &value)
+{
+  return reinterpret_cast<ACT_Evt const *>(reinterpret_cast<char const *>(&value) - EventInfo<T>::offset);
+}
+
+/**
+ * @brief Pool of N events of type T. The pool registers the event type when constructed, so define it with static
+ * storage duration, one per event type, before events are allocated. The destructor of T is run when an event is
+ * freed, unless T is trivially destructible.
+ */
+template <typename T, size_t N>
+class EventPool
+{
+public:
+  EventPool()
+  {
+#if ACT_CFG_MEMPOOL_LOCKFREE == 1
+    ACT_Mempool_init(&pool_, buf_, Info::blockSize, N);
+#else
+    k_mem_slab_init(&pool_, buf_, Info::blockSize, N);
+#endif
+    ACT_EvtType_register(Info::type, &pool_, std::is_trivially_destructible_v<T> ? nullptr : &destroy);
+  }
+
+  EventPool(EventPool const &) = delete;
+  EventPool &operator=(EventPool const &) = delete;
+
+  /* Number of events allocated from the pool */
+  uint32_t used() const { return ACT_mem_getUsed(Info::type); }
+
+private:
+  using Info = EventInfo<T>;
+
+  static void destroy(ACT_Evt *e) { Info::get(e)->~T(); }
+
+  alignas(Info::align) unsigned char buf_[Info::blockSize * N];
+  ACT_MEMPOOL_TYPE pool_;
+};
+
+/**
+ * @brief Move-only handle to a dynamic event allocated with make_event. Holds one reference, which is released when
+ * the handle is destroyed or reset. Posting adds the references of the receivers, so the event is freed when the
+ * handle and all receivers are done with it. Set the fields before posting; receivers read them concurrently.
+ */
+template <typename T>
+class EventPtr
+{
+public:
+  EventPtr() = default;
+  EventPtr(EventPtr const &) = delete;
+  EventPtr &operator=(EventPtr const &) = delete;
+
+  EventPtr(EventPtr &&other) noexcept : e_(other.e_) { other.e_ = nullptr; }
+
+  EventPtr &operator=(EventPtr &&other) noexcept
+  {
+    if (this != &other)
+    {
+      reset();
+      e_ = other.e_;
+      other.e_ = nullptr;
+    }
+    return *this;
+  }
+
+  ~EventPtr() { reset(); }
+
+  /* Release the reference. The event is freed if it is not queued or processed */
+  void reset()
+  {
+    if (e_ != nullptr)
+    {
+      ACT_Evt const *e = e_;
+      e_ = nullptr;
+      ACT_mem_refdec(e);
+    }
+  }
+
+  /* Post the event, keeping the handle. Can be posted to several receivers */
+  int post(Active const *receiver) const { return ACT_postEvt(receiver, e_); }
+
+  explicit operator bool() const { return e_ != nullptr; }
+  T *get() const { return e_ != nullptr ? EventInfo<T>::get(e_) : nullptr; }
+  T *operator->() const { return get(); }
+  T &operator*() const { return *get(); }
+
+  /* Base event, e.g. to post with the C API */
+  ACT_Evt const *evt() const { return e_; }
+
+private:
+  template <typename U, typename... Args>
+  friend EventPtr<U> try_make_event(Active const *sender, Args &&...args);
+  template <typename U, typename... Args>
+  friend EventPtr<U> make_event(Active const *sender, Args &&...args);
+
+  template <typename... Args>
+  static EventPtr adopt(ACT_Evt *e, Args &&...args)
+  {
+    void *value = reinterpret_cast<char *>(e) + EventInfo<T>::offset;
+    if constexpr (std::is_aggregate_v<T>)
+    {
+      // Members not given are value-initialized, as for any aggregate initialization. Do not warn in user code about it
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+      ::new (value) T{std::forward<Args>(args)...};
+#pragma GCC diagnostic pop
+    }
+    else
+    {
+      ::new (value) T(std::forward<Args>(args)...);
+    }
+
+    ACT_mem_refinc(e);
+    return EventPtr(e);
+  }
+
+  explicit EventPtr(ACT_Evt *e) : e_(e) {}
+
+  ACT_Evt *e_ = nullptr;
+};
+
+/**
+ * @brief Allocate an event of type T from its EventPool and construct it from args (aggregate initialization for
+ * aggregates). Asserts if the pool is empty or the memory class of sender is over quota.
+ *
+ * @param sender The Active object that will post the event
+ */
+template <typename T, typename... Args>
+EventPtr<T> make_event(Active const *sender, Args &&...args)
+{
+  return EventPtr<T>::adopt(ACT_Evt_new(EventInfo<T>::type, sender), std::forward<Args>(args)...);
+}
+
+/* Allocate an event of type T like make_event. Returns an empty handle instead of asserting */
+template <typename T, typename... Args>
+EventPtr<T> try_make_event(Active const *sender, Args &&...args)
+{
+  ACT_Evt *e = ACT_Evt_tryNew(EventInfo<T>::type, sender);
+  if (e == nullptr)
+  {
+    return EventPtr<T>();
+  }
+  return EventPtr<T>::adopt(e, std::forward<Args>(args)...);
+}
+
+/* @private - Dispatch table generation */
+namespace detail
+{
+
+template <typename E>
+struct IsSig : std::false_type
+{
+};
+
+template <uint16_t S>
+struct IsSig<Sig<S>> : std::true_type
+{
+};
+
+/* Table key of an event: the event type, or the signal for Sig */
+template <typename E>
+constexpr uint32_t key()
+{
+  if constexpr (IsSig<E>::value)
+  {
+    return 0x10000u | E::sig;
+  }
+  else
+  {
+    return EventInfo<E>::type;
+  }
+}
+
+template <typename... Events>
+constexpr bool unique()
+{
+  constexpr uint32_t keys[] = {key<Events>()..., 0xFFFFFFFFu};
+  for (size_t i = 0; i < sizeof...(Events); i++)
+  {
+    for (size_t j = i + 1; j < sizeof...(Events); j++)
+    {
+      if (keys[i] == keys[j])
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/* Size of the signal table: highest listed signal + 1 */
+template <typename... Events>
+constexpr size_t numSigs()
+{
+  size_t n = 0;
+  for (uint32_t k : {key<Events>()..., 0u})
+  {
+    if ((k & 0x10000u) != 0 && (k & 0xFFFFu) + 1 > n)
+    {
+      n = (k & 0xFFFFu) + 1;
+    }
+  }
+  return n;
+}
+
+} // namespace detail
+
+/**
+ * @brief Typed Active object. Derive as class Derived : public act::Actor<Derived, Events...>, where Events are the
+ * application events, ACT_Signal, ACT_Message and Sig<SIG> tags handled by Derived. The handlers must be accessible
+ * to Actor (public, or Actor a friend of Derived).
+ *
+ * Dispatching indexes a table of handlers by event type, and signals by a second table indexed by signal.
+ */
+template <typename Derived, typename... Events>
+class Actor
+{
+  static_assert(detail::unique<Events...>(), "Event or signal listed twice");
+
+public:
+  /**
+   * @brief Initialize the Active object with the generated dispatch function
+   *
+   * @param qd Pointer to queue related data needed by active object
+   * @param td Pointer to thread/task related data needed by active object
+   */
+  void init(ACT_QueueData const *qd, ACT_ThreadData const *td) { ACT_init(&super_, &Actor::dispatch, qd, td); }
+
+  /* Start the Active object thread */
+  void start() { ACT_start(&super_); }
+
+  /* The Active object, e.g. as receiver of posts or for the C API */
+  Active *active() { return &super_; }
+  Active const *active() const { return &super_; }
+
+  /* Dispatch function, set by init */
+  static void dispatch(Active *me, ACT_Evt const *const e)
+  {
+    static_assert(std::is_standard_layout_v<Actor>, "Active must be at offset 0 of Actor");
+    Derived &self = static_cast<Derived &>(*reinterpret_cast<Actor *>(me));
+
+    if constexpr (kNumSigs > 0)
+    {
+      if (e->type == ACT_SIGNAL)
+      {
+        uint16_t sig = reinterpret_cast<ACT_Signal const *>(e)->sig;
+        if (sig < kNumSigs && kTables.sigs[sig] != nullptr)
+        {
+          kTables.sigs[sig](self, e);
+          return;
+        }
+      }
+    }
+
+    Handler handler = kTables.types[e->type];
+    if (handler != nullptr)
+    {
+      handler(self, e);
+    }
+  }
+
+private:
+  using Handler = void (*)(Derived &, ACT_Evt const *);
+
+  static constexpr size_t kNumSigs = detail::numSigs<Events...>();
+
+  struct Tables
+  {
+    std::array<Handler, ACT_CFG_MAX_EVT_TYPES> types;
+    std::array<Handler, kNumSigs> sigs;
+  };
+
+  template <typename E>
+  static void handle(Derived &self, ACT_Evt const *e)
+  {
+    if constexpr (detail::IsSig<E>::value)
+    {
+      self.on(E{});
+    }
+    else
+    {
+      self.on(EventInfo<E>::get(e));
+    }
+  }
+
+  template <typename E>
+  static constexpr void add(Tables &t)
+  {
+    if constexpr (detail::IsSig<E>::value)
+    {
+      t.sigs[E::sig] = &handle<E>;
+    }
+    else
+    {
+      t.types[EventInfo<E>::type] = &handle<E>;
+    }
+  }
+
+  static constexpr Tables makeTables()
+  {
+    Tables t{};
+    (add<Events>(t), ...);
+    return t;
+  }
+
+  static const Tables kTables;
+
+  Active super_;
+};
+
+template <typename Derived, typename... Events>
+constexpr typename Actor<Derived, Events...>::Tables Actor<Derived, Events...>::kTables =
+    Actor<Derived, Events...>::makeTables();
+
+} // namespace act
+
+#endif /* ACTIVE_HPP */
@@ -6,6 +6,7 @@
 
 #include <active_config_loader.h>
 #include <active_port.h>
+#include <active_recorder.h>
 #include <active_types.h>
 
 /**
@@ -23,6 +24,10 @@ struct active_assertinfo
   char *test;    /* Test that failed assert */
   char *file;    /* Name of file */
   uint32_t line; /* Line of file */
+#if ACT_CFG_RECORDER == 1
+  ACT_Record const *records; /* Frozen flight recorder log of ACT_CFG_RECORDER_LEN records, stays valid */
+  uint32_t nextRecord;       /* Index of the oldest record, records with kind ACT_REC_NONE are unused */
+#endif
 };
 
 #if ACT_ASSERT_ENABLE == 1 && defined(ACT_ASSERT_LEVEL)
@@ -0,0 +1,115 @@
+#ifndef ACTIVE_BATCH_H
+#define ACTIVE_BATCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <active_config_loader.h>
+#include <active_types.h>
+
+#if ACT_CFG_BATCH == 1
+
+/**
+ * @brief Batch processing of messages (ACT_CFG_BATCH).
+ *
+ * An Active object can register a batch handler for a message header, e.g. for small sample messages.
+ * When a message with the header is taken from the queue, the following queued messages with the same header are
+ * taken as well, up to the capacity of the handler. Their payloads are copied into one contiguous array of values,
+ * their post time stamps into a parallel array, and the handler is called once with the arrays (struct of arrays).
+ * This lets the handler use vectorized kernels instead of processing one sample per dispatch.
+ *
+ * Gathering stops at the first queued event that is not part of the batch. That event is processed next, before any
+ * other queued event, so the order of events is kept. Messages after the first of a batch are not traced and can
+ * not be deferred. Message payloads are copied, so the messages are freed when the batch is gathered.
+ */
+
+/**
+ * @brief Batch of message values passed to a batch handler. Valid during the call only
+ */
+typedef struct active_batchSpan
+{
+  size_t len;                 // Number of messages in the batch
+  void const *values;         // len payload values of the messages, contiguous and aligned to ACT_CFG_BATCH_ALIGN
+  uint32_t const *timestamps; // len post time stamps (ACT_CYCLES_GET), NULL without ACT_CFG_EVT_TIMESTAMP
+} ACT_BatchSpan;
+
+/**
+ * @brief Batch handler function, called from the Active object's thread instead of its dispatch function
+ *
+ * @param me Active object
+ * @param header Message header of the batch
+ * @param span Values of the messages, oldest first
+ */
+typedef void (*ACT_BatchFn)(Active *me, uint16_t header, ACT_BatchSpan const *span);
+
+/**
+ * @brief Batch handler of a message header. Declare with ACT_BATCH_DEFINE. Do not access members directly.
+ */
+typedef struct active_batchHandler
+{
+  uint16_t header;      // Header of batched messages
+  ACT_BatchFn fn;       // Handler function
+  void *values;         // Value buffer of capacity values
+  uint16_t valueSize;   // Payload length of batched messages
+  uint32_t *timestamps; // Time stamp buffer of capacity time stamps, NULL without ACT_CFG_EVT_TIMESTAMP
+  uint16_t capacity;    // Max number of messages in a batch
+} ACT_BatchHandler;
+
+/**
+ * @internal - Batch handlers of an Active object. Only accessed from the Active object's own thread
+ */
+typedef struct active_batches
+{
+  ACT_BatchHandler *handlers[ACT_CFG_BATCH_MAX]; // Registered batch handlers
+  uint8_t numHandlers;                           // Number of registered batch handlers
+  ACT_Evt *held;                                 // Event taken from the queue while gathering, processed next
+#if ACT_CFG_EVT_TIMESTAMP == 1
+  uint32_t heldPostedAt;                         // Post time stamp of the held event
+#endif
+} ACT_Batches;
+
+/* @internal - Time stamp buffer of a batch handler, only allocated with ACT_CFG_EVT_TIMESTAMP */
+#if ACT_CFG_EVT_TIMESTAMP == 1
+#define ACT_BATCH_TIMESTAMPS(capacity) ((uint32_t[capacity]){0})
+#else
+#define ACT_BATCH_TIMESTAMPS(capacity) NULL
+#endif
+
+/**
+ * @brief Declare *and* initialize a batch handler with buffers for maxMsgs messages.
+ * Expands to a single declaration of the handler, with the buffers as compound literals, so a storage class given in front
+ * of the macro applies to the handler. Define batch handlers at file scope only (optionally static), as the buffers do not
+ * compile or dangle at block scope.
+ *
+ * @param batchSym Name of the batch handler
+ * @param msgHeader Header of batched messages
+ * @param batchFn Batch handler function
+ * @param valueType Type of the payload of batched messages. The payload length must be sizeof(valueType)
+ * @param maxMsgs Max number of messages in a batch
+ */
+#define ACT_BATCH_DEFINE(batchSym, msgHeader, batchFn, valueType, maxMsgs)                                              \
+  ACT_BatchHandler batchSym = {.header = (msgHeader),                                                                   \
+                               .fn = (batchFn),                                                                         \
+                               .values = (struct { _Alignas(ACT_CFG_BATCH_ALIGN) valueType items[maxMsgs]; }){0}.items, \
+                               .valueSize = sizeof(valueType),                                                          \
+                               .timestamps = ACT_BATCH_TIMESTAMPS(maxMsgs),                                             \
+                               .capacity = (maxMsgs)}
+
+/**
+ * @brief Register a batch handler. Call after ACT_init, before messages with its header are posted.
+ *
+ * @param me Active object. Max ACT_CFG_BATCH_MAX batch handlers per Active object
+ * @param handler Batch handler declared with ACT_BATCH_DEFINE, one header per Active object
+ */
+void ACT_setBatch(Active *const me, ACT_BatchHandler *handler);
+
+/* @private - Gather and handle a batch if the event is a message with a batch handler. Used by ACT_threadProcess */
+bool ACT_Batch_process(Active *const me, ACT_Evt *const e);
+
+/* @private - Take the event held back while gathering a batch, NULL if none. Used by ACT_threadFn */
+ACT_Evt *ACT_Batch_next(Active *const me);
+
+#endif /* ACT_CFG_BATCH == 1 */
+
+#endif /* ACTIVE_BATCH_H */
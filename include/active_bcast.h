@@ -0,0 +1,104 @@
+#ifndef ACTIVE_BCAST_H
+#define ACTIVE_BCAST_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <active_types.h>
+#include <active_msg.h>
+
+/**
+ * @brief Broadcast channel. One producer writes elements into a shared ring buffer, and every subscribing
+ * Active object reads all elements in place using its own read cursor.
+ *
+ * Elements are not queued or reference counted per subscriber. A subscriber is woken by a static signal
+ * only when it has read all published elements, so a burst of elements costs one queue entry per subscriber.
+ * The producer can not overwrite elements that the slowest subscriber has not read (backpressure).
+ *
+ * Do not access members directly.
+ */
+typedef struct active_bcast ACT_Bcast;
+typedef struct active_bcastSub ACT_BcastSub;
+
+struct active_bcastSub
+{
+  ACT_Bcast *bcast;       // Channel subscribed to
+  Active const *receiver; // Subscribing Active object
+  atomic_uint cursor;     // Sequence number of next element to read
+  atomic_bool notified;   // Wake signal is posted and subscriber has not caught up yet
+  ACT_Signal wakeSig;     // Posted to subscriber when new elements are published
+};
+
+struct active_bcast
+{
+  char *buf;                   // Ring buffer of numSlots elements
+  size_t elemSize;             // Size of each element
+  uint32_t numSlots;           // Number of elements in ring. Power of 2
+  atomic_uint seq;             // Sequence number of next element to publish
+  uint32_t gate;               // Cached sequence number of slowest subscriber. Only accessed by producer
+  ACT_BcastSub *subs;          // Subscriber array
+  size_t maxSubs;              // Size of subscriber array
+  size_t numSubs;              // Number of subscribers
+  Active const *producer;      // Sender of wake signals
+  uint32_t overruns;           // Number of times ACT_Bcast_claim failed due to a slow subscriber
+};
+
+/* Declare a ring buffer for a broadcast channel with numSlots elements of type. numSlots must be a power of 2 */
+#define ACT_BCAST_BUF(bufSym, type, numSlots) _Alignas(type) char bufSym[sizeof(type) * (numSlots)]
+
+/**
+ * @brief Initialize a broadcast channel
+ *
+ * @param b Channel to initialize
+ * @param producer Active object producing elements. Used as sender of wake signals.
+ * @param buf Ring buffer declared by ACT_BCAST_BUF
+ * @param elemSize Size of each element
+ * @param numSlots Number of elements in ring buffer. Must be a power of 2.
+ * @param subs Array to hold subscribers
+ * @param maxSubs Number of entries in subscriber array
+ */
+void ACT_Bcast_init(ACT_Bcast *b, Active const *producer, void *buf, size_t elemSize, uint32_t numSlots, ACT_BcastSub *subs, size_t maxSubs);
+
+/**
+ * @brief Subscribe an Active object to a broadcast channel. The subscriber will read elements published after subscribing.
+ * Must be called before the producer starts publishing.
+ *
+ * @param b Channel to subscribe to
+ * @param receiver Subscribing Active object
+ * @param wakeSig Signal posted to the subscriber when elements are available. Must be >= ACT_USER_SIG
+ * @return ACT_BcastSub* Subscription used to read elements
+ */
+ACT_BcastSub *ACT_Bcast_subscribe(ACT_Bcast *b, Active const *receiver, uint16_t wakeSig);
+
+/**
+ * @brief Claim the next element of the ring buffer for writing. Must only be called by the producer.
+ *
+ * @return void* Element to write, or NULL if the slowest subscriber has not read the element yet
+ */
+void *ACT_Bcast_claim(ACT_Bcast *b);
+
+/**
+ * @brief Publish the element returned by the last ACT_Bcast_claim and wake idle subscribers.
+ * Must only be called by the producer.
+ */
+void ACT_Bcast_publish(ACT_Bcast *b);
+
+/**
+ * @brief Get the next unread element for a subscriber. The element is valid until ACT_Bcast_release is called.
+ * Call repeatedly when receiving the wake signal until it returns NULL, to be woken again on new elements.
+ *
+ * @param sub Subscription
+ * @return const void* Next element, or NULL if all published elements are read
+ */
+const void *ACT_Bcast_read(ACT_BcastSub *sub);
+
+/**
+ * @brief Release the element returned by ACT_Bcast_read, letting the producer reuse it.
+ *
+ * @param sub Subscription
+ */
+void ACT_Bcast_release(ACT_BcastSub *sub);
+
+#endif /* ACTIVE_BCAST_H */
@@ -0,0 +1,75 @@
+#ifndef ACTIVE_BOOST_H
+#define ACTIVE_BOOST_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <active_config_loader.h>
+#include <active_msg.h>
+#include <active_types.h>
+
+#if ACT_CFG_BOOST == 1
+
+/**
+ * @brief Priority boost of Active objects with a filling queue (ACT_CFG_BOOST).
+ *
+ * The thread priority of an Active object is raised when its queue reaches a high watermark, checked when events are
+ * posted to it, or when an event it takes from the queue waited longer than a max age. The priority is restored when
+ * the queue drains to a low watermark. Boosting on age requires ACT_CFG_EVT_TIMESTAMP. This lets a consumer catch up with a busy higher priority producer before its
+ * queue overflows.
+ *
+ * Crossing the watermarks posts a static signal from the boosted Active object to an observer, e.g. for logging or
+ * load shedding. The POSIX port does not use thread priorities, so only the watermark signals are posted there.
+ */
+
+/**
+ * @brief Boost policy of an Active object. Can be shared by Active objects and must stay valid while in use.
+ */
+typedef struct active_boostPolicy
+{
+  uint16_t highDepth;     // Boost when the queue holds at least highDepth events. 0 to only boost on age
+  uint16_t lowDepth;      // Restore priority when the queue holds at most lowDepth events
+  uint32_t maxAgeUs;      // Boost when an event taken from the queue waited longer. 0 to only boost on depth
+  int pri;                // Thread priority while boosted (see ACT_THREAD_PRI)
+  Active const *observer; // Receives the watermark signals. NULL to not post them
+  uint16_t highSig;       // Signal posted to the observer when boosted
+  uint16_t lowSig;        // Signal posted to the observer when the priority is restored
+} ACT_BoostPolicy;
+
+/**
+ * @internal - Boost state of an Active object
+ */
+typedef struct active_boost
+{
+  ACT_BoostPolicy const *policy; // NULL if not boosted on load
+  int basePri;                   // Priority given at ACT_init
+  atomic_bool boosted;           // Running at the boosted priority. Changed first, the priority is set to match it
+  atomic_uint numBoosts;         // Number of times boosted
+  ACT_Signal highEvt;            // Watermark signals, sent by the Active object
+  ACT_Signal lowEvt;
+} ACT_Boost;
+
+/**
+ * @brief Set the boost policy of an Active object. Call after ACT_init, before events are posted to it.
+ *
+ * @param me Active object
+ * @param policy Boost policy, NULL to never boost
+ */
+void ACT_setBoost(Active *const me, ACT_BoostPolicy const *policy);
+
+/* Check if an Active object runs at its boosted priority */
+bool ACT_isBoosted(Active const *const me);
+
+/* Get the number of times an Active object was boosted */
+uint32_t ACT_getBoosts(Active const *const me);
+
+/* @private - Boost the receiver if its queue reached the high watermark. Used by ACT_postEvt */
+void ACT_Boost_posted(Active *const receiver);
+
+/* @private - Boost on the age of the event taken or restore priority on the low watermark. Used by ACT_threadTake */
+void ACT_Boost_process(Active *const me);
+
+#endif /* ACT_CFG_BOOST == 1 */
+
+#endif /* ACTIVE_BOOST_H */
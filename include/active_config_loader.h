@@ -27,6 +27,230 @@
 #ifndef ACT_MEM_NUM_TIMEEVT
 #define ACT_MEM_NUM_TIMEEVT 3
 #endif
+
+/* Number of event types, including the built-in types below ACT_USER_EVT. Max 15 with ACT_CFG_EVT_HANDLES */
+#ifndef ACT_CFG_MAX_EVT_TYPES
+#define ACT_CFG_MAX_EVT_TYPES 8
+#endif
+
+/* Enable per class reservations and caps of event memory pools (ACT_mem_setQuota) */
+#ifndef ACT_CFG_MEM_QUOTA
+#define ACT_CFG_MEM_QUOTA 0
+#endif
+
+/* Number of memory classes Active objects can be assigned to with ACT_setMemClass (max 255) */
+#ifndef ACT_CFG_MEM_CLASSES
+#define ACT_CFG_MEM_CLASSES 4
+#endif
+
+/* Use Active's lock-free memory pool (ISR and multi-core safe) for event memory.
+Set to 0 to use the port's native memory pool */
+#ifndef ACT_CFG_MEMPOOL_LOCKFREE
+#define ACT_CFG_MEMPOOL_LOCKFREE 1
+#endif
+
+/* Active object mailbox implementations */
+/* Port's native message queue, with a statically sized buffer per Active object */
+#define ACT_MAILBOX_NATIVE 0
+/* Lock-free linked list with nodes from one shared node pool (ACT_MEM_NUM_QNODES) */
+#define ACT_MAILBOX_LINKED 1
+/* Earliest deadline first, with events past their deadline dropped when dequeued (ACT_Evt_setDeadline) */
+#define ACT_MAILBOX_EDF 2
+
+#ifndef ACT_CFG_MAILBOX
+#define ACT_CFG_MAILBOX ACT_MAILBOX_NATIVE
+#endif
+
+/* Number of queue nodes shared by all Active objects using linked mailboxes.
+Must hold the max number of events queued at any time in the system */
+#ifndef ACT_MEM_NUM_QNODES
+#define ACT_MEM_NUM_QNODES 16
+#endif
+
+/* Store 16 bit handles (pool id + block index) instead of pointers in Active object queues and
+event sender fields. Requires the lock-free memory pool. Set to 1 to enable */
+#ifndef ACT_CFG_EVT_HANDLES
+#define ACT_CFG_EVT_HANDLES 0
+#endif
+
+/* Max number of Active objects that can be referenced by handle */
+#ifndef ACT_CFG_MAX_ACTORS
+#define ACT_CFG_MAX_ACTORS 16
+#endif
+
+/* Max number of distinct static events queued at a time when using handles */
+#ifndef ACT_CFG_HANDLE_NUM_STATIC
+#define ACT_CFG_HANDLE_NUM_STATIC 16
+#endif
+
+#if ACT_CFG_EVT_HANDLES == 1 && ACT_CFG_MEMPOOL_LOCKFREE != 1
+#error "ACT_CFG_EVT_HANDLES requires ACT_CFG_MEMPOOL_LOCKFREE"
+#endif
+/* Record all posted events into a trace buffer for offline analysis and replay, and collect per Active object
+latency and queue depth statistics. See active_trace.h. Set to 1 to enable */
+#ifndef ACT_CFG_TRACE
+#define ACT_CFG_TRACE 0
+#endif
+
+/* Max number of message payload bytes recorded per event in a trace (max 255) */
+#ifndef ACT_CFG_TRACE_PAYLOAD_MAX
+#define ACT_CFG_TRACE_PAYLOAD_MAX 32
+#endif
+
+/* Always-on flight recorder of the last posts, dispatches, allocations and timer expiries, passed to the assert
+handler in Active_AssertInfo. See active_recorder.h. Set to 1 to enable */
+#ifndef ACT_CFG_RECORDER
+#define ACT_CFG_RECORDER 0
+#endif
+
+/* Number of flight recorder records (power of 2) */
+#ifndef ACT_CFG_RECORDER_LEN
+#define ACT_CFG_RECORDER_LEN 64
+#endif
+
+/* Time stamp queue entries with the cycle counter when posted, to measure queuing latency. Required by tracing */
+#ifndef ACT_CFG_EVT_TIMESTAMP
+#define ACT_CFG_EVT_TIMESTAMP ACT_CFG_TRACE
+#endif
+
+/* Request/reply with correlation IDs and time outs (ACT_request, ACT_reply, ACT_call), see active_rpc.h.
+Set to 1 to enable */
+#ifndef ACT_CFG_RPC
+#define ACT_CFG_RPC 0
+#endif
+
+/* Max number of requests waiting for a reply at any time in the system (max 32) */
+#ifndef ACT_CFG_RPC_MAX_PENDING
+#define ACT_CFG_RPC_MAX_PENDING 8
+#endif
+
+/* Let Active objects defer events and recall them later (ACT_defer, ACT_recall), see active_defer.h.
+Set to 1 to enable */
+#ifndef ACT_CFG_DEFER
+#define ACT_CFG_DEFER 0
+#endif
+
+/* Max number of deferred events per Active object (max 255) */
+#ifndef ACT_CFG_DEFER_MAX
+#define ACT_CFG_DEFER_MAX 4
+#endif
+
+/* Post from ISRs through pre-allocated per source event slots (ACT_postFromISR), see active_isr.h.
+Set to 1 to enable */
+#ifndef ACT_CFG_ISR_POST
+#define ACT_CFG_ISR_POST 0
+#endif
+
+/* Max number of interrupt sources posting to one Active object (max 32) */
+#ifndef ACT_CFG_ISR_MAX_SOURCES
+#define ACT_CFG_ISR_MAX_SOURCES 8
+#endif
+
+/* Let Active objects process queued messages of a header in batches (ACT_setBatch), see active_batch.h.
+Set to 1 to enable */
+#ifndef ACT_CFG_BATCH
+#define ACT_CFG_BATCH 0
+#endif
+
+/* Max number of batch handlers per Active object */
+#ifndef ACT_CFG_BATCH_MAX
+#define ACT_CFG_BATCH_MAX 2
+#endif
+
+/* Alignment in bytes of batch value buffers declared with ACT_BATCH_DEFINE, e.g. 16 for NEON/Helium, 32 for AVX2 */
+#ifndef ACT_CFG_BATCH_ALIGN
+#define ACT_CFG_BATCH_ALIGN 16
+#endif
+
+/* Raise the thread priority of Active objects with a filling queue (ACT_setBoost), see active_boost.h.
+Set to 1 to enable */
+#ifndef ACT_CFG_BOOST
+#define ACT_CFG_BOOST 0
+#endif
+
+/* Number of job priorities of offload pools (active_offload.h). 0 is the highest */
+#ifndef ACT_CFG_OFFLOAD_PRIOS
+#define ACT_CFG_OFFLOAD_PRIOS 4
+#endif
+
+/* Max number of workers of one offload pool */
+#ifndef ACT_CFG_OFFLOAD_MAX_WORKERS
+#define ACT_CFG_OFFLOAD_MAX_WORKERS 4
+#endif
+
+/* Max nesting levels of hierarchical state machine states (active_hsm.h), including top level states */
+#ifndef ACT_CFG_HSM_MAX_DEPTH
+#define ACT_CFG_HSM_MAX_DEPTH 4
+#endif
+
+#if ACT_CFG_TRACE == 1 && ACT_CFG_EVT_TIMESTAMP != 1
+#error "ACT_CFG_TRACE requires ACT_CFG_EVT_TIMESTAMP"
+#endif
+
+/* @internal - Active objects are registered in ACT_init to get a handle. Used by event handles and tracing */
+#if ACT_CFG_EVT_HANDLES == 1 || ACT_CFG_TRACE == 1
+#define ACT_ACTOR_REGISTRY 1
+#else
+#define ACT_ACTOR_REGISTRY 0
+#endif
+
+/* Run Active objects in a deterministic, single threaded simulation on a virtual clock instead of the
+platform port. Timers, ACT_SLEEPMS and ACT_TIMEMS_GET use virtual time. Set to 1 to enable */
+#ifndef ACT_CFG_PORT_SIM
+#define ACT_CFG_PORT_SIM 0
+#endif
+
+#if ACT_CFG_PORT_SIM == 1 && ACT_CFG_MEMPOOL_LOCKFREE != 1
+#error "ACT_CFG_PORT_SIM requires ACT_CFG_MEMPOOL_LOCKFREE"
+#endif
+
+/* Post events to Active objects in other processes through shared memory links, see active_shm.h.
+Linux host only (POSIX port). Set to 1 to enable */
+#ifndef ACT_CFG_SHM
+#define ACT_CFG_SHM 0
+#endif
+
+/* Size in bytes of each direction of a shared memory link. Power of two, same in both processes */
+#ifndef ACT_CFG_SHM_RING_SIZE
+#define ACT_CFG_SHM_RING_SIZE 65536
+#endif
+
+/* Max number of Active objects bound to, and proxies of remote Active objects on, one shared memory link */
+#ifndef ACT_CFG_SHM_MAX_PORTS
+#define ACT_CFG_SHM_MAX_PORTS 16
+#endif
+
+/* Max number of received events on one shared memory link that can wait to be processed */
+#ifndef ACT_CFG_SHM_INFLIGHT
+#define ACT_CFG_SHM_INFLIGHT 32
+#endif
+
+#if ACT_CFG_SHM == 1 && !defined(__linux__)
+#error "ACT_CFG_SHM requires a Linux host"
+#endif
+
+#if ACT_CFG_SHM == 1 && ACT_CFG_PORT_SIM == 1
+#error "ACT_CFG_SHM requires the POSIX port, received events are posted from a bridge thread"
+#endif
+
+/* Turn readiness of file descriptors into events with an epoll reactor thread, see active_reactor.h.
+Linux host only (POSIX port). Set to 1 to enable */
+#ifndef ACT_CFG_REACTOR
+#define ACT_CFG_REACTOR 0
+#endif
+
+/* Max number of readiness events taken by one epoll_wait call of the reactor thread */
+#ifndef ACT_CFG_REACTOR_BATCH
+#define ACT_CFG_REACTOR_BATCH 32
+#endif
+
+#if ACT_CFG_REACTOR == 1 && !defined(__linux__)
+#error "ACT_CFG_REACTOR requires a Linux host"
+#endif
+
+#if ACT_CFG_REACTOR == 1 && ACT_CFG_PORT_SIM == 1
+#error "ACT_CFG_REACTOR requires the POSIX port, events are posted from the reactor thread"
+#endif
 /*
 #ifndef ACT_MEM_NUM_OBJPOOLS
 #define ACT_MEM_NUM_OBJPOOLS 1
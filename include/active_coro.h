@@ -0,0 +1,149 @@
+#ifndef ACTIVE_CORO_H
+#define ACTIVE_CORO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <active_msg.h>
+#include <active_timer.h>
+#include <active_types.h>
+
+/**
+ * @brief Stackless coroutines awaiting events (protothreads).
+ *
+ * A coroutine body is written sequentially, e.g. send a request, await the acknowledge or a timeout, retry.
+ * At each ACT_AWAIT_EVT the body stores its resume point in the coroutine and returns to the dispatch function of its
+ * host Active object. When the host dispatches the awaited signal (or message header), or the timeout expires, the body
+ * is called again and continues after the await. No stack is kept between events, so many coroutines can share the
+ * thread of one host Active object, and an ACT_CoroActive runs a single coroutine under the normal ACT_threadFn.
+ *
+ * The resume point is a case label of a switch around the body. As with protothreads:
+ * - Local variables are not kept across awaits. Keep state in a struct embedding ACT_Coro as first member.
+ * - ACT_AWAIT_EVT can not be used inside a switch statement of the body, and only once per source line.
+ */
+
+/* Resume point of coroutines that are not running */
+#define ACT_CORO_DONE UINT16_MAX
+
+/* Coroutine */
+typedef struct active_coro ACT_Coro;
+
+/**
+ * @brief Coroutine body. Begins with ACT_CORO_BEGIN and ends with ACT_CORO_END.
+ *
+ * @param co The coroutine
+ * @param e Event passed to ACT_Coro_start at the beginning, the awaited event after an await, or NULL after a timeout
+ */
+typedef void (*ACT_CoroFn)(ACT_Coro *co, ACT_Evt const *const e);
+
+/**
+ * @brief Coroutine. Do not access members directly.
+ */
+struct active_coro
+{
+  ACT_CoroFn fn;       // Body
+  Active *host;        // Active object dispatching events to the coroutine
+  uint16_t _line;      // Resume point, ACT_CORO_DONE when not running
+  uint16_t _sig;       // Awaited signal or message header
+  bool _timing;        // Timeout of the current await is running
+  uint8_t _stale;      // Timeouts expired after the awaited event was dispatched, dropped when dispatched
+  ACT_Signal _expired; // Posted to host when the timeout expires
+  ACT_TimEvt _timeout; // Timeout of the current await
+};
+
+/**
+ * @brief Coroutine Active object, running one coroutine on its own thread. Embed as first member of application
+ * Active objects.
+ */
+typedef struct active_coroActive
+{
+  Active super; // Upcast with ACT_UPCAST
+  ACT_Coro coro;
+} ACT_CoroActive;
+
+/**
+ * @brief Begin a coroutine body. Resumes the body after the last await.
+ */
+#define ACT_CORO_BEGIN(co)       \
+  ACT_Coro *const _actCo = (co); \
+  switch (_actCo->_line)         \
+  {                              \
+  case 0:
+
+/**
+ * @brief Return to the host until it dispatches an event with the signal (or message header), or until the timeout
+ * expires. The event parameter of the body is the awaited event after the await, or NULL on timeout.
+ * Other events dispatched to the coroutine meanwhile are not consumed by it (ACT_Coro_dispatch returns false).
+ *
+ * @param sig Awaited signal or message header
+ * @param timeoutMs Timeout, 0 to wait without timeout
+ */
+#define ACT_AWAIT_EVT(sig, timeoutMs)                     \
+  do                                                      \
+  {                                                       \
+    ACT_Coro_await(_actCo, (sig), (timeoutMs), __LINE__); \
+    return;                                               \
+  case __LINE__:;                                         \
+  } while (0)
+
+/**
+ * @brief End a coroutine body. The coroutine is done and can be started again.
+ */
+#define ACT_CORO_END() \
+  }                    \
+  _actCo->_line = ACT_CORO_DONE
+
+/**
+ * @brief Initialize a coroutine. The coroutine is not running until started.
+ *
+ * @param co Coroutine to initialize
+ * @param host Active object dispatching events to the coroutine with ACT_Coro_dispatch. Timeouts are posted to it.
+ * @param fn Coroutine body
+ */
+void ACT_Coro_init(ACT_Coro *co, Active *host, ACT_CoroFn fn);
+
+/**
+ * @brief Start a coroutine that is not running. Runs the body until its first await or its end.
+ * Call from the host thread, e.g. when the host dispatches the request opening a session.
+ *
+ * @param co Coroutine
+ * @param e Event passed to the body, can be NULL
+ */
+void ACT_Coro_start(ACT_Coro *co, ACT_Evt const *const e);
+
+/**
+ * @brief Resume a coroutine awaiting the event, or one of its expired timeouts. Call from the dispatch function of
+ * the host. Hosts of several coroutines route the event to the coroutine of its session, or offer it to each
+ * coroutine until one consumes it.
+ *
+ * @param co Coroutine
+ * @param e Event dispatched by the host
+ * @return true if the event was consumed by the coroutine
+ */
+bool ACT_Coro_dispatch(ACT_Coro *co, ACT_Evt const *const e);
+
+/* Stop a running coroutine and its timeout. The body is not called again until the coroutine is started again */
+void ACT_Coro_stop(ACT_Coro *co);
+
+/* Check if a coroutine is running, i.e. started and not at its end */
+bool ACT_Coro_isRunning(ACT_Coro const *co);
+
+/**
+ * @brief Initialize a coroutine Active object with ACT_CoroActive_dispatch as dispatch function.
+ * The coroutine is started when ACT_START_SIG is dispatched.
+ *
+ * @param me Coroutine Active object to initialize
+ * @param fn Coroutine body
+ * @param qd Pointer to queue related data needed by active object
+ * @param td Pointer to thread/task related data needed by active object
+ */
+void ACT_CoroActive_init(ACT_CoroActive *me, ACT_CoroFn fn, ACT_QueueData const *qd, ACT_ThreadData const *td);
+
+/* Dispatch function of coroutine Active objects. Set by ACT_CoroActive_init */
+void ACT_CoroActive_dispatch(Active *me, ACT_Evt const *const e);
+
+/* @private - Store the resume point and awaited signal, and start the timeout. Used by ACT_AWAIT_EVT */
+void ACT_Coro_await(ACT_Coro *co, uint16_t sig, size_t timeoutMs, int line);
+
+#endif /* ACTIVE_CORO_H */
@@ -0,0 +1,73 @@
+#ifndef ACTIVE_DEFER_H
+#define ACTIVE_DEFER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <active_config_loader.h>
+#include <active_types.h>
+
+#if ACT_CFG_DEFER == 1
+
+/**
+ * @brief Deferred events of Active objects (ACT_CFG_DEFER).
+ *
+ * An Active object can postpone the event it is processing with ACT_defer, e.g. a request arriving while busy.
+ * The event is kept in a bounded buffer in the Active object together with the reference taken when it was posted,
+ * so it is neither freed nor copied. ACT_recall puts the oldest deferred event in front of the queue: recalled events
+ * are processed, in the order they were deferred, before any event waiting in the queue.
+ * Deferring and recalling do not touch the queue, the memory pools or reference counts.
+ */
+
+/* Status codes of deferring */
+#define ACT_DEFER_OK 0
+#define ACT_DEFER_ERR_FULL -1 // ACT_CFG_DEFER_MAX events are deferred. The event is processed as not deferred
+
+/**
+ * @internal - Deferred events of an Active object. Only accessed from the Active object's own thread
+ */
+typedef struct active_deferQueue
+{
+  ACT_Evt const *evts[ACT_CFG_DEFER_MAX]; // Deferred events, oldest at head
+  uint8_t head;                           // Oldest deferred event
+  uint8_t used;                           // Number of deferred events, including recalled ones
+  uint8_t recalled;                       // Number of oldest deferred events to process before the queue
+  bool kept;                              // Event being processed was deferred, keep its reference
+  ACT_Evt const *current;                 // Event being processed
+} ACT_DeferQueue;
+
+/**
+ * @brief Defer the event being processed. Call from the dispatch function of the Active object with the event
+ * it was called with. Replies and time outs of requests (ACT_request) can not be deferred.
+ *
+ * @param me Active object processing the event
+ * @param e Event being processed
+ * @return int ACT_DEFER_OK or ACT_DEFER_ERR_FULL
+ */
+int ACT_defer(Active *const me, ACT_Evt const *const e);
+
+/**
+ * @brief Recall the oldest deferred event. It is processed after the current event, before events in the queue.
+ * Call from the dispatch function of the Active object.
+ *
+ * @param me Active object
+ * @return true if an event was recalled, false if no events are deferred
+ */
+bool ACT_recall(Active *const me);
+
+/* Get the number of deferred events not yet recalled */
+size_t ACT_getDeferred(Active const *const me);
+
+/* @private - Take the next recalled event to process, NULL if none. Used by ACT_threadFn and ports */
+ACT_Evt *ACT_Defer_next(Active *const me);
+
+/* @private - Start processing an event. Used by ACT_threadProcess */
+void ACT_Defer_begin(Active *const me, ACT_Evt const *const e);
+
+/* @private - End processing an event. True if it was deferred and its reference must be kept */
+bool ACT_Defer_end(Active *const me);
+
+#endif /* ACT_CFG_DEFER == 1 */
+
+#endif /* ACTIVE_DEFER_H */
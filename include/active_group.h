@@ -0,0 +1,81 @@
+#ifndef ACTIVE_GROUP_H
+#define ACTIVE_GROUP_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <active_types.h>
+
+#define ACT_GROUP_ERR_FULL (-1) // Queue of the selected member is full, the event is not posted
+
+/**
+ * @brief Group statistics. Read with ACT_Group_getStats
+ */
+typedef struct active_groupStats
+{
+  uint32_t posted;   // Number of events posted to group
+  uint32_t failed;   // Number of events rejected as the member queue was full, or not put on it
+  uint32_t maxDepth; // Max queue depth of the selected member when posting
+} ACT_GroupStats;
+
+/**
+ * @brief A group of identical worker Active objects sharing one dispatch function.
+ * Events posted to the group are given to one member. Do not access members directly.
+ */
+typedef struct active_group
+{
+  Active *const *members;  // Member Active objects
+  size_t numMembers;       // Number of members
+  ACT_QueueData const *qd; // Member queue data, for the queue capacity
+  atomic_uint next;        // Member to start least loaded search from, to spread events on ties
+  atomic_uint posted;
+  atomic_uint failed;
+  atomic_uint maxDepth;
+} ACT_Group;
+
+/**
+ * @brief Initialize a group and all its member Active objects with the same dispatch function
+ *
+ * @param g Group to initialize
+ * @param members Array of numMembers member Active objects (can be application Active objects upcast by ACT_UPCAST)
+ * @param numMembers Number of members
+ * @param dispatch Dispatch function shared by all members
+ * @param qd Array of numMembers queue data, one per member. Kept by the group, so it must not be on the stack
+ * @param td Array of numMembers thread data, one per member
+ */
+void ACT_Group_init(ACT_Group *g, Active *const *members, size_t numMembers, ACT_DispatchFn dispatch,
+                    ACT_QueueData const *qd, ACT_ThreadData const *td);
+
+/* Start all members of a group */
+void ACT_Group_start(ACT_Group *g);
+
+/**
+ * @brief Post an event to the member of the group with fewest queued events. If its queue is full, the event is
+ * counted as failed and not posted (a dynamic event not referenced elsewhere is freed).
+ *
+ * @param g Group to post to
+ * @param e Event to post
+ * @return int ACT_GROUP_ERR_FULL, else port specific status code, see ACT_postEvt
+ */
+int ACT_postGroup(ACT_Group *g, ACT_Evt const *const e);
+
+/**
+ * @brief Post an event to the group member selected by a key. Events with the same key are
+ * processed by the same member in posting order (e.g. per flow or per session ordering). If its queue is full, the
+ * event is counted as failed and not posted (a dynamic event not referenced elsewhere is freed).
+ *
+ * @param g Group to post to
+ * @param e Event to post
+ * @param key Application defined key
+ * @return int ACT_GROUP_ERR_FULL, else port specific status code, see ACT_postEvt
+ */
+int ACT_postGroupKey(ACT_Group *g, ACT_Evt const *const e, uint32_t key);
+
+/* Get a copy of the group statistics */
+ACT_GroupStats ACT_Group_getStats(ACT_Group *g);
+
+/* Get total number of events queued for all members of a group */
+size_t ACT_Group_getQueueUsed(ACT_Group *g);
+
+#endif /* ACTIVE_GROUP_H */
@@ -0,0 +1,112 @@
+#ifndef ACTIVE_HSM_H
+#define ACTIVE_HSM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <active_config_loader.h>
+#include <active_types.h>
+
+/**
+ * @brief Table driven hierarchical state machines (optional).
+ *
+ * Each state has a constant handler table indexed by signal (or message header). An event is looked up in the table of
+ * the current state, and passed on to the parent state if the entry is NULL or the handler returns ACT_HSM_UNHANDLED.
+ * Lookup is one array access per nesting level, independent of the number of handled signals.
+ *
+ * ACT_Hsm_init precomputes the path from the top level state for every state, and the leaf state reached by following
+ * initial substates. Transitions are then resolved by indexing those paths: states are exited from the current leaf up
+ * to the least common ancestor of source and target, and entered down to the leaf of the target.
+ * Transitions to the handling state itself or its superstates exit and re-enter the target.
+ *
+ * ACT_Hsm_dispatch is the ACT_DispatchFn of the state machine. ACT_START_SIG enters the initial state.
+ */
+
+/* State of a hierarchical state machine */
+typedef struct active_hsmState ACT_HsmState;
+
+/**
+ * @brief State event handler. Returns the target state of a transition, ACT_HSM_HANDLED, or ACT_HSM_UNHANDLED
+ * to let the parent state handle the event (e.g. when a guard is false)
+ */
+typedef ACT_HsmState *(*ACT_HsmHandler)(Active *me, ACT_Evt const *const e);
+
+/* State entry or exit action */
+typedef void (*ACT_HsmAction)(Active *me);
+
+/* @private - Marks events not handled by a state */
+extern ACT_HsmState ACT_Hsm_unhandled;
+
+/* Handler results other than a transition */
+#define ACT_HSM_HANDLED ((ACT_HsmState *)NULL)
+#define ACT_HSM_UNHANDLED (&ACT_Hsm_unhandled)
+
+/**
+ * @brief State definition. Handlers, actions and hierarchy are set by the application (see ACT_HSM_STATE_DEFINE),
+ * the remaining members by ACT_Hsm_init. States are shared by all state machines of the same kind.
+ */
+struct active_hsmState
+{
+  ACT_HsmState *parent;                       // Superstate, NULL for top level states
+  ACT_HsmState *initial;                      // Substate entered after this state, NULL for leaf states
+  ACT_HsmHandler const *handlers;             // Handlers indexed by signal or message header. NULL entries go to parent
+  uint16_t numHandlers;                       // Length of handler table. Higher signals go to parent
+  ACT_HsmAction entry;                        // Entry action, can be NULL
+  ACT_HsmAction exit;                         // Exit action, can be NULL
+  uint8_t _depth;                             // Number of superstates
+  ACT_HsmState *_leaf;                        // Leaf state entered on transitions to this state
+  ACT_HsmState *_path[ACT_CFG_HSM_MAX_DEPTH]; // Top level state down to this state
+};
+
+/**
+ * @brief Define a state with a handler table of static storage, e.g.
+ * static ACT_HsmHandler const idleHandlers[] = {[START_BTN_SIG] = Idle_start};
+ * ACT_HSM_STATE_DEFINE(idle, &top, NULL, idleHandlers, Idle_entry, NULL);
+ * States referred to before their definition are declared with "static ACT_HsmState name;"
+ */
+#define ACT_HSM_STATE_DEFINE(symbol, parentState, initialState, handlerTable, entryFn, exitFn) \
+  ACT_HsmState symbol = {.parent = (parentState),                                              \
+                         .initial = (initialState),                                            \
+                         .handlers = (handlerTable),                                           \
+                         .numHandlers = sizeof(handlerTable) / sizeof((handlerTable)[0]),      \
+                         .entry = (entryFn),                                                   \
+                         .exit = (exitFn)}
+
+/**
+ * @brief Hierarchical state machine Active object. Embed as first member of application Active objects.
+ */
+typedef struct active_hsm
+{
+  Active super;          // Upcast with ACT_UPCAST
+  ACT_HsmState *state;   // Current leaf state, NULL before start
+  ACT_HsmState *initial; // State entered on ACT_START_SIG
+} ACT_Hsm;
+
+/**
+ * @brief Initialize a state machine Active object with ACT_Hsm_dispatch as dispatch function, and precompute the
+ * paths of its states. Initialize all state machines sharing states before starting any of them.
+ *
+ * @param me State machine to initialize
+ * @param states Array of all states of the state machine, in any order
+ * @param numStates Number of states
+ * @param initial State entered on ACT_START_SIG
+ * @param qd Pointer to queue related data needed by active object
+ * @param td Pointer to thread/task related data needed by active object
+ */
+void ACT_Hsm_init(ACT_Hsm *me, ACT_HsmState *const *states, size_t numStates, ACT_HsmState *initial,
+                  ACT_QueueData const *qd, ACT_ThreadData const *td);
+
+/* Dispatch function of state machine Active objects. Set by ACT_Hsm_init */
+void ACT_Hsm_dispatch(Active *me, ACT_Evt const *const e);
+
+/**
+ * @brief Check if a state machine is in a state or one of its substates
+ *
+ * @param me State machine
+ * @param state State to check
+ * @return true if state is the current leaf state or one of its superstates
+ */
+bool ACT_Hsm_isIn(ACT_Hsm const *me, ACT_HsmState const *state);
+
+#endif /* ACTIVE_HSM_H */
@@ -0,0 +1,84 @@
+#ifndef ACTIVE_ISR_H
+#define ACTIVE_ISR_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <active_config_loader.h>
+#include <active_types.h>
+
+#if ACT_CFG_ISR_POST == 1
+
+/**
+ * @brief Posting from interrupt service routines through pre-allocated event slots (ACT_CFG_ISR_POST).
+ *
+ * Each interrupt source owns a static event (its slot) and a pending bit in the receiving Active object.
+ * ACT_postFromISR only sets the pending bit. The receiving queue gets a doorbell entry only when no other source of the
+ * receiver is pending, so a burst of interrupts costs one queue put. The receiver's thread then dispatches the event
+ * of every pending source and clears its bit, which frees the slot for the next interrupt.
+ *
+ * No event is allocated and no reference counted in the ISR. If the previous event of a source was not processed yet,
+ * the post is dropped and counted as overflow, so the ISR never waits or asserts on a busy slot.
+ * The receiver queue must have room for one doorbell entry in addition to its other events.
+ */
+
+/* Status codes of posting from ISRs */
+#define ACT_ISR_OK 0
+#define ACT_ISR_ERR_OVERFLOW -1 // Previous event of the source not processed yet, post dropped
+
+/**
+ * @brief Interrupt source posting to one Active object. Do not access members directly.
+ */
+typedef struct active_isrSource
+{
+  Active *receiver;     // Receiving Active object
+  ACT_Evt const *e;     // Static event of the source, dispatched to receiver
+  unsigned int bit;     // Pending bit of the source in receiver
+  atomic_uint overflow; // Number of posts dropped as the slot was busy
+} ACT_IsrSource;
+
+/**
+ * @internal - Interrupt sources of an Active object
+ */
+typedef struct active_isrSources
+{
+  atomic_uint pending;                             // Bit per source with an event to process
+  ACT_IsrSource *sources[ACT_CFG_ISR_MAX_SOURCES]; // Sources by pending bit
+  uint8_t numSources;                              // Number of sources
+} ACT_IsrSources;
+
+/**
+ * @brief Initialize an interrupt source. Call from a thread, before the interrupt is enabled.
+ *
+ * @param src Interrupt source to initialize
+ * @param receiver Initialized Active object to post to. Max ACT_CFG_ISR_MAX_SOURCES sources per Active object
+ * @param e Static event dispatched to the receiver for each post. A message payload can be written by the ISR when
+ * ACT_IsrSource_isFree returns true
+ */
+void ACT_IsrSource_init(ACT_IsrSource *src, Active *receiver, ACT_Evt const *e);
+
+/**
+ * @brief Post the event of an interrupt source. Can be called from ISRs, one ISR per source.
+ * The event is dispatched by the receiver, but not seen by tracing and can not be deferred.
+ *
+ * @param src Interrupt source
+ * @return int ACT_ISR_OK, or ACT_ISR_ERR_OVERFLOW if the previous event of the source was not processed yet
+ */
+int ACT_postFromISR(ACT_IsrSource *src);
+
+/* Check if the event of an interrupt source was processed, so its payload can be written */
+bool ACT_IsrSource_isFree(ACT_IsrSource const *src);
+
+/* Get the number of posts of an interrupt source dropped as overflow */
+uint32_t ACT_IsrSource_getOverflow(ACT_IsrSource const *src);
+
+/* @private - Queued to wake Active objects with pending interrupt sources. Never dispatched */
+extern ACT_Signal ACT_Isr_doorbell;
+
+/* @private - Dispatch the events of all pending interrupt sources. Used by ACT_threadProcess */
+void ACT_Isr_process(Active *const me);
+
+#endif /* ACT_CFG_ISR_POST == 1 */
+
+#endif /* ACTIVE_ISR_H */
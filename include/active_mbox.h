@@ -0,0 +1,227 @@
+#ifndef ACTIVE_MBOX_H
+#define ACTIVE_MBOX_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <active_config_loader.h>
+#include <active_port.h>
+#include <active_types.h>
+
+#if ACT_CFG_MAILBOX == ACT_MAILBOX_LINKED
+
+/**
+ * @brief Linked mailbox used as Active object queue. Do not access members directly.
+ *
+ * Queued events are held in nodes allocated from one node pool shared by all Active objects,
+ * so queue memory scales with the number of events in flight rather than the sum of all queue sizes.
+ *
+ * Posting pushes a node on a lock-free LIFO stack (single compare-and-swap, ISR safe).
+ * The receiving Active object takes the whole stack at once and reverses it into FIFO order.
+ */
+typedef struct active_mboxNode ACT_MboxNode;
+
+struct active_mboxNode
+{
+  ACT_MboxNode *next;
+  ACT_QEntry entry;
+};
+
+typedef struct active_mbox ACT_Mbox;
+
+struct active_mbox
+{
+  _Atomic(ACT_MboxNode *) inbox; // Nodes posted since last get, newest first
+  ACT_MboxNode *head;            // Nodes taken from inbox, oldest first. Only accessed by receiver
+  atomic_uint used;              // Number of queued events
+  size_t cap;                    // Max number of queued events for this mailbox. 0 -> limited by node pool only
+  ACT_SEM(sem);                  // Number of queued events ready to be taken by receiver
+};
+
+/* Returned by ACT_Mbox_put when mailbox cap is reached */
+#define ACT_MBOX_ERR_FULL (-1)
+/* Returned by ACT_Mbox_put when shared node pool is empty */
+#define ACT_MBOX_ERR_NOMEM (-2)
+
+/**
+ * @brief Initialize a linked mailbox
+ *
+ * @param mb Mailbox to initialize
+ * @param cap Max number of queued events for this mailbox. 0 for no per mailbox limit.
+ */
+void ACT_Mbox_init(ACT_Mbox *mb, size_t cap);
+
+/**
+ * @brief Put an entry on a linked mailbox. Does not block. Can be called from ISRs.
+ *
+ * @return 0 on success, ACT_MBOX_ERR_FULL or ACT_MBOX_ERR_NOMEM on failure
+ */
+int ACT_Mbox_put(ACT_Mbox *mb, ACT_QEntry const *entry);
+
+/**
+ * @brief Get the oldest entry from a linked mailbox. Blocks until an entry is available.
+ * Must only be called by the single receiver of the mailbox.
+ *
+ * @return 0 on success
+ */
+int ACT_Mbox_get(ACT_Mbox *mb, ACT_QEntry *entry);
+
+/* Get number of queued entries in a linked mailbox */
+size_t ACT_Mbox_getUsed(ACT_Mbox *mb);
+
+/* @internal - Get number of nodes currently used from the shared node pool */
+uint32_t ACT_mem_QNode_getUsed();
+
+/**
+ * @brief Active object queue port using linked mailboxes. Replaces the port's native queue.
+ *
+ */
+
+/* Declare a mailbox with name qSym */
+#define ACT_Q(qSym) ACT_Mbox qSym
+
+/* @internal - Declare a pointer to a mailbox */
+#define ACT_QPTR(qPtrSym) ACT_Mbox *qPtrSym
+
+/* Linked mailboxes need no per queue buffer. Declares an empty buffer (GCC extension) so
+applications can switch mailbox implementation without changes. maxMsg is given as cap in ACT_QueueData */
+#define ACT_QBUF(bufSym, maxMsg) char bufSym[0]
+
+/* @internal - Get an entry from the mailbox. Blocks forever until an entry is put on the mailbox */
+#define ACT_Q_GET(qPtrSym, entryPtr) ACT_Mbox_get(qPtrSym, entryPtr)
+#define ACT_Q_GET_SUCCESS_STATUS 0
+
+/* @internal - Put an entry on the mailbox. Does not block */
+#define ACT_Q_PUT(qPtrSym, entryPtr) ACT_Mbox_put(qPtrSym, entryPtr)
+#define ACT_Q_PUT_SUCCESS_STATUS 0
+
+/* @internal - Get number of entries in mailbox */
+#define ACT_Q_USED_GET(qPtrSym) ACT_Mbox_getUsed(qPtrSym)
+
+/* @internal - Initialize a mailbox. maxMsg sets the per mailbox cap */
+#define ACT_Q_INIT(qPtrSym, bufPtr, maxMsg) ACT_Mbox_init(qPtrSym, maxMsg)
+
+#endif /* ACT_CFG_MAILBOX == ACT_MAILBOX_LINKED */
+
+#if ACT_CFG_MAILBOX == ACT_MAILBOX_EDF
+
+/**
+ * @brief Earliest deadline first mailbox used as Active object queue. Do not access members directly.
+ *
+ * Queued events are kept in a binary heap in the queue buffer, ordered by absolute deadline (posting time +
+ * ACT_Evt_setDeadline), then by posting order. Events without deadline come after all events with deadline.
+ * An event whose deadline has passed when it is dequeued is dropped: it is counted, given to an optional stale
+ * function and freed, and the next event is dequeued instead.
+ *
+ * Put and get take a short lock (a spinlock on Zephyr, so posting from ISRs is safe) for O(log n) heap updates.
+ */
+
+/* @internal - Heap entry */
+typedef struct active_edfEntry
+{
+  uint32_t dueUs;    // Absolute deadline, ACT_TIMEUS_GET time base truncated to 32 bits
+  uint32_t seq;      // Posting order, for FIFO order on equal deadlines and events without deadline
+  bool hasDeadline;  // False for events without deadline
+  ACT_QEntry entry;  // Queued event
+} ACT_EdfEntry;
+
+/**
+ * @brief Stale function, called by the receiving Active object's thread before a stale event is freed
+ *
+ * @param e Event dropped because its deadline passed
+ * @param lateUs Time from the deadline until the event was dequeued
+ */
+typedef void (*ACT_StaleFn)(ACT_Evt const *e, uint32_t lateUs);
+
+typedef struct active_edfMbox ACT_EdfMbox;
+
+struct active_edfMbox
+{
+  ACT_EdfEntry *heap; // Heap in queue buffer
+  size_t cap;         // Max number of queued events
+  size_t used;        // Number of queued events
+  uint32_t seq;       // Posting order of next event
+  atomic_uint stale;  // Number of dropped stale events
+  ACT_StaleFn staleFn;
+  ACT_LOCK(lock);
+  ACT_SEM(sem); // Number of queued events ready to be taken by receiver
+};
+
+/* Returned by ACT_EdfMbox_put when the mailbox is full */
+#define ACT_MBOX_ERR_FULL (-1)
+/* Returned by ACT_EdfMbox_get when it dropped a stale event instead of getting one */
+#define ACT_MBOX_STALE 1
+
+/**
+ * @brief Initialize an EDF mailbox
+ *
+ * @param mb Mailbox to initialize
+ * @param buf Buffer declared by ACT_QBUF
+ * @param cap Max number of queued events
+ */
+void ACT_EdfMbox_init(ACT_EdfMbox *mb, char *buf, size_t cap);
+
+/**
+ * @brief Put an entry on an EDF mailbox. Does not block. Can be called from ISRs on Zephyr.
+ *
+ * @return 0 on success, ACT_MBOX_ERR_FULL on failure
+ */
+int ACT_EdfMbox_put(ACT_EdfMbox *mb, ACT_QEntry const *entry);
+
+/**
+ * @brief Get the entry with the earliest deadline. Blocks until an entry is available.
+ * Must only be called by the single receiver of the mailbox.
+ *
+ * @return 0 on success, ACT_MBOX_STALE if the entry was stale and dropped
+ */
+int ACT_EdfMbox_get(ACT_EdfMbox *mb, ACT_QEntry *entry);
+
+/* Get number of queued entries in an EDF mailbox */
+size_t ACT_EdfMbox_getUsed(ACT_EdfMbox *mb);
+
+/**
+ * @brief Set a function to call for each stale event dropped by a mailbox
+ *
+ * @param mb Mailbox (the queue given in ACT_QueueData)
+ * @param fn Stale function, NULL for none
+ */
+void ACT_EdfMbox_setStaleFn(ACT_EdfMbox *mb, ACT_StaleFn fn);
+
+/* Get number of stale events dropped by a mailbox */
+uint32_t ACT_EdfMbox_getStale(ACT_EdfMbox *mb);
+
+/**
+ * @brief Active object queue port using EDF mailboxes. Replaces the port's native queue.
+ *
+ */
+
+/* Declare a mailbox with name qSym */
+#define ACT_Q(qSym) ACT_EdfMbox qSym
+
+/* @internal - Declare a pointer to a mailbox */
+#define ACT_QPTR(qPtrSym) ACT_EdfMbox *qPtrSym
+
+/* Declare a mailbox heap buffer with name bufSym and room for maxMsg events */
+#define ACT_QBUF(bufSym, maxMsg) _Alignas(ACT_EdfEntry) char bufSym[sizeof(ACT_EdfEntry) * (maxMsg)]
+
+/* @internal - Get an entry from the mailbox. Blocks forever until an entry is put on the mailbox */
+#define ACT_Q_GET(qPtrSym, entryPtr) ACT_EdfMbox_get(qPtrSym, entryPtr)
+#define ACT_Q_GET_SUCCESS_STATUS 0
+/* @internal - No entry was returned, a stale event was dropped instead */
+#define ACT_Q_GET_STALE_STATUS ACT_MBOX_STALE
+
+/* @internal - Put an entry on the mailbox. Does not block */
+#define ACT_Q_PUT(qPtrSym, entryPtr) ACT_EdfMbox_put(qPtrSym, entryPtr)
+#define ACT_Q_PUT_SUCCESS_STATUS 0
+
+/* @internal - Get number of entries in mailbox */
+#define ACT_Q_USED_GET(qPtrSym) ACT_EdfMbox_getUsed(qPtrSym)
+
+/* @internal - Initialize a mailbox */
+#define ACT_Q_INIT(qPtrSym, bufPtr, maxMsg) ACT_EdfMbox_init(qPtrSym, bufPtr, maxMsg)
+
+#endif /* ACT_CFG_MAILBOX == ACT_MAILBOX_EDF */
+
+#endif /* ACTIVE_MBOX_H */
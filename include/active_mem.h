@@ -7,6 +7,8 @@
 #include <stdint.h>
 
 #include <active_config_loader.h>
+#include <active_mempool.h>
+#include <active_port.h>
 #include <active_types.h>
 #include <active_timer.h>
 
@@ -17,6 +19,86 @@ ACT_Message *ACT_Message_new(Active const *const me, uint16_t msgHeader, void *m
 /* Allocate and initialize new time event from the Active global time event memory pool */
 ACT_TimEvt *ACT_TimEvt_new(ACT_Evt *const e, const Active *const me, const Active *const receiver, ACT_TimerExpiryFn expFn);
 
+/* Allocate and initialize new signal. Returns NULL instead of asserting if the pool is empty or the memory class of me is over quota */
+ACT_Signal *ACT_Signal_tryNew(Active const *const me, uint16_t sig);
+/* Allocate and initialize new message. Returns NULL instead of asserting if the pool is empty or the memory class of me is over quota */
+ACT_Message *ACT_Message_tryNew(Active const *const me, uint16_t msgHeader, void *msgPayload, uint16_t payloadLen);
+
+/* Destructor of an application event type, called before the event memory is freed (e.g. to release a payload) */
+typedef void (*ACT_EvtDestructorFn)(ACT_Evt *e);
+
+/**
+ * @brief Declare a memory pool for an application event type, with blocks of the exact size of the event structure.
+ * The event structure must start with an ACT_Evt.
+ */
+#define ACT_EVT_POOL_DEFINE(memPoolSym, evtStruct, numEvts) ACT_MEMPOOL_DEFINE(memPoolSym, evtStruct, numEvts)
+
+/**
+ * @brief Register an application event type. Events of the type are allocated from its pool with ACT_Evt_new,
+ * and freed to it when no longer referenced. Register all types before allocating events.
+ *
+ * @param type Event type, ACT_USER_EVT to ACT_CFG_MAX_EVT_TYPES - 1
+ * @param pool Pool declared with ACT_EVT_POOL_DEFINE
+ * @param destructor Called before an event of the type is freed. Can be NULL
+ */
+void ACT_EvtType_register(ACT_EvtType type, ACT_MEMPOOL_TYPE *pool, ACT_EvtDestructorFn destructor);
+
+/**
+ * @brief Allocate an event of a registered application event type and initialize its base event.
+ * Upcast the result to the application event structure and set its fields before posting.
+ *
+ * @param type Registered event type
+ * @param me The Active object that will post the event
+ * @return ACT_Evt* Base of the new event
+ */
+ACT_Evt *ACT_Evt_new(ACT_EvtType type, Active const *const me);
+
+/* Allocate an event of a registered application event type. Returns NULL instead of asserting if the pool is empty or
+the memory class of me is over quota */
+ACT_Evt *ACT_Evt_tryNew(ACT_EvtType type, Active const *const me);
+
+/* Get the number of allocated events of a registered or built-in event type */
+uint32_t ACT_mem_getUsed(ACT_EvtType type);
+
+/* Get the number of failed allocations of an event type, as the pool was empty or the memory class over quota */
+uint32_t ACT_mem_getFailed(ACT_EvtType type);
+
+#if ACT_CFG_MEM_QUOTA == 1
+
+/**
+ * @brief Memory quotas (ACT_CFG_MEM_QUOTA). Active objects are assigned to memory classes, e.g. by priority, and each
+ * class can have blocks of an event pool reserved and a cap on the blocks it uses. Blocks reserved for a class are
+ * never given to other classes, so critical Active objects can allocate events while others flood the system.
+ * An allocation beyond the quota fails like an allocation from an empty pool.
+ */
+
+/* Allocation statistics of a memory class for an event type. Read with ACT_mem_getClassStats */
+typedef struct active_memClassStats
+{
+  uint16_t used;     // Events of the type allocated by the class
+  uint16_t maxUsed;  // Max events of the type allocated by the class at a time
+  uint32_t rejected; // Allocations failed as the class was at its cap or only reserved blocks were left
+} ACT_MemClassStats;
+
+/**
+ * @brief Set the quota of a memory class for an event type. Classes without a quota get no reserved blocks and
+ * can use all blocks not reserved by other classes. Set quotas before allocating events of the type.
+ *
+ * @param type Built-in or registered event type
+ * @param memClass Memory class, 0 to ACT_CFG_MEM_CLASSES - 1
+ * @param reserved Blocks only the class can use. Reservations of all classes must fit in the pool
+ * @param max Max blocks the class can use, at least reserved
+ */
+void ACT_mem_setQuota(ACT_EvtType type, uint8_t memClass, uint16_t reserved, uint16_t max);
+
+/* Assign an Active object to a memory class. Active objects are in class 0 when initialized, as are events allocated without sender */
+void ACT_setMemClass(Active *me, uint8_t memClass);
+
+/* Get the allocation statistics of a memory class for an event type with a quota */
+ACT_MemClassStats ACT_mem_getClassStats(ACT_EvtType type, uint8_t memClass);
+
+#endif /* ACT_CFG_MEM_QUOTA == 1 */
+
 /* Allocate memory pool to let active objects create memory pools for message payloads.
 The memory buffer provided by the user must be aligned to an N-byte boundary, where N is a power of 2
 larger than 2 (i.e. 4, 8, 16, …).
@@ -32,7 +114,7 @@ void ACT_mem_refinc(const ACT_Evt *e);
 void ACT_mem_refdec(const ACT_Evt *e);
 
 /* @internal - used by Active framework GC and tests */
-refCnt_t ACT_mem_getRefCount(const ACT_Evt *const e);
+uint16_t ACT_mem_getRefCount(const ACT_Evt *const e);
 /* @internal - used by Active framework tests */
 uint32_t ACT_mem_Signal_getUsed();
 /* @internal - used by Active framework tests */
@@ -40,6 +122,18 @@ uint32_t ACT_mem_Message_getUsed();
 /* @internal - used by Active framework tests */
 uint32_t ACT_mem_TimeEvt_getUsed();
 
+#if ACT_CFG_EVT_HANDLES == 1
+/* @internal - used by Active framework to store an event as handle in queues. A static event holds one of
+ACT_CFG_HANDLE_NUM_STATIC entries until ACT_mem_releaseHandle was called for every handle made for it */
+ACT_Handle ACT_mem_toHandle(const ACT_Evt *e);
+/* @internal - used by Active framework to get an event from a queued handle */
+ACT_Evt *ACT_mem_fromHandle(ACT_Handle h);
+/* @internal - used by Active framework to queue another copy of a held handle */
+void ACT_mem_retainHandle(ACT_Handle h);
+/* @internal - used by Active framework when a handle is taken or dropped from a queue */
+void ACT_mem_releaseHandle(ACT_Handle h);
+#endif /* ACT_CFG_EVT_HANDLES == 1 */
+
 /* Garbage collect / free unreferenced event. Must only be used by application to free events that were
 never posted by application or attached to a posted time event */
 void ACT_mem_gc(const ACT_Evt *e);
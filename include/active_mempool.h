@@ -0,0 +1,111 @@
+#ifndef ACTIVE_MEMPOOL_H
+#define ACTIVE_MEMPOOL_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <active_config_loader.h>
+#include <active_types.h>
+
+/**
+ * @brief Port independent, lock-free memory pool with fixed size blocks.
+ *
+ * Free blocks are kept in a tagged Treiber stack (LIFO). The stack head packs a 16 bit block reference
+ * and a 16 bit ABA tag into one 32 bit word, so that allocation and freeing is a single compare-and-swap
+ * without taking any locks or disabling interrupts. Blocks that were never handed out are given out by
+ * bumping an index, letting pools be defined statically without any runtime initialization.
+ *
+ * The pool is safe to use from ISRs and from multiple cores, as long as 32 bit atomics are lock-free on
+ * the target (e.g. ARMv7-M and ARMv8-M using LDREX/STREX). The pool is only built with ACT_CFG_MEMPOOL_LOCKFREE.
+ *
+ * Do not access members directly.
+ */
+struct active_mempoolData
+{
+  char *buf;                  // Block storage
+  size_t blockSize;           // Size of each block. Multiple of block alignment.
+  uint16_t numBlocks;         // Number of blocks in pool
+  atomic_uint head;           // Free stack head: ABA tag (upper 16 bits) | block index + 1 (lower 16 bits). 0 -> empty.
+  atomic_uint fresh;          // Index of first block never handed out
+  atomic_uint used;           // Number of blocks currently allocated
+  atomic_uint maxUsed;        // Max number of blocks allocated at the same time
+};
+
+/* @internal - Allocation return status when pool is empty */
+#define ACT_MEMPOOL_ERR_NOMEM (-1)
+
+/**
+ * @brief Declare *and* initialize a lock-free memory pool with numObjects blocks of objSize bytes aligned to objAlign.
+ * Expands to a single declaration of the pool, with the block buffer as a compound literal, so a storage class given
+ * in front of the macro applies to the pool. Define pools at file scope only (optionally static), as the buffer does
+ * not compile or dangles at block scope.
+ */
+#define ACT_MEMPOOL_LOCKFREE_DEFINE(memPoolSym, objSize, objAlign, numObjects)                                         \
+  ACT_Mempool memPoolSym = {.buf = (struct { _Alignas(objAlign) char blocks[(objSize) * (numObjects)]; }){{0}}.blocks, \
+                            .blockSize = (objSize),                                                                    \
+                            .numBlocks = (numObjects)}
+
+/**
+ * @brief Initialize a lock-free memory pool at runtime.
+ * memBuf must be aligned to the object alignment and hold numObjects blocks of objSize bytes.
+ *
+ * @param pool Pool to initialize
+ * @param memBuf Block storage
+ * @param objSize Size of each block. Must be a multiple of the object alignment and at least 2 bytes.
+ * @param numObjects Number of blocks (max 65535)
+ */
+void ACT_Mempool_init(ACT_Mempool *pool, void *memBuf, size_t objSize, size_t numObjects);
+
+/**
+ * @brief Allocate a block from a lock-free memory pool. Safe to call from ISRs.
+ *
+ * @param pool Pool to allocate from
+ * @param blockPptr Set to the allocated block, or NULL if pool is empty
+ * @return 0 on success, ACT_MEMPOOL_ERR_NOMEM if pool is empty
+ */
+int ACT_Mempool_alloc(ACT_Mempool *pool, void **blockPptr);
+
+/**
+ * @brief Return a block to a lock-free memory pool. Safe to call from ISRs.
+ *
+ * @param pool Pool the block was allocated from
+ * @param blockPptr Pointer to the block pointer to free
+ */
+void ACT_Mempool_free(ACT_Mempool *pool, void **blockPptr);
+
+/* Get number of blocks currently allocated from pool */
+uint32_t ACT_Mempool_getUsed(ACT_Mempool *pool);
+
+/* Get max number of blocks allocated from pool at the same time. Use to size pools during development */
+uint32_t ACT_Mempool_getMaxUsed(ACT_Mempool *pool);
+
+#if ACT_CFG_MEMPOOL_LOCKFREE == 1
+
+/**
+ * @brief Lock-free memory pool backing the Active event memory pools. Replaces the port's native memory pool.
+ *
+ */
+
+/* @internal  - Declare *and* initialize a static memory pool */
+#define ACT_MEMPOOL_DEFINE(memPoolSym, type, numObjects) ACT_MEMPOOL_LOCKFREE_DEFINE(memPoolSym, sizeof(type), _Alignof(type), numObjects)
+
+/* @internal - Type of memory pools declared by ACT_MEMPOOL_DEFINE */
+#define ACT_MEMPOOL_TYPE ACT_Mempool
+
+/* @internal - Get number of used entries in memory pool. Used for testing */
+#define ACT_MEMPOOL_USED_GET(memPoolPtr) ACT_Mempool_getUsed(memPoolPtr)
+
+/* @internal - Get number of entries in memory pool */
+#define ACT_MEMPOOL_NUM_BLOCKS_GET(memPoolPtr) (memPoolPtr)->numBlocks
+
+/* @internal - Allocate memory for an object from a specified memory pool */
+#define ACT_MEMPOOL_ALLOC(memPoolPtr, dataPptr) ACT_Mempool_alloc(memPoolPtr, (void **)dataPptr)
+/* @internal - Free memory for an object from a specified memory pool */
+#define ACT_MEMPOOL_FREE(memPoolPtr, dataPptr) ACT_Mempool_free(memPoolPtr, (void **)dataPptr)
+/* @internal - Allocation return status on success */
+#define ACT_MEMPOOL_ALLOC_SUCCESS_STATUS 0
+
+#endif /* ACT_CFG_MEMPOOL_LOCKFREE == 1 */
+
+#endif /* ACTIVE_MEMPOOL_H */
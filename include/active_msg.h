@@ -10,16 +10,32 @@
 #define EVT_UPCAST(ptr) ((ACT_Evt *)(ptr))
 #define EVT_CAST(ptr, type) ((type *)(ptr))
 
+/**
+ * @brief Access the sender of an event. Use instead of accessing e->_sender directly to be independent of ACT_CFG_EVT_HANDLES
+ *
+ */
+#if ACT_CFG_EVT_HANDLES == 1
+#define ACT_SENDER_NONE ACT_HANDLE_NONE
+#define ACT_EVT_SENDER(ptr) ACT_fromHandle(EVT_UPCAST(ptr)->_sender)
+/* @internal - Sender reference stored in event */
+#define ACT_SENDER_REF(me) ACT_getHandle(me)
+#else
+#define ACT_SENDER_NONE NULL
+#define ACT_EVT_SENDER(ptr) (EVT_UPCAST(ptr)->_sender)
+/* @internal - Sender reference stored in event */
+#define ACT_SENDER_REF(me) ((Active *)(me))
+#endif /* ACT_CFG_EVT_HANDLES == 1 */
+
 /**
  * @brief Statically and initialize allocate a signal object with no sender information
  *
  */
 #define ACT_SIGNAL_DEFINE(symbol, signal) ACT_Signal symbol =                                                              \
-                                              {.super = (ACT_Evt){.type = ACT_SIGNAL, ._sender = NULL, ._dynamic = false}, \
+                                              {.super = (ACT_Evt){.type = ACT_SIGNAL, ._sender = ACT_SENDER_NONE, ._dynamic = false}, \
                                                .sig = signal};
 
 #define ACT_MESSAGE_DEFINE(symbol, msgheader, msgpayloadptr, msgpayloadLen) ACT_Message symbol =                                                              \
-                                                                                {.super = (ACT_Evt){.type = ACT_MESSAGE, ._sender = NULL, ._dynamic = false}, \
+                                                                                {.super = (ACT_Evt){.type = ACT_MESSAGE, ._sender = ACT_SENDER_NONE, ._dynamic = false}, \
                                                                                  .header = msgheader,                                                         \
                                                                                  .payload = msgpayloadptr,                                                    \
                                                                                  .payloadLen = msgpayloadLen};
@@ -32,10 +48,23 @@
 message types */
 struct active_event
 {
+#if ACT_CFG_EVT_HANDLES == 1
+  ACT_Handle _sender;     // Handle of sender of event
+#else
   Active *_sender;        // Sender of event
+#endif
   ACT_EvtType type;       // Type of event
   const refCnt_t _refcnt; // Number of memory references for event. Const to avoid application modifying by accident.
   const bool _dynamic;    // Flag for memory management to know if event is dynamic or static. Const to avoid application modifying by accident.
+#if ACT_CFG_MEM_QUOTA == 1
+  uint8_t _memClass;      // Memory class charged for a dynamic event
+#endif
+#if ACT_CFG_RPC == 1
+  uint16_t _corrId;       // Correlation ID when posted by ACT_request or ACT_reply, ACT_CORR_NONE otherwise
+#endif
+#if ACT_CFG_MAILBOX == ACT_MAILBOX_EDF
+  uint32_t _deadlineUs;   // Relative deadline from posting, 0 for none. See ACT_Evt_setDeadline
+#endif
 };
 
 /* Time event for posting an attached event on a timer (one shot or periodic) */
@@ -68,9 +97,19 @@ struct active_message
 enum ReservedSignals
 {
   ACT_START_SIG = 0, /* Signal to AO that it has started */
+  ACT_TIMEOUT_SIG,   /* No reply to a request posted with ACT_request in time */
   ACT_USER_SIG       /* First user signal starts here */
 };
 
+/**
+ * @brief Initialize the base event of a statically allocated application event before using it
+ *
+ * @param e Base of the application event
+ * @param me The Active object that will post the event, NULL if posted by a thread that is not an Active object
+ * @param type Registered application event type (see ACT_EvtType_register)
+ */
+void ACT_Evt_init(ACT_Evt *const e, Active const *const me, ACT_EvtType type);
+
 /**
  * @brief Initialize a ACT_Signal structure before using it
  *
@@ -100,6 +139,18 @@ void ACT_Signal_init(ACT_Signal *s, Active const *const me, uint16_t sig);
  */
 void ACT_Message_init(ACT_Message *m, Active const *const me, uint16_t header, void *payload, uint16_t payloadLen);
 
+#if ACT_CFG_MAILBOX == ACT_MAILBOX_EDF
+/**
+ * @brief Set the relative deadline of an event. EDF mailboxes dequeue events with the earliest deadline first
+ * (posting time + deadline), and drop events whose deadline passed before they were dequeued.
+ * Events without deadline are dequeued after all events with deadline, in posting order, and never dropped.
+ *
+ * @param e Event, not yet posted
+ * @param deadlineUs Deadline in microseconds from posting (max ~35 minutes). 0 for no deadline
+ */
+void ACT_Evt_setDeadline(ACT_Evt *const e, uint32_t deadlineUs);
+#endif
+
 /**
  * @brief Initialize a Time event structure before using it
  *
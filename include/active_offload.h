@@ -0,0 +1,137 @@
+#ifndef ACTIVE_OFFLOAD_H
+#define ACTIVE_OFFLOAD_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <active_config_loader.h>
+#include <active_group.h>
+#include <active_msg.h>
+#include <active_port.h>
+#include <active_types.h>
+
+/**
+ * @brief Offload pool for blocking or long running work (flash writes, crypto, compression).
+ *
+ * An Active object submits a job (function, context and optional payload) with a priority. Worker Active objects,
+ * typically of lower thread priority than the submitters, run pending jobs highest priority first, and post a
+ * completion message with the job's header back to the submitter. The submitter keeps processing events meanwhile.
+ *
+ * Jobs are owned by the submitter and carry their own completion message, so neither submitting nor completing
+ * allocates events. The number of pending jobs is bounded by the pool, and a job can only be pending once.
+ */
+
+/* Status codes of offloading */
+#define ACT_OFFLOAD_OK 0
+#define ACT_OFFLOAD_ERR_FULL -1 // maxPending jobs are waiting for a worker
+#define ACT_OFFLOAD_ERR_BUSY -2 // Job is pending or running
+
+/**
+ * @brief Job function, run on a worker thread. May block.
+ *
+ * @param ctx Context given to ACT_Job_init
+ * @param payload Payload given to ACT_Offload_submit
+ * @param payloadLen Payload length
+ * @return int32_t Result, read by the submitter with ACT_Job_getResult
+ */
+typedef int32_t (*ACT_JobFn)(void *ctx, void *payload, uint16_t payloadLen);
+
+/**
+ * @brief Job to run on an offload pool. Do not access members directly.
+ */
+typedef struct active_job
+{
+  ACT_Message done;        // Completion message posted to owner. Payload is the submitted payload
+  Active const *owner;     // Submitting Active object
+  ACT_JobFn fn;            // Job function
+  void *ctx;               // Job function context
+  struct active_job *next; // Next pending job of same priority
+  int32_t result;          // Result of last run
+  atomic_bool busy;        // Pending or running
+} ACT_Job;
+
+/**
+ * @brief Offload pool statistics. Read with ACT_Offload_getStats
+ */
+typedef struct active_offloadStats
+{
+  uint32_t submitted;  // Number of jobs submitted
+  uint32_t completed;  // Number of jobs completed
+  uint32_t rejected;   // Number of jobs not submitted as the pool was full
+  uint32_t maxPending; // Max number of jobs waiting for a worker
+} ACT_OffloadStats;
+
+/* Worker of an offload pool */
+typedef struct active_offloadWorker
+{
+  Active super;                // Worker Active object
+  struct active_offload *pool; // Pool of the worker
+} ACT_OffloadWorker;
+
+/**
+ * @brief Offload pool. Do not access members directly.
+ */
+typedef struct active_offload
+{
+  ACT_Group group;                              // Workers, woken least loaded first
+  Active *members[ACT_CFG_OFFLOAD_MAX_WORKERS]; // Worker Active objects of group
+  ACT_Job *head[ACT_CFG_OFFLOAD_PRIOS];         // Oldest pending job per priority
+  ACT_Job *tail[ACT_CFG_OFFLOAD_PRIOS];         // Newest pending job per priority
+  size_t maxPending;                            // Max number of pending jobs
+  size_t pending;                               // Number of pending jobs
+  ACT_LOCK(lock);                               // Protects pending jobs
+  atomic_uint submitted;
+  atomic_uint completed;
+  atomic_uint rejected;
+  atomic_uint maxPendingSeen;
+} ACT_Offload;
+
+/**
+ * @brief Initialize an offload pool and its workers
+ *
+ * @param pool Pool to initialize
+ * @param workers Array of numWorkers workers
+ * @param numWorkers Number of workers, max ACT_CFG_OFFLOAD_MAX_WORKERS
+ * @param maxPending Max number of jobs waiting for a worker. Worker queues must hold maxPending events
+ * @param qd Array of numWorkers queue data, one per worker
+ * @param td Array of numWorkers thread data, one per worker. Priority sets how jobs compete with Active objects
+ */
+void ACT_Offload_init(ACT_Offload *pool, ACT_OffloadWorker *workers, size_t numWorkers, size_t maxPending,
+                      ACT_QueueData const *qd, ACT_ThreadData const *td);
+
+/* Start all workers of an offload pool */
+void ACT_Offload_start(ACT_Offload *pool);
+
+/**
+ * @brief Initialize a job
+ *
+ * @param job Job to initialize
+ * @param owner Active object submitting the job and receiving its completion message
+ * @param fn Job function
+ * @param ctx Context passed to the job function
+ * @param doneHeader Header of the completion message
+ */
+void ACT_Job_init(ACT_Job *job, Active const *owner, ACT_JobFn fn, void *ctx, uint16_t doneHeader);
+
+/**
+ * @brief Submit a job to run on a worker. The completion message is posted to the owner of the job when done.
+ * A job can be submitted again once its completion message is received.
+ *
+ * @param pool Offload pool
+ * @param job Initialized job, not pending or running
+ * @param payload Optional payload passed to the job function and returned in the completion message
+ * @param payloadLen Payload length
+ * @param prio Priority, 0 (highest) to ACT_CFG_OFFLOAD_PRIOS - 1
+ * @return int ACT_OFFLOAD_OK, ACT_OFFLOAD_ERR_FULL or ACT_OFFLOAD_ERR_BUSY
+ */
+int ACT_Offload_submit(ACT_Offload *pool, ACT_Job *job, void *payload, uint16_t payloadLen, uint8_t prio);
+
+/* Get the result returned by the job function of a completed job */
+int32_t ACT_Job_getResult(ACT_Job const *job);
+
+/* Get a copy of the offload pool statistics */
+ACT_OffloadStats ACT_Offload_getStats(ACT_Offload *pool);
+
+#endif /* ACTIVE_OFFLOAD_H */
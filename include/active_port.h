@@ -1,15 +1,16 @@
 #ifndef ACTIVE_PORT_H
 #define ACTIVE_PORT_H
 
+#include <active_config_loader.h>
 #include <active_types.h>
 
 /*******************************
  *  Compiler intrinsics & CPU architecture
  ******************************/
 
-#ifndef __arm__
-#error "This port only supports ARM architectures"
-#endif /* __arm__ */
+#if !defined(__arm__) && !defined(__unix__) && ACT_CFG_PORT_SIM == 0
+#error "This port only supports ARM architectures and Unix hosts"
+#endif /* !defined(__arm__) && !defined(__unix__) && ACT_CFG_PORT_SIM == 0 */
 
 #ifdef __GNUC__
 
@@ -46,15 +47,281 @@ static void *__attribute__((noinline)) active_get_pc()
  *  Platform port
  ******************************/
 
-#include <zephyr.h>
+#if ACT_CFG_PORT_SIM == 1
+
+/**
+ * @brief Simulation port of the Active framework.
+ *
+ * All Active objects run in the thread calling ACT_SLEEPMS (normally main), stepped one event at a time by
+ * a deterministic scheduler: the highest priority Active object with a pending event runs first (lower number
+ * is higher priority, as in Zephyr), Active objects with equal priority take turns. Processing takes no virtual
+ * time. When all queues are empty, the virtual clock jumps straight to the next timer expiry.
+ *
+ * The calling thread acts as the highest priority thread: Active objects only run while it sleeps
+ * (ACT_SLEEPMS, ACT_SLEEPUS) or waits on a semaphore.
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief Simulation port of a queue used by the Active framework
+ *
+ */
+
+/* @internal - Ring buffer queue. Do not access members directly */
+typedef struct active_simQueue
+{
+  ACT_QEntry *buf;
+  size_t maxMsg;
+  size_t head;
+  size_t used;
+} ACT_SimQueue;
+
+/* @internal - Queue functions used by the port macros */
+void ACT_SimQueue_init(ACT_SimQueue *q, char *buf, size_t maxMsg);
+int ACT_SimQueue_put(ACT_SimQueue *q, ACT_QEntry const *entry);
+int ACT_SimQueue_get(ACT_SimQueue *q, ACT_QEntry *entry);
+
+#if ACT_CFG_MAILBOX == ACT_MAILBOX_NATIVE
+
+/* Declare a message queue with name qSym.
+Used by application to set up a queue */
+#define ACT_Q(qSym) ACT_SimQueue qSym
+
+/* @internal - Declare a pointer to a message queue with name qPtrSym. Used by generic active header file */
+#define ACT_QPTR(qPtrSym) ACT_SimQueue *qPtrSym
+
+/* Declare a message queue buffer with name bufName and room for maxMsg messages.
+Used by application to set up a buffer for the queue */
+#define ACT_QBUF(bufSym, maxMsg) _Alignas(ACT_QEntry) char bufSym[sizeof(ACT_QEntry) * maxMsg]
+
+/* @internal - Get an entry (ACT_QEntry) from the message queue. Only called by the scheduler when the queue is not empty */
+#define ACT_Q_GET(qPtrSym, entryPtr) ACT_SimQueue_get(qPtrSym, entryPtr)
+#define ACT_Q_GET_SUCCESS_STATUS 0
+
+/* @internal - Put an entry (ACT_QEntry) on the message queue. Does not block */
+#define ACT_Q_PUT(qPtrSym, entryPtr) ACT_SimQueue_put(qPtrSym, entryPtr)
+#define ACT_Q_PUT_SUCCESS_STATUS 0
+
+/* @internal - Get number of entries in message queue */
+#define ACT_Q_USED_GET(qPtrSym) ((qPtrSym)->used)
+
+/* @internal - Initialize a message queue with buffer bufPtr holding maxMsg entries. Used by ACT_init */
+#define ACT_Q_INIT(qPtrSym, bufPtr, maxMsg) ACT_SimQueue_init(qPtrSym, bufPtr, maxMsg)
+
+#endif /* ACT_CFG_MAILBOX == ACT_MAILBOX_NATIVE */
+
+/**
+ * @brief Simulation port of a counting semaphore
+ *
+ */
+
+/* @internal - Counting semaphore. Do not access members directly */
+typedef struct active_simSem
+{
+  unsigned int count;
+} ACT_SimSem;
+
+/* @internal - Declare a semaphore */
+#define ACT_SEM(semSym) ACT_SimSem semSym
+
+/* @internal - Initialize a semaphore with zero count */
+#define ACT_SEM_INIT(semPtr) ((semPtr)->count = 0)
+
+/* @internal - Increment semaphore count */
+#define ACT_SEM_GIVE(semPtr) ((semPtr)->count++)
+
+/* @internal - Decrement semaphore count. Runs the scheduler while count is zero */
+#define ACT_SEM_TAKE(semPtr) ACT_Sim_semTake(semPtr)
+
+/* @internal - Decrement semaphore count, waiting at most ms milliseconds of virtual time. True if taken */
+#define ACT_SEM_TAKE_MS(semPtr, ms) ACT_Sim_semTakeMs(semPtr, ms)
+
+/* @internal - Declare a lock for short critical sections. Nothing runs concurrently in simulation */
+#define ACT_LOCK(lockSym) unsigned char lockSym
+
+/* @internal - Type of key returned by ACT_LOCK_TAKE */
+#define ACT_LOCK_KEY unsigned int
+
+/* @internal - Initialize a lock */
+#define ACT_LOCK_INIT(lockPtr) ((void)(lockPtr))
 
-#ifdef __ZEPHYR__
+/* @internal - Take a lock, returns a key for ACT_LOCK_GIVE */
+#define ACT_LOCK_TAKE(lockPtr) ((void)(lockPtr), 0u)
+
+/* @internal - Give a lock taken with key */
+#define ACT_LOCK_GIVE(lockPtr, key) ((void)(lockPtr), (void)(key))
+
+/**
+ * @brief Simulation port of threads used by the Active framework
+ *
+ */
+
+typedef struct active_simThread ACT_SimThread;
+
+/* @internal - Scheduling state of an Active object. Do not access members directly */
+struct active_simThread
+{
+  Active *me;
+  int pri;
+  bool started;         // Started by ACT_start
+  bool initialized;     // Start event processed
+  ACT_SimThread *next;  // Next Active object in order of ACT_init
+};
+
+/* Declare a thread
+Used by the application to set up a thread for the active object */
+#define ACT_THREAD(threadSym) ACT_SimThread threadSym
+
+/* @internal - Declare a pointer to thread handler. Used by generic active header file */
+#define ACT_THREADPTR(threadPtrSym) ACT_SimThread *threadPtrSym
+
+/* Declare a thread stack. Active objects run on the stack of the calling thread, so only a placeholder is declared */
+#define ACT_THREAD_STACK_DEFINE(stackSym, size) char stackSym[1]
+
+/* @internal - Declare a thread stack pointer */
+#define ACT_THREAD_STACKPTR(stackPtrSym) char *stackPtrSym;
+
+/* Declares a size_t type with name stackSizeSym and initialize with the size of the thread stack. */
+#define ACT_THREAD_STACK_SIZE(stackSizeSym, stackSym) const size_t stackSizeSym = sizeof(stackSym)
+
+/* Size of a thread stack defined with ACT_THREAD_STACK_DEFINE, as a constant expression. Used by ACT_DEFINE */
+#define ACT_THREAD_STACK_SIZEOF(stackSym) sizeof(stackSym)
+
+/* Returns a thread priority. Higher number -> lower pri, as in Zephyr */
+#define ACT_THREAD_PRI(x) (x)
+
+/* @internal - Change the priority of a started thread */
+#define ACT_THREAD_PRI_SET(threadPtr, priority) ((threadPtr)->pri = (priority))
+
+/**
+ * @brief Simulation port of a timer, running on the virtual clock
+ *
+ */
+
+typedef struct active_simTimer ACT_SimTimer;
+
+/* @internal - Timer on the virtual clock. Do not access members directly */
+struct active_simTimer
+{
+  void (*expiryFn)(ACT_SimTimer *timer);
+  void *param;
+  uint64_t expiryUs;
+  uint64_t periodUs;
+  bool armed;
+  ACT_SimTimer *next;
+};
+
+/* @internal - Timer functions used by the port macros */
+void ACT_SimTimer_init(ACT_SimTimer *t, void (*expiryFn)(ACT_SimTimer *));
+void ACT_SimTimer_start(ACT_SimTimer *t, uint64_t durationMs, uint64_t periodMs);
+void ACT_SimTimer_stop(ACT_SimTimer *t);
+
+/* @internal - Declare a timer. Used by Time events */
+#define ACT_TIMER(timerSym) ACT_SimTimer timerSym
+
+/* @internal - Declare a pointer to a timer */
+#define ACT_TIMERPTR(timerPtrSym) ACT_SimTimer *timerPtrSym
+
+/* @internal - Initialize an ACT_Timer struct */
+#define ACT_TIMER_INIT(timerPtr, expiryFn) ACT_SimTimer_init(&(timerPtr->impl), expiryFn)
+
+/* @internal - Set ACT_Timer application defined parameter */
+#define ACT_TIMER_PARAM_SET(timerPtr, paramPtr) ((timerPtr)->impl.param = (void *)(paramPtr))
+/* @internal - Get application defined parameter from native (port) timer. */
+#define ACT_TIMER_PARAM_GET(nativeTimerPtr) ((nativeTimerPtr)->param)
+
+/* @internal - Start ACT_Timer */
+#define ACT_TIMER_START(timerPtr, durationMs, periodMs) ACT_SimTimer_start(&(timerPtr->impl), durationMs, periodMs)
+/* @internal - Stop ACT_Timer */
+#define ACT_TIMER_STOP(timerPtr) ACT_SimTimer_stop(&(timerPtr->impl));
+
+/**
+ * @brief Simulation port of debug printing
+ *
+ */
+
+#if ACT_CFG_DEBUG_PRINT == 1
+#define ACT_DBGPRINT(fmt, ...) printf(fmt, ##__VA_ARGS__)
+#else
+#define ACT_DBGPRINT(fmt, ...)
+#endif
+
+/* Print regardless of ACT_CFG_DEBUG_PRINT, e.g. benchmark results */
+#define ACT_PRINT(fmt, ...) printf(fmt, ##__VA_ARGS__)
+
+/**
+ * @brief Simulation port of thread sleep / time functions. Sleeping runs the scheduler on the virtual clock.
+ *
+ */
+
+/* Sleep for ms milliseconds of virtual time */
+#define ACT_SLEEPMS(ms) ACT_Sim_sleepUs((uint64_t)(ms) * 1000u)
+
+/* Sleep for us microseconds of virtual time */
+#define ACT_SLEEPUS(us) ACT_Sim_sleepUs(us)
+
+/* Get current virtual time in ms */
+#define ACT_TIMEMS_GET() ((int64_t)(ACT_Sim_nowUs() / 1000u))
+
+/* Get current virtual time in us */
+#define ACT_TIMEUS_GET() ACT_Sim_nowUs()
+
+/* Get free running cycle counter (wraps around). Nanoseconds of virtual time */
+#define ACT_CYCLES_GET() ((uint32_t)(ACT_Sim_nowUs() * 1000u))
+
+/* Convert a number of cycles to nanoseconds */
+#define ACT_CYCLES_TO_NS(cycles) ((uint64_t)(cycles))
+
+/*******************************
+ *  Platform specific functions
+ **************************** */
+
+/* Current virtual time in microseconds */
+uint64_t ACT_Sim_nowUs(void);
+
+/**
+ * @brief Advance virtual time by us microseconds.
+ * Called outside Active objects, all events and timers due until then are processed.
+ * Called from an Active object, time is advanced and due timers expire, but no other Active object runs.
+ */
+void ACT_Sim_sleepUs(uint64_t us);
+
+/**
+ * @brief Let the highest priority Active object with pending work process its start event or one event,
+ * without advancing virtual time.
+ *
+ * @return true if an event was processed, false if all Active objects are idle
+ */
+bool ACT_Sim_step(void);
+
+/* Take semaphore. Runs the scheduler (and advances virtual time) while the count is zero */
+void ACT_Sim_semTake(ACT_SimSem *sem);
+
+/* Take semaphore. Runs the scheduler while the count is zero, until ms milliseconds of virtual time passed */
+bool ACT_Sim_semTakeMs(ACT_SimSem *sem, uint32_t ms);
+
+/**
+ * @brief Timer expiry function. Called by the scheduler when a timer expires on the virtual clock.
+ * Used as adapter between native timer and Active Time event
+ *
+ */
+void ACT_NativeTimerExpiryFn(ACT_TIMERPTR(nativeTimerPtr));
+
+#elif defined(__ZEPHYR__)
+
+#include <zephyr.h>
 
 /**
  * @brief Zephyr RTOS port of a queue used by the Active framework
  *
  */
 
+#if ACT_CFG_MAILBOX == ACT_MAILBOX_NATIVE
+
 /* Declare a  message queue with name qSym.
 Used by application to set up a queue */
 #define ACT_Q(qSym) struct k_msgq qSym
@@ -64,18 +331,61 @@ Used by application to set up a queue */
 
 /* Declare a message queue buffer with name bufName and room for maxMsg messages.
 Used by application to set up a buffer for the queue */
-#define ACT_QBUF(bufSym, maxMsg) _Alignas(ACT_Evt *) char bufSym[sizeof(ACT_Evt *) * maxMsg]
+#define ACT_QBUF(bufSym, maxMsg) _Alignas(ACT_QEntry) char bufSym[sizeof(ACT_QEntry) * maxMsg]
 
-/* @internal - Get an entry from the message queue. Used by active framework to get Events in Active objects.
+/* @internal - Get an entry (ACT_QEntry) from the message queue. Used by active framework to get Events in Active objects.
 Function blocks Active object forever until message is put on its queue  */
-#define ACT_Q_GET(qPtrSym, evtPtrPtr) k_msgq_get((struct k_msgq *)qPtrSym, evtPtrPtr, K_FOREVER)
+#define ACT_Q_GET(qPtrSym, entryPtr) k_msgq_get((struct k_msgq *)qPtrSym, entryPtr, K_FOREVER)
 #define ACT_Q_GET_SUCCESS_STATUS 0
 
-/* @internal - Put an entry on the message queue. Used by active framework to post Events to Active objects.
+/* @internal - Put an entry (ACT_QEntry) on the message queue. Used by active framework to post Events to Active objects.
 Function does not block but returns immediately */
-#define ACT_Q_PUT(qPtrSym, evtPtrPtr) k_msgq_put((struct k_msgq *)qPtrSym, evtPtrPtr, K_NO_WAIT);
+#define ACT_Q_PUT(qPtrSym, entryPtr) k_msgq_put((struct k_msgq *)qPtrSym, entryPtr, K_NO_WAIT);
 #define ACT_Q_PUT_SUCCESS_STATUS 0
 
+/* @internal - Get number of entries in message queue */
+#define ACT_Q_USED_GET(qPtrSym) k_msgq_num_used_get((struct k_msgq *)qPtrSym)
+
+/* @internal - Initialize a message queue with buffer bufPtr holding maxMsg entries. Used by ACT_init */
+#define ACT_Q_INIT(qPtrSym, bufPtr, maxMsg) k_msgq_init((struct k_msgq *)qPtrSym, bufPtr, sizeof(ACT_QEntry), maxMsg)
+
+#endif /* ACT_CFG_MAILBOX == ACT_MAILBOX_NATIVE */
+
+/**
+ * @brief Zephyr RTOS port of a counting semaphore
+ *
+ */
+
+/* @internal - Declare a semaphore */
+#define ACT_SEM(semSym) struct k_sem semSym
+
+/* @internal - Initialize a semaphore with zero count */
+#define ACT_SEM_INIT(semPtr) k_sem_init(semPtr, 0, K_SEM_MAX_LIMIT)
+
+/* @internal - Increment semaphore count. Can be called from ISRs */
+#define ACT_SEM_GIVE(semPtr) k_sem_give(semPtr)
+
+/* @internal - Decrement semaphore count. Blocks forever while count is zero */
+#define ACT_SEM_TAKE(semPtr) k_sem_take(semPtr, K_FOREVER)
+
+/* @internal - Decrement semaphore count, waiting at most ms milliseconds. True if taken */
+#define ACT_SEM_TAKE_MS(semPtr, ms) (k_sem_take(semPtr, K_MSEC(ms)) == 0)
+
+/* @internal - Declare a lock for short critical sections. Can be taken from ISRs */
+#define ACT_LOCK(lockSym) struct k_spinlock lockSym
+
+/* @internal - Type of key returned by ACT_LOCK_TAKE */
+#define ACT_LOCK_KEY k_spinlock_key_t
+
+/* @internal - Initialize a lock. Zephyr spinlocks are ready when zeroed */
+#define ACT_LOCK_INIT(lockPtr) (*(lockPtr) = (struct k_spinlock){0})
+
+/* @internal - Take a lock, returns a key for ACT_LOCK_GIVE */
+#define ACT_LOCK_TAKE(lockPtr) k_spin_lock(lockPtr)
+
+/* @internal - Give a lock taken with key */
+#define ACT_LOCK_GIVE(lockPtr, key) k_spin_unlock(lockPtr, key)
+
 /**
  * @brief Zephyr RTOS port of threads used by the Active framework
  *
@@ -102,11 +412,24 @@ Used by the application to set up a stack for the active object thread */
  */
 #define ACT_THREAD_STACK_SIZE(stackSizeSym, stackSym) const size_t stackSizeSym = K_THREAD_STACK_SIZEOF(stackSym)
 
+/* Size of a thread stack defined with ACT_THREAD_STACK_DEFINE, as a constant expression. Used by ACT_DEFINE */
+#define ACT_THREAD_STACK_SIZEOF(stackSym) K_THREAD_STACK_SIZEOF(stackSym)
+
 /* Returns a thread priority. Higher number -> lower pri in Zephyr.
 Main thread has defauly pri 0. Non-negative numbers are preemptive threads
 https://docs.zephyrproject.org/latest/kernel/services/threads/index.html#thread-priorities */
 #define ACT_THREAD_PRI(x) (x)
 
+/* @internal - Change the priority of a started thread */
+#define ACT_THREAD_PRI_SET(threadPtr, priority) k_thread_priority_set(threadPtr, priority)
+
+/* @internal - Define an entry of the actor table (ACT_DEFINE). The table is an iterable ROM section, placed by the
+linker script snippet zephyr/active_actors.ld */
+#define ACT_ACTOR_TABLE_ENTRY(sym) const STRUCT_SECTION_ITERABLE(active_actorDef, sym)
+
+/* @internal - Iterate the actor table */
+#define ACT_ACTOR_TABLE_FOREACH(defPtr) STRUCT_SECTION_FOREACH(active_actorDef, defPtr)
+
 /**
  * @brief Zephyr RTOS port of a timer
  *
@@ -136,12 +459,20 @@ https://docs.zephyrproject.org/latest/kernel/services/threads/index.html#thread-
  *
  */
 
+#if ACT_CFG_MEMPOOL_LOCKFREE == 0
+
 /* @internal  - Declare *and* initialize a static memory pool */
 #define ACT_MEMPOOL_DEFINE(memPoolSym, type, numObjects) K_MEM_SLAB_DEFINE(memPoolSym, sizeof(type), numObjects, _Alignof(type))
 
+/* @internal - Type of memory pools declared by ACT_MEMPOOL_DEFINE */
+#define ACT_MEMPOOL_TYPE struct k_mem_slab
+
 /* @internal - Get number of used entries in memory pool. Used for testing */
 #define ACT_MEMPOOL_USED_GET(memPoolPtr) (memPoolPtr)->num_used
 
+/* @internal - Get number of entries in memory pool */
+#define ACT_MEMPOOL_NUM_BLOCKS_GET(memPoolPtr) (memPoolPtr)->num_blocks
+
 /* @internal - Allocate memory for an object from a specified memory pool */
 #define ACT_MEMPOOL_ALLOC(memPoolPtr, dataPptr) k_mem_slab_alloc(memPoolPtr, (void *)dataPptr, K_NO_WAIT)
 /* @internal - Free memory for an object from a specified memory pool */
@@ -149,6 +480,8 @@ https://docs.zephyrproject.org/latest/kernel/services/threads/index.html#thread-
 /* @internal - Allocation return status on success */
 #define ACT_MEMPOOL_ALLOC_SUCCESS_STATUS 0
 
+#endif /* ACT_CFG_MEMPOOL_LOCKFREE == 0 */
+
 /* Declare a memory pool */
 // #define ACT_MEMPOOL(memPoolSym) struct k_mem_slab memPoolSym;
 
@@ -164,6 +497,9 @@ https://docs.zephyrproject.org/latest/kernel/services/threads/index.html#thread-
 #define ACT_DBGPRINT(fmt, ...)
 #endif
 
+/* Print regardless of ACT_CFG_DEBUG_PRINT, e.g. benchmark results */
+#define ACT_PRINT(fmt, ...) printk(fmt, ##__VA_ARGS__)
+
 /**
  * @brief Zephyr port of thread sleep / time functions (for examples and tests)
  *
@@ -179,6 +515,15 @@ set by clock hardware and CONFIG_SYS_CLOCK_TICKS_PER_SEC */
 /* Get current time in ms - used by tests */
 #define ACT_TIMEMS_GET() k_uptime_get()
 
+/* Get current time in us (64 bit). Resolution is one kernel tick */
+#define ACT_TIMEUS_GET() k_ticks_to_us_floor64(k_uptime_ticks())
+
+/* Get free running hardware cycle counter for high resolution time stamps (wraps around) */
+#define ACT_CYCLES_GET() k_cycle_get_32()
+
+/* Convert a number of hardware cycles to nanoseconds */
+#define ACT_CYCLES_TO_NS(cycles) k_cyc_to_ns_floor64(cycles)
+
 /*******************************
  *  Platform specific functions
  **************************** */
@@ -190,8 +535,265 @@ set by clock hardware and CONFIG_SYS_CLOCK_TICKS_PER_SEC */
  */
 void ACT_NativeTimerExpiryFn(ACT_TIMERPTR(nativeTimerPtr));
 
+#elif defined(__unix__)
+
+/**
+ * @brief POSIX (Linux host) port of the Active framework, using pthreads.
+ * Used for running Active applications, tests and benchmarks on a host. Thread priorities are not used.
+ *
+ */
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#if ACT_CFG_MEMPOOL_LOCKFREE == 0
+#error "POSIX port requires ACT_CFG_MEMPOOL_LOCKFREE"
+#endif
+
+/**
+ * @brief POSIX port of a queue used by the Active framework
+ *
+ */
+
+/* @internal - Bounded queue protected by a mutex. Do not access members directly */
+typedef struct active_posixQueue
+{
+  pthread_mutex_t lock;
+  pthread_cond_t notEmpty;
+  ACT_QEntry *buf;
+  size_t maxMsg;
+  size_t head;
+  size_t used;
+} ACT_PosixQueue;
+
+/* @internal - Queue functions used by the port macros */
+void ACT_PosixQueue_init(ACT_PosixQueue *q, char *buf, size_t maxMsg);
+int ACT_PosixQueue_put(ACT_PosixQueue *q, ACT_QEntry const *entry);
+int ACT_PosixQueue_get(ACT_PosixQueue *q, ACT_QEntry *entry);
+size_t ACT_PosixQueue_getUsed(ACT_PosixQueue *q);
+
+#if ACT_CFG_MAILBOX == ACT_MAILBOX_NATIVE
+
+/* Declare a message queue with name qSym.
+Used by application to set up a queue */
+#define ACT_Q(qSym) ACT_PosixQueue qSym
+
+/* @internal - Declare a pointer to a message queue with name qPtrSym. Used by generic active header file */
+#define ACT_QPTR(qPtrSym) ACT_PosixQueue *qPtrSym
+
+/* Declare a message queue buffer with name bufName and room for maxMsg messages.
+Used by application to set up a buffer for the queue */
+#define ACT_QBUF(bufSym, maxMsg) _Alignas(ACT_QEntry) char bufSym[sizeof(ACT_QEntry) * maxMsg]
+
+/* @internal - Get an entry (ACT_QEntry) from the message queue. Blocks until an entry is put on the queue */
+#define ACT_Q_GET(qPtrSym, entryPtr) ACT_PosixQueue_get(qPtrSym, entryPtr)
+#define ACT_Q_GET_SUCCESS_STATUS 0
+
+/* @internal - Put an entry (ACT_QEntry) on the message queue. Does not block */
+#define ACT_Q_PUT(qPtrSym, entryPtr) ACT_PosixQueue_put(qPtrSym, entryPtr)
+#define ACT_Q_PUT_SUCCESS_STATUS 0
+
+/* @internal - Get number of entries in message queue */
+#define ACT_Q_USED_GET(qPtrSym) ACT_PosixQueue_getUsed(qPtrSym)
+
+/* @internal - Initialize a message queue with buffer bufPtr holding maxMsg entries. Used by ACT_init */
+#define ACT_Q_INIT(qPtrSym, bufPtr, maxMsg) ACT_PosixQueue_init(qPtrSym, bufPtr, maxMsg)
+
+#endif /* ACT_CFG_MAILBOX == ACT_MAILBOX_NATIVE */
+
+/**
+ * @brief POSIX port of a counting semaphore
+ *
+ */
+
+/* @internal - Declare a semaphore */
+#define ACT_SEM(semSym) sem_t semSym
+
+/* @internal - Initialize a semaphore with zero count */
+#define ACT_SEM_INIT(semPtr) sem_init(semPtr, 0, 0)
+
+/* @internal - Increment semaphore count */
+#define ACT_SEM_GIVE(semPtr) sem_post(semPtr)
+
+/* @internal - Decrement semaphore count. Blocks forever while count is zero */
+#define ACT_SEM_TAKE(semPtr) ACT_Posix_semTake(semPtr)
+
+/* @internal - Decrement semaphore count, waiting at most ms milliseconds. True if taken */
+#define ACT_SEM_TAKE_MS(semPtr, ms) ACT_Posix_semTakeMs(semPtr, ms)
+
+/* @internal - Declare a lock for short critical sections */
+#define ACT_LOCK(lockSym) pthread_mutex_t lockSym
+
+/* @internal - Type of key returned by ACT_LOCK_TAKE */
+#define ACT_LOCK_KEY int
+
+/* @internal - Initialize a lock */
+#define ACT_LOCK_INIT(lockPtr) pthread_mutex_init(lockPtr, NULL)
+
+/* @internal - Take a lock, returns a key for ACT_LOCK_GIVE */
+#define ACT_LOCK_TAKE(lockPtr) pthread_mutex_lock(lockPtr)
+
+/* @internal - Give a lock taken with key */
+#define ACT_LOCK_GIVE(lockPtr, key) ((void)(key), pthread_mutex_unlock(lockPtr))
+
+/**
+ * @brief POSIX port of threads used by the Active framework
+ *
+ */
+
+/* Declare a thread
+Used by the application to set up a thread for the active object */
+#define ACT_THREAD(threadSym) pthread_t threadSym
+
+/* @internal - Declare a pointer to thread handler. Used by generic active header file */
+#define ACT_THREADPTR(threadPtrSym) pthread_t *threadPtrSym
+
+/* Declare a thread stack. Host threads use stacks allocated by pthreads, so only a placeholder is declared */
+#define ACT_THREAD_STACK_DEFINE(stackSym, size) char stackSym[1]
+
+/* @internal - Declare a thread stack pointer */
+#define ACT_THREAD_STACKPTR(stackPtrSym) char *stackPtrSym;
+
+/* Declares a size_t type with name stackSizeSym and initialize with the size of the thread stack. */
+#define ACT_THREAD_STACK_SIZE(stackSizeSym, stackSym) const size_t stackSizeSym = sizeof(stackSym)
+
+/* Size of a thread stack defined with ACT_THREAD_STACK_DEFINE, as a constant expression. Used by ACT_DEFINE */
+#define ACT_THREAD_STACK_SIZEOF(stackSym) sizeof(stackSym)
+
+/* Returns a thread priority. Not used by the POSIX port */
+#define ACT_THREAD_PRI(x) (x)
+
+/* @internal - Change the priority of a started thread. Not used by the POSIX port */
+#define ACT_THREAD_PRI_SET(threadPtr, priority) ((void)(threadPtr), (void)(priority))
+
+/**
+ * @brief POSIX port of a timer. Timers expire in the context of one timer thread.
+ *
+ */
+
+typedef struct active_posixTimer ACT_PosixTimer;
+
+/* @internal - Timer served by the timer thread. Do not access members directly */
+struct active_posixTimer
+{
+  void (*expiryFn)(ACT_PosixTimer *timer);
+  void *param;
+  uint64_t expiryNs;
+  uint64_t periodNs;
+  bool armed;
+  ACT_PosixTimer *next;
+};
+
+/* @internal - Timer functions used by the port macros */
+void ACT_PosixTimer_init(ACT_PosixTimer *t, void (*expiryFn)(ACT_PosixTimer *));
+void ACT_PosixTimer_start(ACT_PosixTimer *t, uint64_t durationMs, uint64_t periodMs);
+void ACT_PosixTimer_stop(ACT_PosixTimer *t);
+
+/* @internal - Declare a timer. Used by Time events */
+#define ACT_TIMER(timerSym) ACT_PosixTimer timerSym
+
+/* @internal - Declare a pointer to a timer */
+#define ACT_TIMERPTR(timerPtrSym) ACT_PosixTimer *timerPtrSym
+
+/* @internal - Initialize an ACT_Timer struct */
+#define ACT_TIMER_INIT(timerPtr, expiryFn) ACT_PosixTimer_init(&(timerPtr->impl), expiryFn)
+
+/* @internal - Set ACT_Timer application defined parameter */
+#define ACT_TIMER_PARAM_SET(timerPtr, paramPtr) ((timerPtr)->impl.param = (void *)(paramPtr))
+/* @internal - Get application defined parameter from native (port) timer. */
+#define ACT_TIMER_PARAM_GET(nativeTimerPtr) ((nativeTimerPtr)->param)
+
+/* @internal - Start ACT_Timer */
+#define ACT_TIMER_START(timerPtr, durationMs, periodMs) ACT_PosixTimer_start(&(timerPtr->impl), durationMs, periodMs)
+/* @internal - Stop ACT_Timer */
+#define ACT_TIMER_STOP(timerPtr) ACT_PosixTimer_stop(&(timerPtr->impl));
+
+/**
+ * @brief POSIX port of debug printing
+ *
+ */
+
+#if ACT_CFG_DEBUG_PRINT == 1
+#define ACT_DBGPRINT(fmt, ...) printf(fmt, ##__VA_ARGS__)
+#else
+#define ACT_DBGPRINT(fmt, ...)
+#endif
+
+/* Print regardless of ACT_CFG_DEBUG_PRINT, e.g. benchmark results */
+#define ACT_PRINT(fmt, ...) printf(fmt, ##__VA_ARGS__)
+
+/**
+ * @brief POSIX port of thread sleep / time functions (for examples and tests)
+ *
+ */
+
+/* Sleep for ms milliseconds */
+#define ACT_SLEEPMS(ms) ACT_Posix_sleepUs((uint64_t)(ms) * 1000u)
+
+/* Sleep for us microseconds */
+#define ACT_SLEEPUS(us) ACT_Posix_sleepUs(us)
+
+/* Get current time in ms - used by tests */
+#define ACT_TIMEMS_GET() ((int64_t)(ACT_Posix_nowNs() / 1000000u))
+
+/* Get current time in us (64 bit) */
+#define ACT_TIMEUS_GET() (ACT_Posix_nowNs() / 1000u)
+
+/* Get free running cycle counter for high resolution time stamps (wraps around). Nanoseconds on the host */
+#define ACT_CYCLES_GET() ((uint32_t)ACT_Posix_nowNs())
+
+/* Convert a number of cycles to nanoseconds */
+#define ACT_CYCLES_TO_NS(cycles) ((uint64_t)(cycles))
+
+/*******************************
+ *  Platform specific functions
+ **************************** */
+
+/* Monotonic time in nanoseconds */
+uint64_t ACT_Posix_nowNs(void);
+
+/* Sleep for us microseconds */
+void ACT_Posix_sleepUs(uint64_t us);
+
+/* Take semaphore, retrying on signal interruption */
+void ACT_Posix_semTake(sem_t *sem);
+
+/* Take semaphore, waiting at most ms milliseconds */
+bool ACT_Posix_semTakeMs(sem_t *sem, uint32_t ms);
+
+/**
+ * @brief Timer expiry function. Called by the timer thread when a timer expires.
+ * Used as adapter between native timer and Active Time event
+ *
+ */
+void ACT_NativeTimerExpiryFn(ACT_TIMERPTR(nativeTimerPtr));
+
 #else
 #error "No supported port of Active library found"
-#endif // __ZEPHYR__
+#endif // ACT_CFG_PORT_SIM, __ZEPHYR__, __unix__
+
+/*******************************
+ *  Actor table of ports linked with GNU ld section symbols (all but Zephyr)
+ ******************************/
+#if ACT_CFG_PORT_SIM == 1 || !defined(__ZEPHYR__)
+
+/* @internal - Actor table defined with ACT_DEFINE. The linker collects entries in section act_actors and defines
+the start and stop symbols, which are NULL if there are no entries */
+extern const char __start_act_actors[] __attribute__((weak));
+extern const char __stop_act_actors[] __attribute__((weak));
+
+/* @internal - Define an entry of the actor table. Alignment is set so the compiler does not pad entries */
+#define ACT_ACTOR_TABLE_ENTRY(sym) \
+  const ACT_ActorDef sym __attribute__((used, aligned(_Alignof(ACT_ActorDef)), section("act_actors")))
+
+/* @internal - Iterate the actor table */
+#define ACT_ACTOR_TABLE_FOREACH(defPtr)                                       \
+  for (ACT_ActorDef const *defPtr = (ACT_ActorDef const *)__start_act_actors; \
+       defPtr < (ACT_ActorDef const *)__stop_act_actors; defPtr++)
+
+#endif /* ACT_CFG_PORT_SIM == 1 || !defined(__ZEPHYR__) */
 
 #endif /* ACTIVE_PORT_H */
\ No newline at end of file
@@ -0,0 +1,146 @@
+#ifndef ACTIVE_REACTOR_H
+#define ACTIVE_REACTOR_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <active_config_loader.h>
+#include <active_msg.h>
+#include <active_types.h>
+
+#if ACT_CFG_REACTOR == 1
+
+#include <pthread.h>
+#include <sys/epoll.h>
+
+/**
+ * @brief I/O reactor for file descriptors on a Linux host (ACT_CFG_REACTOR).
+ *
+ * Active objects watch file descriptors (sockets, pipes, serial devices, timerfds) for readiness. One reactor thread
+ * waits on an epoll instance and takes up to ACT_CFG_REACTOR_BATCH readiness events per call. Each watch owns a
+ * static message posted to the watching Active object when the descriptor becomes ready. Readiness is accumulated in
+ * the watch until the Active object takes it, so a burst of readiness costs one queue entry per watch.
+ *
+ * Level triggered watches are disarmed when they become ready, and rearmed with ACT_ReactorWatch_rearm once the Active
+ * object has done its I/O. Edge triggered watches stay armed, and the Active object must read or write until EAGAIN.
+ */
+
+/* Status codes of the reactor */
+#define ACT_REACTOR_OK 0
+#define ACT_REACTOR_ERR_OPEN -1   // epoll instance could not be created (see errno)
+#define ACT_REACTOR_ERR_FD -2     // File descriptor could not be watched, rearmed or removed (see errno)
+#define ACT_REACTOR_ERR_THREAD -3 // Reactor thread could not be created
+
+/* Watch modes */
+#define ACT_REACTOR_LEVEL false // Disarmed when ready until ACT_ReactorWatch_rearm
+#define ACT_REACTOR_EDGE true   // Armed until removed, I/O must be done until EAGAIN
+
+typedef struct active_reactor ACT_Reactor;
+
+/**
+ * @brief File descriptor watched by an Active object. Do not access members directly.
+ */
+typedef struct active_reactorWatch
+{
+  ACT_Message ready;    // Posted to owner when ready. Payload is the watch
+  ACT_Reactor *reactor; // Reactor of the watch
+  Active const *owner;  // Watching Active object
+  int fd;               // Watched file descriptor
+  uint32_t interest;    // epoll events watched for, e.g. EPOLLIN | EPOLLOUT
+  bool edge;            // Edge triggered
+  atomic_uint pending;  // epoll events not taken by owner
+} ACT_ReactorWatch;
+
+/**
+ * @brief Reactor statistics. Read with ACT_Reactor_getStats
+ */
+typedef struct active_reactorStats
+{
+  uint32_t waits;  // Number of epoll_wait calls returning readiness
+  uint32_t events; // Number of readiness events
+  uint32_t posts;  // Number of ready messages posted
+} ACT_ReactorStats;
+
+/**
+ * @brief I/O reactor. Do not access members directly.
+ */
+struct active_reactor
+{
+  int epfd;            // epoll instance
+  int stopFd;          // eventfd waking the reactor thread to stop
+  pthread_t thread;    // Reactor thread
+  atomic_bool running; // Reactor thread runs until cleared
+  atomic_uint waits;
+  atomic_uint events;
+  atomic_uint posts;
+};
+
+/**
+ * @brief Create the epoll instance of a reactor
+ *
+ * @param r Reactor to initialize
+ * @return int ACT_REACTOR_OK or ACT_REACTOR_ERR_OPEN
+ */
+int ACT_Reactor_init(ACT_Reactor *r);
+
+/**
+ * @brief Start the reactor thread
+ *
+ * @param r Initialized reactor
+ * @return int ACT_REACTOR_OK or ACT_REACTOR_ERR_THREAD
+ */
+int ACT_Reactor_start(ACT_Reactor *r);
+
+/**
+ * @brief Stop the reactor thread and close the epoll instance. Watched file descriptors are not closed.
+ *
+ * @param r Reactor
+ */
+void ACT_Reactor_stop(ACT_Reactor *r);
+
+/**
+ * @brief Watch a file descriptor. Can be called before or after the reactor is started.
+ *
+ * @param r Reactor
+ * @param w Watch to initialize. Must stay valid until removed
+ * @param fd File descriptor, non-blocking for edge triggered watches
+ * @param interest epoll events to watch for, e.g. EPOLLIN. EPOLLERR and EPOLLHUP are always reported
+ * @param edge ACT_REACTOR_LEVEL or ACT_REACTOR_EDGE
+ * @param owner Active object receiving the ready message
+ * @param header Header of the ready message
+ * @return int ACT_REACTOR_OK or ACT_REACTOR_ERR_FD
+ */
+int ACT_Reactor_add(ACT_Reactor *r, ACT_ReactorWatch *w, int fd, uint32_t interest, bool edge, Active const *owner,
+                    uint16_t header);
+
+/**
+ * @brief Stop watching a file descriptor. A ready message already posted is still received.
+ *
+ * @param w Watch
+ * @return int ACT_REACTOR_OK or ACT_REACTOR_ERR_FD
+ */
+int ACT_Reactor_remove(ACT_ReactorWatch *w);
+
+/**
+ * @brief Take the epoll events accumulated since the last call. Call from the owner when receiving the ready message.
+ *
+ * @param w Watch, the payload of the ready message
+ * @return uint32_t epoll events, e.g. EPOLLIN | EPOLLHUP
+ */
+uint32_t ACT_ReactorWatch_take(ACT_ReactorWatch *w);
+
+/**
+ * @brief Rearm a level triggered watch after doing I/O. No effect on edge triggered watches.
+ *
+ * @param w Watch
+ * @return int ACT_REACTOR_OK or ACT_REACTOR_ERR_FD
+ */
+int ACT_ReactorWatch_rearm(ACT_ReactorWatch *w);
+
+/* Get a copy of the reactor statistics */
+ACT_ReactorStats ACT_Reactor_getStats(ACT_Reactor *r);
+
+#endif /* ACT_CFG_REACTOR == 1 */
+
+#endif /* ACTIVE_REACTOR_H */
@@ -0,0 +1,73 @@
+#ifndef ACTIVE_RECORDER_H
+#define ACTIVE_RECORDER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <active_config_loader.h>
+#include <active_types.h>
+
+#if ACT_CFG_RECORDER == 1
+
+/**
+ * @brief Flight recorder of the last framework events (ACT_CFG_RECORDER).
+ *
+ * Posts, dispatch start and end, allocation and freeing of dynamic events and timer expiries are written to a circular
+ * log of ACT_CFG_RECORDER_LEN records with a cycle time stamp. Recording is always on and costs an atomic increment
+ * and a few stores per record, so it can stay enabled in the field.
+ *
+ * When an assert fires the recorder is frozen, and the log is passed to the assert handler in Active_AssertInfo so the
+ * handler can persist it (e.g. to retained RAM or a file). The last records show which posts filled a queue or which
+ * allocations exhausted a pool.
+ */
+
+/* Kind of record */
+typedef enum
+{
+  ACT_REC_NONE = 0,     // Unused record
+  ACT_REC_POST,         // Event posted to me, before it is queued
+  ACT_REC_DISPATCH,     // me starts processing event
+  ACT_REC_DISPATCH_END, // me finished processing event. Event may be freed, sig is not recorded
+  ACT_REC_ALLOC,        // Dynamic event allocated by me. e is NULL if the pool was exhausted or over quota
+  ACT_REC_FREE,         // Dynamic event freed. me is its sender
+  ACT_REC_TIMER,        // Timer of a time event expired. me is the Active object that started it
+} ACT_RecKind;
+
+/* Flight recorder record */
+typedef struct active_record
+{
+  uint32_t cycles;  // ACT_CYCLES_GET when recorded
+  Active const *me; // Active object, see ACT_RecKind
+  ACT_Evt const *e; // Event
+  uint16_t sig;     // Signal (ACT_Signal) or header (ACT_Message). 0 for other event types
+  uint8_t type;     // Event type (ACT_EvtType)
+  uint8_t kind;     // ACT_RecKind
+} ACT_Record;
+
+/**
+ * @brief Copy the recorded log, oldest record first
+ *
+ * @param out Records are copied here
+ * @param maxRecords Max number of records to copy. The newest records are copied if there are more
+ * @return size_t Number of records copied
+ */
+size_t ACT_Recorder_copy(ACT_Record *out, size_t maxRecords);
+
+/* Stop recording, e.g. before the log is persisted. Called by Active_assert */
+void ACT_Recorder_freeze(void);
+
+/* Clear the log and resume recording */
+void ACT_Recorder_reset(void);
+
+/* @private - Append a record of an initialized event (or NULL). Called by the framework */
+void ACT_Recorder_add(ACT_RecKind kind, Active const *const me, ACT_Evt const *const e);
+
+/* @private - Append a record of an event that is not initialized yet or may be freed. Called by the framework */
+void ACT_Recorder_addType(ACT_RecKind kind, Active const *const me, ACT_Evt const *const e, ACT_EvtType type);
+
+/* @private - Log and index of the next record, for Active_AssertInfo */
+ACT_Record const *ACT_Recorder_get(uint32_t *nextRecord);
+
+#endif /* ACT_CFG_RECORDER == 1 */
+
+#endif /* ACTIVE_RECORDER_H */
@@ -0,0 +1,76 @@
+#ifndef ACTIVE_RPC_H
+#define ACTIVE_RPC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <active_config_loader.h>
+#include <active_types.h>
+
+#if ACT_CFG_RPC == 1
+
+/**
+ * @brief Request/reply between Active objects (ACT_CFG_RPC).
+ *
+ * ACT_request posts a request event tagged with a correlation ID from a pre-allocated table of pending requests.
+ * The receiver answers with ACT_reply, which routes the reply to the sender of the request with the same correlation ID.
+ * If no reply is posted within the time out, the requesting Active object gets an ACT_TIMEOUT_SIG signal with the
+ * correlation ID instead, and a late reply is dropped. Each pending request has its own time event, so no events are
+ * allocated per request. Plain threads use the blocking ACT_call.
+ *
+ * The correlation ID of a received request, reply or time out is read with ACT_getCorrId. It is stored in the event,
+ * so requests and replies must be new dynamic events (e.g. from ACT_Signal_new), posted once. Static events are asserted.
+ */
+
+/* Status codes of request/reply */
+#define ACT_RPC_OK 0
+#define ACT_RPC_ERR_FULL -1    // All ACT_CFG_RPC_MAX_PENDING requests are pending
+#define ACT_RPC_ERR_TIMEOUT -2 // No reply in time (ACT_call)
+#define ACT_RPC_ERR_STALE -3   // Request already answered or timed out, reply was dropped (ACT_reply)
+
+/**
+ * @brief Post a request event and wait for a reply without blocking. The sender of the event gets the reply,
+ * or an ACT_TIMEOUT_SIG signal (sent by the receiver) if there is no reply within timeoutMs.
+ *
+ * @param receiver Receiving Active object
+ * @param e Request event, new and dynamic. Its sender is the requesting Active object. Consumed, also on error
+ * @param timeoutMs Time out in milliseconds
+ * @return int Correlation ID of the request (> 0), or ACT_RPC_ERR_FULL (the request is freed)
+ */
+int ACT_request(Active const *const receiver, ACT_Evt const *const e, uint32_t timeoutMs);
+
+/**
+ * @brief Reply to a request. Call from the dispatch function of the receiver while processing the request.
+ * Events not posted with ACT_request are replied to by posting to their sender.
+ *
+ * @param request Received request event
+ * @param reply Reply event, new and dynamic if the request was posted with ACT_request or ACT_call
+ * @return int ACT_RPC_OK, ACT_RPC_ERR_STALE if the request timed out (the reply is freed), or the ACT_postEvt status
+ */
+int ACT_reply(ACT_Evt const *const request, ACT_Evt const *const reply);
+
+/**
+ * @brief Post a request event from a thread that is not an Active object, and block until a reply or time out.
+ *
+ * @param receiver Receiving Active object
+ * @param e Request event, new and dynamic. Consumed, also on error
+ * @param timeoutMs Time out in milliseconds
+ * @param reply Set to the reply event on ACT_RPC_OK. Release it with ACT_mem_refdec when done with it
+ * @return int ACT_RPC_OK, ACT_RPC_ERR_TIMEOUT or ACT_RPC_ERR_FULL (the request is freed)
+ */
+int ACT_call(Active const *const receiver, ACT_Evt const *const e, uint32_t timeoutMs, ACT_Evt const **reply);
+
+/**
+ * @brief Get the correlation ID of a received request, reply or ACT_TIMEOUT_SIG signal
+ *
+ * @param e Received event
+ * @return uint16_t Correlation ID as returned by ACT_request, ACT_CORR_NONE for other events
+ */
+uint16_t ACT_getCorrId(ACT_Evt const *const e);
+
+/* @private - Dispatch or drop replies and time outs of requests. Called by ACT_threadProcess. True if handled */
+bool ACT_Rpc_process(Active *const me, ACT_Evt const *const e);
+
+#endif /* ACT_CFG_RPC == 1 */
+
+#endif /* ACTIVE_RPC_H */
@@ -0,0 +1,174 @@
+#ifndef ACTIVE_SHM_H
+#define ACTIVE_SHM_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <active_config_loader.h>
+#include <active_types.h>
+
+#if ACT_CFG_SHM == 1
+
+#include <pthread.h>
+
+/**
+ * @brief Shared memory links between processes on a Linux host (ACT_CFG_SHM).
+ *
+ * A link is a named shared memory segment holding two single producer, single consumer byte rings, one per direction.
+ * Each process opens the link from its own side and binds the Active objects that the other process may post to
+ * to port numbers. Active objects in the other process are reached through proxies: an ACT_ShmProxy is an Active object
+ * without queue or thread, so ACT_postEvt on it writes a compact record (signal/header, ports, payload) into the ring.
+ *
+ * A bridge thread per link sleeps on a futex in the receive ring. It turns each record into a dynamic signal or message
+ * and posts it to the bound Active object, with the proxy of the sending port as sender so replies go back over the link.
+ * Received message payloads are not copied: they point into the ring, and the ring space is released when all receivers
+ * have processed the message. Payloads can also be written in place on the sending side with ACT_ShmProxy_claim.
+ *
+ * Unlike local queues, a full ring is reported with ACT_SHM_ERR_FULL instead of an assert, so a slow or dead peer
+ * process can not stop this one. Both processes must be built with the same ACT_CFG_SHM_RING_SIZE.
+ */
+
+/* Status codes of shared memory links */
+#define ACT_SHM_OK 0
+#define ACT_SHM_ERR_OPEN -1   // Segment could not be created, opened or mapped (see errno)
+#define ACT_SHM_ERR_LAYOUT -2 // Segment is not initialized yet or was created with another ACT_CFG_SHM_RING_SIZE
+#define ACT_SHM_ERR_FULL -3   // Not enough free space in ring for the record
+#define ACT_SHM_ERR_THREAD -4 // Bridge thread could not be created
+
+/* No port. Events from Active objects not bound to the link are received with the receiver as sender */
+#define ACT_SHM_PORT_NONE 0xFFu
+
+/* @internal - Ring and segment layout in shared memory, see active_shm.c */
+typedef struct active_shmRing ACT_ShmRing;
+typedef struct active_shmSegment ACT_ShmSegment;
+
+typedef struct active_shmProxy ACT_ShmProxy;
+
+/**
+ * @brief Link statistics. Read with ACT_ShmLink_getStats
+ */
+typedef struct active_shmStats
+{
+  uint32_t sent;     // Number of records sent
+  uint32_t received; // Number of events received and posted to bound Active objects
+  uint32_t full;     // Number of records not sent because the ring was full
+  uint32_t unbound;  // Number of records received for a port with no bound Active object
+} ACT_ShmStats;
+
+/**
+ * @brief One side of a shared memory link. Do not access members directly.
+ */
+typedef struct active_shmLink
+{
+  ACT_ShmSegment *seg;                            // Mapped shared memory segment
+  ACT_ShmRing *tx;                                // Ring written by this process
+  ACT_ShmRing *rx;                                // Ring read by the bridge thread
+  char name[32];                                  // Segment name, unlinked on close by side 0
+  int side;                                       // 0 creates the segment, 1 opens it
+  pthread_mutex_t txLock;                         // Serializes local senders, held from claim to commit
+  void *txRec;                                    // Record being written between claim and commit
+  uint32_t txNext;                                // Ring head after record being written
+  Active *bound[ACT_CFG_SHM_MAX_PORTS];           // Local Active objects by port
+  ACT_ShmProxy *proxies[ACT_CFG_SHM_MAX_PORTS];   // Proxies of remote Active objects by remote port
+  pthread_t bridge;                               // Bridge thread
+  atomic_bool running;                            // Bridge thread runs until cleared
+  uint32_t rxPos;                                 // Ring position of next record to receive
+  ACT_Evt const *inflight[ACT_CFG_SHM_INFLIGHT];  // Received messages with payload in ring, in ring order
+  uint32_t inflightEnd[ACT_CFG_SHM_INFLIGHT];     // Ring position after each in-flight message
+  uint32_t inflightHead;                          // Oldest in-flight message
+  uint32_t inflightCount;                         // Number of in-flight messages
+  atomic_uint sent;
+  atomic_uint received;
+  atomic_uint full;
+  atomic_uint unbound;
+} ACT_ShmLink;
+
+/**
+ * @brief Proxy of an Active object bound to a port in the other process. Post to it with ACT_postEvt.
+ */
+struct active_shmProxy
+{
+  Active super;      // Upcast with ACT_UPCAST to post
+  ACT_ShmLink *link; // Link to the process of the remote Active object
+  uint8_t port;      // Port of the remote Active object
+};
+
+/**
+ * @brief Open one side of a shared memory link. Side 0 (re)creates the segment and must be opened first.
+ * Side 1 returns ACT_SHM_ERR_OPEN or ACT_SHM_ERR_LAYOUT until side 0 has opened it, and can retry.
+ *
+ * @param link Link to initialize
+ * @param name Shared memory object name, e.g. "/myapp_link", max 31 characters
+ * @param side 0 or 1
+ * @return int ACT_SHM_OK or an ACT_SHM_ERR status
+ */
+int ACT_ShmLink_open(ACT_ShmLink *link, char const *name, int side);
+
+/**
+ * @brief Bind a local Active object to a port, so the other process can post to it through a proxy.
+ * Bind before starting the link.
+ *
+ * @param link Link
+ * @param port Port number, below ACT_CFG_SHM_MAX_PORTS
+ * @param me Local Active object
+ */
+void ACT_ShmLink_bind(ACT_ShmLink *link, uint8_t port, Active *me);
+
+/**
+ * @brief Start the bridge thread that receives events from the other process
+ *
+ * @param link Opened link
+ * @return int ACT_SHM_OK or ACT_SHM_ERR_THREAD
+ */
+int ACT_ShmLink_start(ACT_ShmLink *link);
+
+/**
+ * @brief Stop the bridge thread and unmap the segment. Side 0 also removes the segment name.
+ * Close when bound Active objects have processed all received events, as their payloads are in the segment.
+ *
+ * @param link Link
+ */
+void ACT_ShmLink_close(ACT_ShmLink *link);
+
+/**
+ * @brief Get link statistics
+ *
+ * @param link Link
+ * @param stats Statistics are copied here
+ */
+void ACT_ShmLink_getStats(ACT_ShmLink *link, ACT_ShmStats *stats);
+
+/**
+ * @brief Initialize a proxy of the Active object bound to a port in the other process.
+ * Received events sent from that Active object get the proxy as sender. Initialize before starting the link.
+ *
+ * @param p Proxy to initialize
+ * @param link Link to the other process
+ * @param port Port of the remote Active object, below ACT_CFG_SHM_MAX_PORTS
+ */
+void ACT_ShmProxy_init(ACT_ShmProxy *p, ACT_ShmLink *link, uint8_t port);
+
+/**
+ * @brief Claim space for a message payload in the ring, to write it in place without copying.
+ * Holds the link's send lock until ACT_ShmProxy_commit, which must be called next from the same thread.
+ *
+ * @param p Proxy of the receiver
+ * @param header Message header
+ * @param payloadLen Payload length. Records must fit in half the ring
+ * @return void* Payload area aligned to 8 bytes, NULL if the ring is full
+ */
+void *ACT_ShmProxy_claim(ACT_ShmProxy *p, uint16_t header, uint16_t payloadLen);
+
+/**
+ * @brief Send the message claimed with ACT_ShmProxy_claim
+ *
+ * @param p Proxy of the receiver
+ * @param sender Sending Active object. Replies reach it if it is bound to the link
+ * @return int ACT_SHM_OK
+ */
+int ACT_ShmProxy_commit(ACT_ShmProxy *p, Active const *const sender);
+
+#endif /* ACT_CFG_SHM == 1 */
+
+#endif /* ACTIVE_SHM_H */
@@ -0,0 +1,93 @@
+#ifndef ACTIVE_STREAM_H
+#define ACTIVE_STREAM_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <active_types.h>
+#include <active_msg.h>
+
+/**
+ * @brief Byte stream channel. One producer writes bytes into a ring buffer and one consumer Active object reads them
+ * in place, e.g. for audio, UART RX or log output.
+ *
+ * The producer reserves a contiguous free region, writes into it and commits the bytes written. The consumer peeks
+ * a contiguous region of unread bytes, processes it and consumes the bytes processed. Neither side copies bytes or
+ * allocates events. The consumer is woken by a static signal only when it went idle and at least threshold bytes
+ * are unread, so a stream of commits costs one queue entry per wake up.
+ *
+ * Do not access members directly.
+ */
+typedef struct active_stream
+{
+  uint8_t *buf;           // Ring buffer of size bytes
+  uint32_t size;          // Ring buffer size. Power of 2
+  uint32_t threshold;     // Min number of unread bytes to wake an idle consumer
+  atomic_uint head;       // Number of bytes committed
+  atomic_uint tail;       // Number of bytes consumed
+  uint32_t reserved;      // Bytes reserved by the producer. Only accessed by producer
+  atomic_bool idle;       // Consumer read all it needs and waits for the wake signal
+  Active const *consumer; // Reading Active object
+  ACT_Signal wakeSig;     // Posted to consumer when woken
+  uint32_t overruns;      // Number of times ACT_Stream_reserve found the ring full
+} ACT_Stream;
+
+/* Declare a ring buffer for a byte stream with size bytes. size must be a power of 2 */
+#define ACT_STREAM_BUF(bufSym, size) _Alignas(uint32_t) uint8_t bufSym[size]
+
+/**
+ * @brief Initialize a byte stream
+ *
+ * @param s Stream to initialize
+ * @param producer Active object producing bytes. Used as sender of wake signals
+ * @param consumer Active object reading bytes
+ * @param buf Ring buffer declared by ACT_STREAM_BUF
+ * @param size Ring buffer size in bytes. Must be a power of 2
+ * @param threshold Min number of unread bytes to wake the consumer, 1 to wake it on every commit it is idle for
+ * @param wakeSig Signal posted to the consumer when bytes are available. Must be >= ACT_USER_SIG
+ */
+void ACT_Stream_init(ACT_Stream *s, Active const *producer, Active const *consumer, void *buf, uint32_t size,
+                     uint32_t threshold, uint16_t wakeSig);
+
+/**
+ * @brief Reserve the contiguous free region of the ring buffer for writing. Must only be called by the producer.
+ * The region ends at the end of the ring buffer, reserve again after committing to write the wrapped part.
+ *
+ * @param s Stream
+ * @param len Set to the length of the region
+ * @return void* Region to write, or NULL if the ring buffer is full
+ */
+void *ACT_Stream_reserve(ACT_Stream *s, uint32_t *len);
+
+/**
+ * @brief Commit bytes written to the reserved region and wake the consumer if idle. Must only be called by the producer.
+ *
+ * @param s Stream
+ * @param len Number of bytes written, at most the reserved length
+ */
+void ACT_Stream_commit(ACT_Stream *s, uint32_t len);
+
+/**
+ * @brief Get the contiguous region of unread bytes. The bytes are valid until consumed. Must only be called by the
+ * consumer. Call when receiving the wake signal until fewer bytes than the threshold are unread, to be woken again.
+ *
+ * @param s Stream
+ * @param len Set to the length of the region
+ * @return const void* Region to read, or NULL if all bytes are read
+ */
+const void *ACT_Stream_peek(ACT_Stream *s, uint32_t *len);
+
+/**
+ * @brief Consume bytes returned by ACT_Stream_peek, letting the producer reuse them. Must only be called by the consumer.
+ *
+ * @param s Stream
+ * @param len Number of bytes processed, at most the peeked length
+ */
+void ACT_Stream_consume(ACT_Stream *s, uint32_t len);
+
+/* Get the number of committed bytes not consumed yet */
+uint32_t ACT_Stream_getUnread(ACT_Stream *s);
+
+#endif /* ACTIVE_STREAM_H */
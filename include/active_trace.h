@@ -0,0 +1,113 @@
+#ifndef ACTIVE_TRACE_H
+#define ACTIVE_TRACE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <active_config_loader.h>
+#include <active_types.h>
+
+#if ACT_CFG_TRACE == 1
+
+/**
+ * @brief Event trace recording and replay (ACT_CFG_TRACE).
+ *
+ * While recording, every event posted with ACT_postEvt is appended to a trace buffer as a compact binary record,
+ * followed by up to ACT_CFG_TRACE_PAYLOAD_MAX bytes of message payload. This includes time events posted by timers
+ * and the events attached to time events. Space for a record is reserved with a compare-and-swap, so posting from
+ * ISRs and several threads is safe. When the buffer is full, further records are dropped and counted.
+ *
+ * A trace can be copied off target and replayed into a build with the same Active objects, initialized in the same
+ * order, at the original or an accelerated rate. Latency (post to start of processing) and queue depth statistics are
+ * collected per Active object whenever tracing is compiled in, both in the field and during replay.
+ */
+
+/* Binary trace record. Followed by payloadLen payload bytes, padded to a multiple of 4 bytes */
+typedef struct active_traceRecord
+{
+  uint32_t timeUs;     // Time of posting since start of recording. Wraps after ~71 minutes
+  ACT_Handle sender;   // Handle of sending Active object, ACT_HANDLE_NONE if not registered
+  ACT_Handle receiver; // Handle of receiving Active object
+  uint16_t sig;        // Signal (ACT_Signal) or header (ACT_Message). 0 for other event types
+  uint8_t type;        // Event type (ACT_EvtType)
+  uint8_t payloadLen;  // Number of recorded payload bytes following the record
+} ACT_TraceRecord;
+
+/* Number of latency histogram buckets. Bucket i counts latencies below 2^i us, the last bucket also all above */
+#define ACT_TRACE_HIST_BUCKETS 16
+
+/* Latency and queue depth statistics for one Active object */
+typedef struct active_traceStats
+{
+  uint32_t events;                       // Number of events processed
+  uint32_t maxLatencyUs;                 // Max time from post to start of processing
+  uint64_t sumLatencyUs;                 // Sum of latencies, for mean latency
+  uint32_t maxQueueDepth;                // Max number of queued events, incl. a newly posted event
+  uint32_t hist[ACT_TRACE_HIST_BUCKETS]; // Latency histogram
+} ACT_TraceStats;
+
+/**
+ * @brief Filter for replayed records
+ *
+ * @param rec Record to replay
+ * @return true to replay the record, false to skip it
+ */
+typedef bool (*ACT_TraceFilterFn)(ACT_TraceRecord const *rec);
+
+/**
+ * @brief Start recording posted events into a trace buffer. Any previous recording is discarded.
+ *
+ * @param buf Trace buffer, aligned to 4 bytes
+ * @param size Size of trace buffer in bytes
+ */
+void ACT_Trace_start(void *buf, size_t size);
+
+/* Stop recording. Stop when Active objects are idle, so records being written by a concurrent post are complete */
+void ACT_Trace_stop(void);
+
+/* Get number of bytes recorded in the trace buffer */
+size_t ACT_Trace_getLen(void);
+
+/* Get number of records dropped because the trace buffer was full */
+uint32_t ACT_Trace_getDropped(void);
+
+/**
+ * @brief Replay a recorded trace by posting new dynamic events with the recorded sender, receiver, signal/header and payload.
+ * Runs in the calling thread, which sleeps between records to keep the recorded timing. Time events are never replayed,
+ * as the events attached to them are recorded when posted.
+ *
+ * Message payloads point into the trace buffer, which must be valid until all replayed events are processed.
+ * Dynamic event pools and queues must be sized for the replay rate.
+ *
+ * @param buf Trace buffer, aligned to 4 bytes
+ * @param len Number of bytes in trace, see ACT_Trace_getLen
+ * @param speedup 1 to replay at the recorded rate, N to replay N times faster, 0 to replay as fast as possible
+ * @param filter Optional filter to select records to replay (e.g. only external inputs). NULL to replay all
+ * @return uint32_t Number of events replayed
+ */
+uint32_t ACT_Trace_replay(void const *buf, size_t len, uint32_t speedup, ACT_TraceFilterFn filter);
+
+/**
+ * @brief Get latency and queue depth statistics for an Active object
+ *
+ * @param me Active object
+ * @param stats Statistics are copied here
+ */
+void ACT_Trace_getStats(Active const *const me, ACT_TraceStats *stats);
+
+/* Clear statistics of all Active objects. Call when Active objects are idle */
+void ACT_Trace_resetStats(void);
+
+/* Print statistics of all Active objects that processed events, one JSON object per line using ACT_DBGPRINT */
+void ACT_Trace_printStats(void);
+
+/* @private - Record a post. Called by ACT_postEvt before the event is queued */
+void ACT_Trace_post(Active const *const receiver, ACT_Evt const *const e);
+
+/* @private - Update latency statistics from the post time stamp of the event about to be processed. Called by ACT_threadProcess */
+void ACT_Trace_process(Active const *const me);
+
+#endif /* ACT_CFG_TRACE == 1 */
+
+#endif /* ACTIVE_TRACE_H */
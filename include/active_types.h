@@ -2,6 +2,9 @@
 #define ACTIVE_TYPES_H
 
 #include <stdatomic.h>
+#include <stdint.h>
+
+#include <active_config_loader.h>
 
 /* Base event for polymorphism of other objects */
 typedef struct active_event ACT_Evt;
@@ -15,7 +18,8 @@ typedef enum evtType
   ACT_UNUSED = 0, // For asserts on uninitialized events of static storage class
   ACT_SIGNAL,
   ACT_MESSAGE,
-  ACT_TIMEVT
+  ACT_TIMEVT,
+  ACT_USER_EVT // First application defined event type, see ACT_EvtType_register
 } ACT_EvtType;
 
 /* Event memory reference count */
@@ -24,12 +28,48 @@ typedef atomic_ushort refCnt_t;
 /* The active object (actors) in the program */
 typedef struct active_object Active;
 
+/* Dispatch handler function pointer type for active object implementations */
+typedef void (*ACT_DispatchFn)(Active *me, ACT_Evt const *const e);
+
+/* @internal - Post function of Active objects not served by a local queue (e.g. shared memory proxies) */
+typedef int (*ACT_PostFn)(Active const *const receiver, ACT_Evt const *const e);
+
+/* Compact 16 bit reference to an event or active object. See ACT_CFG_EVT_HANDLES */
+typedef uint16_t ACT_Handle;
+
+/* Handle not referring to any event or active object */
+#define ACT_HANDLE_NONE ((ACT_Handle)0)
+
+/* Correlation ID of events not posted as request or reply */
+#define ACT_CORR_NONE ((uint16_t)0)
+
+/* Reference to the event of a queue entry */
+#if ACT_CFG_EVT_HANDLES == 1
+typedef ACT_Handle ACT_QEvtRef;
+#else
+typedef ACT_Evt *ACT_QEvtRef;
+#endif
+
+/* Entry type of Active object queues. The post time stamp is kept in the entry, as events may be const or posted to several receivers */
+#if ACT_CFG_EVT_TIMESTAMP == 1
+typedef struct
+{
+  ACT_QEvtRef evt;   // Queued event
+  uint32_t postedAt; // Cycle counter (ACT_CYCLES_GET) when event was posted
+} ACT_QEntry;
+#else
+typedef ACT_QEvtRef ACT_QEntry;
+#endif
+
 /* Thread data structure for an Active object */
 typedef struct active_threadData ACT_ThreadData;
 
 /* Queue data structure for an Active object */
 typedef struct active_queueData ACT_QueueData;
 
+/* Entry of the table of Active objects defined with ACT_DEFINE */
+typedef struct active_actorDef ACT_ActorDef;
+
 /* Timer data struture type */
 typedef struct active_timerData ACT_Timer;
 
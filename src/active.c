@@ -1,70 +1,340 @@
 #include <active.h>
 
+static const ACT_SIGNAL_DEFINE(startSignal, ACT_START_SIG);
+
 void ACT_threadFn(Active *const me)
+{
+  ACT_threadInit(me);
+
+  while (1)
+  {
+    ACT_Evt *e = ACT_threadNext(me);
+    if (e != NULL)
+    {
+      ACT_threadProcess(me, e);
+    }
+  }
+}
+
+ACT_Evt *ACT_threadNext(Active *const me)
+{
+#if ACT_CFG_DEFER == 1
+  // Recalled events are processed before queued events
+  ACT_Evt *recalled = ACT_Defer_next(me);
+  if (recalled != NULL)
+  {
+#if ACT_CFG_EVT_TIMESTAMP == 1
+    me->_postedAt = ACT_CYCLES_GET();
+#endif
+    return recalled;
+  }
+#endif
+
+#if ACT_CFG_BATCH == 1
+  // Event taken from the queue while gathering a batch goes before the rest of the queue
+  ACT_Evt *held = ACT_Batch_next(me);
+  if (held != NULL)
+  {
+    return held;
+  }
+#endif
+
+  return ACT_threadTake(me);
+}
+
+ACT_Evt *ACT_threadTake(Active *const me)
+{
+  ACT_QEntry entry = {0};
+  /* Blocking wait for events */
+  int status = ACT_Q_GET(me->queue, &entry);
+
+#ifdef ACT_Q_GET_STALE_STATUS
+  // Mailbox dropped a stale event instead
+  if (status == ACT_Q_GET_STALE_STATUS)
+  {
+    return NULL;
+  }
+#endif
+
+  ACT_ASSERT(status == ACT_Q_GET_SUCCESS_STATUS, "ACT_Evt was not retrieved. Error: %i", status);
+  ACT_ARG_UNUSED(status);
+
+  ACT_Evt *e = ACT_QENTRY_TO_EVT(entry);
+  ACT_QENTRY_RELEASE(entry);
+#if ACT_CFG_EVT_TIMESTAMP == 1
+  me->_postedAt = entry.postedAt;
+#endif
+#if ACT_CFG_BOOST == 1
+  ACT_Boost_process(me);
+#endif
+  return e;
+}
+
+bool ACT_threadHasHeld(Active const *const me)
+{
+#if ACT_CFG_DEFER == 1
+  if (me->_defer.recalled > 0)
+  {
+    return true;
+  }
+#endif
+#if ACT_CFG_BATCH == 1
+  if (me->_batch.held != NULL)
+  {
+    return true;
+  }
+#endif
+  ACT_ARG_UNUSED(me);
+  return false;
+}
+
+void ACT_initCommon(Active *const me, ACT_DispatchFn dispatch, ACT_QueueData const *qd, ACT_ThreadData const *td)
 {
   ACT_ASSERT(me != NULL, "Active object is null)");
+  ACT_ASSERT(dispatch != NULL, "Dispatch handler is null");
 
-  static const ACT_SIGNAL_DEFINE(startSignal, ACT_START_SIG);
+  me->dispatch = dispatch;
+
+#if ACT_ACTOR_REGISTRY == 1
+  ACT_register(me);
+#endif
+#if ACT_CFG_SHM == 1
+  me->_post = NULL;
+#endif
+#if ACT_CFG_DEFER == 1
+  me->_defer = (ACT_DeferQueue){0};
+#endif
+#if ACT_CFG_ISR_POST == 1
+  atomic_init(&me->_isr.pending, 0);
+  me->_isr.numSources = 0;
+#endif
+#if ACT_CFG_MEM_QUOTA == 1
+  me->_memClass = 0;
+#endif
+#if ACT_CFG_BOOST == 1
+  me->_boost.policy = NULL;
+  me->_boost.basePri = td->pri;
+  atomic_init(&me->_boost.boosted, false);
+#endif
+#if ACT_CFG_BATCH == 1
+  me->_batch = (ACT_Batches){0};
+#endif
+  ACT_ARG_UNUSED(td);
+
+  ACT_Q_INIT(qd->queue, qd->queBuf, qd->maxMsg);
+  me->queue = qd->queue;
+}
+
+void ACT_threadInit(Active *const me)
+{
+  ACT_ASSERT(me != NULL, "Active object is null)");
 
   // Initialize active object
   me->dispatch(me, EVT_UPCAST(&startSignal));
+}
 
-  while (1)
+#if ACT_CFG_RECORDER == 1
+static void ACT_threadDispatch(Active *const me, ACT_Evt *const e)
+#else
+void ACT_threadProcess(Active *const me, ACT_Evt *const e)
+#endif
+{
+  ACT_ASSERT(e != NULL, "ACT_Evt pointer is null");
+
+#if ACT_CFG_ISR_POST == 1
+  // Doorbell of interrupt sources. Their events are static and dispatched directly
+  if (e == EVT_UPCAST(&ACT_Isr_doorbell))
   {
-    ACT_Evt *e = NULL;
-    /* Blocking wait for events */
-    int status = ACT_Q_GET(me->queue, &e);
+    ACT_Isr_process(me);
+    return;
+  }
+#endif
 
-    ACT_ASSERT(status == ACT_Q_GET_SUCCESS_STATUS, "ACT_Evt was not retrieved. Error: %i", status);
-    ACT_ARG_UNUSED(status);
+#if ACT_CFG_TRACE == 1
+  ACT_Trace_process(me);
+#endif
 
-    ACT_ASSERT(e != NULL, "ACT_Evt pointer is null");
+#if ACT_CFG_RPC == 1
+  // Replies and time outs of requests are matched with the pending request, and dispatched or dropped
+  if (ACT_Rpc_process(me, e))
+  {
+    ACT_mem_refdec(e);
+    return;
+  }
+#endif
 
-    // Timer events are not processed by the AO dispatch function.
-    // Instead the attached event is processed in the context of the
-    // active object that started the timer event
-    if (e->type == ACT_TIMEVT)
-    {
-      ACT_TimEvt *te = EVT_CAST(e, ACT_TimEvt);
-      ACT_TimeEvt_dispatch(te);
-    }
-    // Default: Let AO process event
-    else
+  // Timer events are not processed by the AO dispatch function.
+  // Instead the attached event is processed in the context of the
+  // active object that started the timer event
+  if (e->type == ACT_TIMEVT)
+  {
+    ACT_TimEvt *te = EVT_CAST(e, ACT_TimEvt);
+    ACT_TimeEvt_dispatch(te);
+  }
+#if ACT_CFG_BATCH == 1
+  else if (ACT_Batch_process(me, e))
+  {
+    // Message was gathered with the following queued messages of the same header and passed to its batch handler
+  }
+#endif
+  // Default: Let AO process event
+  else
+  {
+#if ACT_CFG_DEFER == 1
+    ACT_Defer_begin(me, e);
+#endif
+    me->dispatch(me, e);
+#if ACT_CFG_DEFER == 1
+    // A deferred event keeps the reference from posting until it is recalled and processed
+    if (ACT_Defer_end(me))
     {
-      me->dispatch(me, e);
+      return;
     }
-
-    // Decrement reference counter added by ACT_postEvt after event is processed
-    ACT_mem_refdec(e);
+#endif
   }
+
+  // Decrement reference counter added by ACT_postEvt after event is processed
+  ACT_mem_refdec(e);
+}
+
+#if ACT_CFG_RECORDER == 1
+void ACT_threadProcess(Active *const me, ACT_Evt *const e)
+{
+  ACT_EvtType type = e->type;
+
+  ACT_Recorder_add(ACT_REC_DISPATCH, me, e);
+  ACT_threadDispatch(me, e);
+  // Event may be freed by now
+  ACT_Recorder_addType(ACT_REC_DISPATCH_END, me, e, type);
 }
+#endif
 
+#if ACT_CFG_RPC == 1
 int ACT_postEvt(Active const *const receiver, ACT_Evt const *const e)
+{
+  return ACT_postEvtCorr(receiver, e, ACT_CORR_NONE);
+}
+
+int ACT_postEvtCorr(Active const *const receiver, ACT_Evt const *const e, uint16_t corrId)
+#else
+int ACT_postEvt(Active const *const receiver, ACT_Evt const *const e)
+#endif
 {
   ACT_ASSERT(receiver != NULL, "Receiver is null");
   ACT_ASSERT(e != NULL, "ACT_Evt object is null");
   ACT_ASSERT(e->type != ACT_UNUSED, "ACT_Evt object is not initialized");
 
+#if ACT_CFG_RPC == 1
+  // Only written when changed. Requests and replies are asserted dynamic, so static events are never written and can be in ROM
+  if (e->_corrId != corrId)
+  {
+    ((ACT_Evt *)e)->_corrId = corrId;
+  }
+#endif
+
+#if ACT_CFG_SHM == 1
+  if (receiver->_post != NULL)
+  {
+    // Receiver copies the event before returning. Hold a ref so a dynamic event only posted here is freed
+    ACT_mem_refinc(e);
+    int fwdStatus = receiver->_post(receiver, e);
+    ACT_mem_refdec(e);
+    return fwdStatus;
+  }
+#endif
+
   /* Adding a memory ref must be done before putting it on the receiving queue,
   in case receiving object is higher priority than running object
   (which would decrement the ref counter while processingand potentially free it) */
   ACT_mem_refinc(e);
 
-  int status = ACT_Q_PUT(receiver->queue, &e);
+#if ACT_CFG_RECORDER == 1
+  ACT_Recorder_add(ACT_REC_POST, receiver, e);
+#endif
+
+#if ACT_CFG_TRACE == 1
+  // Record while the event is still referenced, the receiver may free it as soon as it is queued
+  ACT_Trace_post(receiver, e);
+#endif
+
+  ACT_QEntry entry = ACT_QENTRY_FROM_EVT(e);
+  int status = ACT_Q_PUT(receiver->queue, &entry);
   ACT_ASSERT(status == ACT_Q_PUT_SUCCESS_STATUS, "Event not put on queue %p. Error: %i\n\n", receiver->queue, status);
 
   // Event was not sent, remove memory ref again
   if (status != ACT_Q_PUT_SUCCESS_STATUS)
   {
+    ACT_QENTRY_RELEASE(entry);
     ACT_mem_refdec(e);
   }
+#if ACT_CFG_BOOST == 1
+  else
+  {
+    ACT_Boost_posted((Active *)receiver);
+  }
+#endif
 
   return status;
 }
 
+void ACT_startAll(void)
+{
+  // All Active objects are initialized before the first start event is processed
+  ACT_ACTOR_FOREACH(def)
+  {
+    ACT_init(def->me, def->dispatch, &def->qd, &def->td);
+  }
+
+  ACT_ACTOR_FOREACH(def)
+  {
+    ACT_start(def->me);
+  }
+}
+
+size_t ACT_getQueueUsed(Active const *const me)
+{
+  return ACT_Q_USED_GET(me->queue);
+}
+
 inline int ACT_postTimEvt(ACT_TimEvt *te)
 {
   // Post time event to AO sender's queue so AO framework can
   // update and post the attached event in the sender's context
-  return ACT_postEvt(te->super._sender, EVT_UPCAST(te));
-}
\ No newline at end of file
+  return ACT_postEvt(ACT_EVT_SENDER(te), EVT_UPCAST(te));
+}
+
+#if ACT_ACTOR_REGISTRY == 1
+
+static Active *actors[ACT_CFG_MAX_ACTORS];
+static atomic_uint numActors;
+
+void ACT_register(Active *const me)
+{
+  unsigned int idx = atomic_fetch_add(&numActors, 1);
+  ACT_ASSERT(idx < ACT_CFG_MAX_ACTORS, "Too many active objects. Increase ACT_CFG_MAX_ACTORS");
+
+  actors[idx] = me;
+  me->_id = (ACT_Handle)(idx + 1);
+}
+
+ACT_Handle ACT_getHandle(Active const *const me)
+{
+  if (me == NULL)
+  {
+    return ACT_HANDLE_NONE;
+  }
+  ACT_ASSERT(me->_id != ACT_HANDLE_NONE && me->_id <= ACT_CFG_MAX_ACTORS, "Active object is not initialized");
+  return me->_id;
+}
+
+Active *ACT_fromHandle(ACT_Handle h)
+{
+  if (h == ACT_HANDLE_NONE)
+  {
+    return NULL;
+  }
+  ACT_ASSERT(h <= ACT_CFG_MAX_ACTORS, "Invalid active object handle");
+  return actors[h - 1];
+}
+
+#endif /* ACT_ACTOR_REGISTRY == 1 */
@@ -22,5 +22,11 @@ void Active_assert(void *pc, void *lr, char *test, char *file, uint32_t line)
       .file = file,
       .line = line};
 
+#if ACT_CFG_RECORDER == 1
+  // Keep the records leading up to the assert while the handler persists them
+  ACT_Recorder_freeze();
+  a.records = ACT_Recorder_get(&a.nextRecord);
+#endif
+
   ACT_ASSERT_FN(&a);
 }
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include <string.h>
+
+#include <active.h>
+
+#if ACT_CFG_BATCH == 1
+
+static ACT_BatchHandler *ACT_Batch_find(Active const *const me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_MESSAGE)
+  {
+    return NULL;
+  }
+
+  uint16_t header = EVT_CAST(e, ACT_Message)->header;
+  for (size_t i = 0; i < me->_batch.numHandlers; i++)
+  {
+    if (me->_batch.handlers[i]->header == header)
+    {
+      return me->_batch.handlers[i];
+    }
+  }
+  return NULL;
+}
+
+/* Copy the value and post time stamp of the message taken last into the batch buffers */
+static void ACT_Batch_add(Active const *const me, ACT_BatchHandler *const h, size_t idx, ACT_Evt const *const e)
+{
+  ACT_Message const *m = EVT_CAST(e, ACT_Message);
+  ACT_ASSERT(m->payloadLen == h->valueSize && m->payload != NULL, "Payload of batched message %u is not one value", m->header);
+
+  memcpy((char *)h->values + idx * h->valueSize, m->payload, h->valueSize);
+#if ACT_CFG_EVT_TIMESTAMP == 1
+  h->timestamps[idx] = me->_postedAt;
+#else
+  ACT_ARG_UNUSED(me);
+#endif
+}
+
+/* Take the next event from the queue without blocking. NULL if the queue is empty */
+static ACT_Evt *ACT_Batch_take(Active *const me)
+{
+  while (ACT_Q_USED_GET(me->queue) > 0)
+  {
+    // NULL if the mailbox dropped a stale event instead
+    ACT_Evt *e = ACT_threadTake(me);
+    if (e != NULL)
+    {
+      return e;
+    }
+  }
+  return NULL;
+}
+
+void ACT_setBatch(Active *const me, ACT_BatchHandler *handler)
+{
+  ACT_ASSERT(me != NULL && handler != NULL && handler->fn != NULL, "Active object or batch handler is NULL");
+  ACT_ASSERT(handler->capacity > 0 && handler->values != NULL, "Batch handler has no buffer");
+
+  ACT_Batches *batch = &me->_batch;
+  ACT_ASSERT(batch->numHandlers < ACT_CFG_BATCH_MAX, "Too many batch handlers, see ACT_CFG_BATCH_MAX");
+  for (size_t i = 0; i < batch->numHandlers; i++)
+  {
+    ACT_ASSERT(batch->handlers[i]->header != handler->header, "Batch handler for header %u already set", handler->header);
+  }
+
+  batch->handlers[batch->numHandlers++] = handler;
+}
+
+bool ACT_Batch_process(Active *const me, ACT_Evt *const e)
+{
+  ACT_BatchHandler *h = ACT_Batch_find(me, e);
+  if (h == NULL)
+  {
+    return false;
+  }
+
+  // The first message is freed by the caller, the gathered ones once copied
+  ACT_Batch_add(me, h, 0, e);
+  size_t len = 1;
+  while (len < h->capacity)
+  {
+    ACT_Evt *next = ACT_Batch_take(me);
+    if (next == NULL)
+    {
+      break;
+    }
+    if (ACT_Batch_find(me, next) != h)
+    {
+      me->_batch.held = next;
+#if ACT_CFG_EVT_TIMESTAMP == 1
+      me->_batch.heldPostedAt = me->_postedAt;
+#endif
+      break;
+    }
+
+    ACT_Batch_add(me, h, len++, next);
+    ACT_mem_refdec(next);
+  }
+
+  ACT_BatchSpan span = {.len = len, .values = h->values, .timestamps = h->timestamps};
+  h->fn(me, h->header, &span);
+  return true;
+}
+
+ACT_Evt *ACT_Batch_next(Active *const me)
+{
+  ACT_Evt *e = me->_batch.held;
+  me->_batch.held = NULL;
+#if ACT_CFG_EVT_TIMESTAMP == 1
+  if (e != NULL)
+  {
+    me->_postedAt = me->_batch.heldPostedAt;
+  }
+#endif
+  return e;
+}
+
+#endif /* ACT_CFG_BATCH == 1 */
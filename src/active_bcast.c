@@ -0,0 +1,108 @@
+#include <active.h>
+
+static inline char *ACT_Bcast_slot(ACT_Bcast const *const b, uint32_t seq)
+{
+  return b->buf + ((seq & (b->numSlots - 1)) * b->elemSize);
+}
+
+void ACT_Bcast_init(ACT_Bcast *b, Active const *producer, void *buf, size_t elemSize, uint32_t numSlots, ACT_BcastSub *subs, size_t maxSubs)
+{
+  ACT_ASSERT(b != NULL, "Broadcast channel is NULL");
+  ACT_ASSERT(producer != NULL, "Broadcast producer is NULL");
+  ACT_ASSERT(buf != NULL && subs != NULL, "Broadcast buffers are NULL");
+  ACT_ASSERT(numSlots != 0 && (numSlots & (numSlots - 1)) == 0, "Broadcast ring size must be a power of 2");
+
+  b->buf = (char *)buf;
+  b->elemSize = elemSize;
+  b->numSlots = numSlots;
+  atomic_init(&b->seq, 0);
+  b->gate = 0;
+  b->subs = subs;
+  b->maxSubs = maxSubs;
+  b->numSubs = 0;
+  b->producer = producer;
+  b->overruns = 0;
+}
+
+ACT_BcastSub *ACT_Bcast_subscribe(ACT_Bcast *b, Active const *receiver, uint16_t wakeSig)
+{
+  ACT_ASSERT(b->numSubs < b->maxSubs, "Too many broadcast subscribers");
+
+  ACT_BcastSub *sub = &b->subs[b->numSubs];
+  sub->bcast = b;
+  sub->receiver = receiver;
+  atomic_init(&sub->cursor, atomic_load(&b->seq));
+  atomic_init(&sub->notified, false);
+  ACT_Signal_init(&sub->wakeSig, b->producer, wakeSig);
+
+  b->numSubs++;
+  return sub;
+}
+
+void *ACT_Bcast_claim(ACT_Bcast *b)
+{
+  uint32_t seq = atomic_load_explicit(&b->seq, memory_order_relaxed);
+
+  // Only scan subscribers when the cached slowest cursor blocks the slot
+  if (seq - b->gate >= b->numSlots)
+  {
+    uint32_t maxLag = 0;
+    for (size_t i = 0; i < b->numSubs; i++)
+    {
+      uint32_t cursor = atomic_load_explicit(&b->subs[i].cursor, memory_order_acquire);
+      if (seq - cursor > maxLag)
+      {
+        maxLag = seq - cursor;
+      }
+    }
+    b->gate = seq - maxLag;
+
+    if (maxLag >= b->numSlots)
+    {
+      b->overruns++;
+      return NULL;
+    }
+  }
+
+  return ACT_Bcast_slot(b, seq);
+}
+
+void ACT_Bcast_publish(ACT_Bcast *b)
+{
+  atomic_fetch_add(&b->seq, 1);
+
+  // Wake subscribers that have caught up. Others will read the element before going idle
+  for (size_t i = 0; i < b->numSubs; i++)
+  {
+    ACT_BcastSub *sub = &b->subs[i];
+    if (!atomic_exchange(&sub->notified, true))
+    {
+      ACT_postEvt(sub->receiver, EVT_UPCAST(&sub->wakeSig));
+    }
+  }
+}
+
+const void *ACT_Bcast_read(ACT_BcastSub *sub)
+{
+  ACT_Bcast *b = sub->bcast;
+  uint32_t cursor = atomic_load_explicit(&sub->cursor, memory_order_relaxed);
+
+  if (cursor == atomic_load_explicit(&b->seq, memory_order_acquire))
+  {
+    // Caught up. Clear flag before checking again, so an element published in between either
+    // is seen here or makes the producer post a new wake signal
+    atomic_store(&sub->notified, false);
+
+    if (cursor == atomic_load(&b->seq))
+    {
+      return NULL;
+    }
+  }
+
+  return ACT_Bcast_slot(b, cursor);
+}
+
+void ACT_Bcast_release(ACT_BcastSub *sub)
+{
+  atomic_fetch_add_explicit(&sub->cursor, 1, memory_order_release);
+}
@@ -0,0 +1,120 @@
+#include <active.h>
+
+#if ACT_CFG_BOOST == 1
+
+/* Set the thread priority after changing the boost flag. Not done under a lock, so a raised thread can preempt the caller
+right away. If a raise and a restore race, the priority set last is checked against the flag and set again until they match */
+static void ACT_Boost_setPri(Active *const me, bool boosted)
+{
+  ACT_Boost *boost = &me->_boost;
+  bool set;
+  do
+  {
+    set = boosted;
+    ACT_THREAD_PRI_SET(me->thread, set ? boost->policy->pri : boost->basePri);
+    boosted = atomic_load(&boost->boosted);
+  } while (boosted != set);
+}
+
+static void ACT_Boost_raise(Active *const me)
+{
+  ACT_Boost *boost = &me->_boost;
+  bool boosted = false;
+  if (!atomic_compare_exchange_strong(&boost->boosted, &boosted, true))
+  {
+    return;
+  }
+  ACT_Boost_setPri(me, true);
+
+  atomic_fetch_add_explicit(&boost->numBoosts, 1, memory_order_relaxed);
+
+  if (boost->policy->observer != NULL)
+  {
+    ACT_postEvt(boost->policy->observer, EVT_UPCAST(&boost->highEvt));
+  }
+}
+
+void ACT_setBoost(Active *const me, ACT_BoostPolicy const *policy)
+{
+  ACT_ASSERT(me != NULL, "Active object is NULL");
+  ACT_ASSERT(policy == NULL || policy->lowDepth < policy->highDepth || policy->highDepth == 0,
+             "Low watermark must be below high watermark");
+#if ACT_CFG_EVT_TIMESTAMP != 1
+  ACT_ASSERT(policy == NULL || policy->maxAgeUs == 0, "Boosting on event age requires ACT_CFG_EVT_TIMESTAMP");
+#endif
+
+  ACT_Boost *boost = &me->_boost;
+  if (policy != NULL && policy->observer != NULL)
+  {
+    ACT_Signal_init(&boost->highEvt, me, policy->highSig);
+    ACT_Signal_init(&boost->lowEvt, me, policy->lowSig);
+  }
+  atomic_init(&boost->numBoosts, 0);
+  boost->policy = policy;
+}
+
+bool ACT_isBoosted(Active const *const me)
+{
+  return atomic_load((atomic_bool *)&me->_boost.boosted);
+}
+
+uint32_t ACT_getBoosts(Active const *const me)
+{
+  return atomic_load_explicit((atomic_uint *)&me->_boost.numBoosts, memory_order_relaxed);
+}
+
+void ACT_Boost_posted(Active *const receiver)
+{
+  ACT_BoostPolicy const *policy = receiver->_boost.policy;
+  if (policy == NULL || policy->highDepth == 0 || atomic_load_explicit(&receiver->_boost.boosted, memory_order_relaxed))
+  {
+    return;
+  }
+
+  if (ACT_Q_USED_GET(receiver->queue) >= policy->highDepth)
+  {
+    ACT_Boost_raise(receiver);
+  }
+}
+
+void ACT_Boost_process(Active *const me)
+{
+  ACT_Boost *boost = &me->_boost;
+  ACT_BoostPolicy const *policy = boost->policy;
+  if (policy == NULL)
+  {
+    return;
+  }
+
+  if (!atomic_load_explicit(&boost->boosted, memory_order_relaxed))
+  {
+#if ACT_CFG_EVT_TIMESTAMP == 1
+    uint32_t age = ACT_CYCLES_GET() - me->_postedAt;
+    if (policy->maxAgeUs != 0 && ACT_CYCLES_TO_NS(age) > (uint64_t)policy->maxAgeUs * 1000u)
+    {
+      ACT_Boost_raise(me);
+    }
+#endif
+    return;
+  }
+
+  // Restore while the event taken is processed, so the low watermark counts the events still waiting
+  if (ACT_Q_USED_GET(me->queue) > policy->lowDepth)
+  {
+    return;
+  }
+
+  bool boosted = true;
+  if (!atomic_compare_exchange_strong(&boost->boosted, &boosted, false))
+  {
+    return;
+  }
+  ACT_Boost_setPri(me, false);
+
+  if (policy->observer != NULL)
+  {
+    ACT_postEvt(policy->observer, EVT_UPCAST(&boost->lowEvt));
+  }
+}
+
+#endif /* ACT_CFG_BOOST == 1 */
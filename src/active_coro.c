@@ -0,0 +1,130 @@
+#include <string.h>
+
+#include <active.h>
+
+/* Copied to each coroutine, as ACT_Signal_init does not take reserved signals */
+static const ACT_SIGNAL_DEFINE(expiredSignal, ACT_TIMEOUT_SIG);
+
+static bool ACT_Coro_isAwaited(ACT_Coro const *co, ACT_Evt const *const e)
+{
+  if (e->type == ACT_SIGNAL)
+  {
+    uint16_t sig = EVT_CAST(e, ACT_Signal)->sig;
+    // Timeouts of other coroutines are never awaited
+    return sig == co->_sig && sig != ACT_TIMEOUT_SIG;
+  }
+  if (e->type == ACT_MESSAGE)
+  {
+    return EVT_CAST(e, ACT_Message)->header == co->_sig;
+  }
+  return false;
+}
+
+static void ACT_Coro_cancelTimeout(ACT_Coro *co)
+{
+  if (!co->_timing)
+  {
+    return;
+  }
+  co->_timing = false;
+
+  // Already expired, also while being stopped: the timeout is on its way to the host and is dropped when dispatched
+  if (!(ACT_TimeEvt_stop(&co->_timeout) && co->_timeout.timer.sync))
+  {
+    ACT_ASSERT(co->_stale < UINT8_MAX, "Too many expired timeouts of coroutine %p", (void *)co);
+    co->_stale++;
+  }
+}
+
+void ACT_Coro_init(ACT_Coro *co, Active *host, ACT_CoroFn fn)
+{
+  ACT_ASSERT(co != NULL && host != NULL && fn != NULL, "Coroutine, host or body is NULL");
+
+  co->fn = fn;
+  co->host = host;
+  co->_line = ACT_CORO_DONE;
+  co->_sig = ACT_TIMEOUT_SIG;
+  co->_timing = false;
+  co->_stale = 0;
+  memcpy(&co->_expired, &expiredSignal, sizeof(co->_expired));
+  EVT_UPCAST(&co->_expired)->_sender = ACT_SENDER_REF(host);
+  ACT_TimEvt_init(&co->_timeout, host, EVT_UPCAST(&co->_expired), host, NULL);
+}
+
+void ACT_Coro_start(ACT_Coro *co, ACT_Evt const *const e)
+{
+  ACT_ASSERT(co->_line == ACT_CORO_DONE, "Coroutine %p is running", (void *)co);
+
+  co->_line = 0;
+  co->fn(co, e);
+}
+
+bool ACT_Coro_dispatch(ACT_Coro *co, ACT_Evt const *const e)
+{
+  if (e == EVT_UPCAST(&co->_expired))
+  {
+    if (co->_stale > 0)
+    {
+      co->_stale--;
+      return true;
+    }
+    co->_timing = false;
+    co->fn(co, NULL);
+    return true;
+  }
+
+  if (co->_line == ACT_CORO_DONE || !ACT_Coro_isAwaited(co, e))
+  {
+    return false;
+  }
+
+  ACT_Coro_cancelTimeout(co);
+  co->fn(co, e);
+  return true;
+}
+
+void ACT_Coro_stop(ACT_Coro *co)
+{
+  ACT_Coro_cancelTimeout(co);
+  co->_line = ACT_CORO_DONE;
+}
+
+bool ACT_Coro_isRunning(ACT_Coro const *co)
+{
+  return co->_line != ACT_CORO_DONE;
+}
+
+void ACT_Coro_await(ACT_Coro *co, uint16_t sig, size_t timeoutMs, int line)
+{
+  ACT_ASSERT(line > 0 && line < ACT_CORO_DONE, "Await on source line %i can not be a resume point", line);
+  ACT_ASSERT(sig != ACT_TIMEOUT_SIG, "ACT_TIMEOUT_SIG is reserved for coroutine timeouts");
+
+  co->_line = (uint16_t)line;
+  co->_sig = sig;
+  if (timeoutMs > 0)
+  {
+    co->_timing = true;
+    ACT_TimeEvt_start(&co->_timeout, timeoutMs, 0);
+  }
+}
+
+void ACT_CoroActive_init(ACT_CoroActive *me, ACT_CoroFn fn, ACT_QueueData const *qd, ACT_ThreadData const *td)
+{
+  ACT_init(&me->super, ACT_CoroActive_dispatch, qd, td);
+  ACT_Coro_init(&me->coro, &me->super, fn);
+}
+
+void ACT_CoroActive_dispatch(Active *me, ACT_Evt const *const e)
+{
+  ACT_CoroActive *coroActive = (ACT_CoroActive *)me;
+
+  if (ACT_Coro_dispatch(&coroActive->coro, e))
+  {
+    return;
+  }
+
+  if (e->type == ACT_SIGNAL && EVT_CAST(e, ACT_Signal)->sig == ACT_START_SIG && !ACT_Coro_isRunning(&coroActive->coro))
+  {
+    ACT_Coro_start(&coroActive->coro, e);
+  }
+}
@@ -0,0 +1,75 @@
+#include <active.h>
+
+#if ACT_CFG_DEFER == 1
+
+_Static_assert(ACT_CFG_DEFER_MAX >= 1 && ACT_CFG_DEFER_MAX <= 255, "ACT_CFG_DEFER_MAX must be 1 to 255");
+
+int ACT_defer(Active *const me, ACT_Evt const *const e)
+{
+  ACT_ASSERT(me != NULL, "Active object is null");
+  ACT_DeferQueue *dq = &me->_defer;
+
+  ACT_ASSERT(e != NULL && e == dq->current, "Only the event being processed can be deferred");
+  ACT_ASSERT(!dq->kept, "Event is already deferred");
+
+  if (dq->used == ACT_CFG_DEFER_MAX)
+  {
+    return ACT_DEFER_ERR_FULL;
+  }
+
+  dq->evts[(dq->head + dq->used) % ACT_CFG_DEFER_MAX] = e;
+  dq->used++;
+  dq->kept = true;
+
+  return ACT_DEFER_OK;
+}
+
+bool ACT_recall(Active *const me)
+{
+  ACT_ASSERT(me != NULL, "Active object is null");
+  ACT_DeferQueue *dq = &me->_defer;
+
+  if (dq->recalled == dq->used)
+  {
+    return false;
+  }
+
+  dq->recalled++;
+  return true;
+}
+
+size_t ACT_getDeferred(Active const *const me)
+{
+  return me->_defer.used - me->_defer.recalled;
+}
+
+ACT_Evt *ACT_Defer_next(Active *const me)
+{
+  ACT_DeferQueue *dq = &me->_defer;
+
+  if (dq->recalled == 0)
+  {
+    return NULL;
+  }
+
+  ACT_Evt const *e = dq->evts[dq->head];
+  dq->head = (uint8_t)((dq->head + 1u) % ACT_CFG_DEFER_MAX);
+  dq->used--;
+  dq->recalled--;
+
+  return (ACT_Evt *)e;
+}
+
+void ACT_Defer_begin(Active *const me, ACT_Evt const *const e)
+{
+  me->_defer.current = e;
+  me->_defer.kept = false;
+}
+
+bool ACT_Defer_end(Active *const me)
+{
+  me->_defer.current = NULL;
+  return me->_defer.kept;
+}
+
+#endif /* ACT_CFG_DEFER == 1 */
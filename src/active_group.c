@@ -0,0 +1,110 @@
+#include <active.h>
+
+void ACT_Group_init(ACT_Group *g, Active *const *members, size_t numMembers, ACT_DispatchFn dispatch,
+                    ACT_QueueData const *qd, ACT_ThreadData const *td)
+{
+  ACT_ASSERT(g != NULL, "Group is NULL");
+  ACT_ASSERT(members != NULL && numMembers > 0, "Group has no members");
+
+  g->members = members;
+  g->numMembers = numMembers;
+  g->qd = qd;
+  atomic_init(&g->next, 0);
+  atomic_init(&g->posted, 0);
+  atomic_init(&g->failed, 0);
+  atomic_init(&g->maxDepth, 0);
+
+  for (size_t i = 0; i < numMembers; i++)
+  {
+    ACT_init(members[i], dispatch, &qd[i], &td[i]);
+  }
+}
+
+void ACT_Group_start(ACT_Group *g)
+{
+  for (size_t i = 0; i < g->numMembers; i++)
+  {
+    ACT_start(g->members[i]);
+  }
+}
+
+static int ACT_Group_postMember(ACT_Group *g, size_t member, size_t depth, ACT_Evt const *const e)
+{
+  unsigned int maxDepth = atomic_load_explicit(&g->maxDepth, memory_order_relaxed);
+  while (depth > maxDepth &&
+         !atomic_compare_exchange_weak_explicit(&g->maxDepth, &maxDepth, depth, memory_order_relaxed, memory_order_relaxed))
+  {
+  }
+
+  atomic_fetch_add_explicit(&g->posted, 1, memory_order_relaxed);
+
+  // Rejected before posting, as ACT_postEvt asserts that the event is put on the queue
+  if (depth >= g->qd[member].maxMsg)
+  {
+    atomic_fetch_add_explicit(&g->failed, 1, memory_order_relaxed);
+    // Free a dynamic event only posted here
+    ACT_mem_refinc(e);
+    ACT_mem_refdec(e);
+    return ACT_GROUP_ERR_FULL;
+  }
+
+  int status = ACT_postEvt(g->members[member], e);
+  if (status != ACT_Q_PUT_SUCCESS_STATUS)
+  {
+    atomic_fetch_add_explicit(&g->failed, 1, memory_order_relaxed);
+  }
+  return status;
+}
+
+int ACT_postGroup(ACT_Group *g, ACT_Evt const *const e)
+{
+  ACT_ASSERT(g != NULL, "Group is NULL");
+
+  // Rotate start of search so members with equal queue depth share the load
+  size_t start = atomic_fetch_add_explicit(&g->next, 1, memory_order_relaxed) % g->numMembers;
+  size_t best = start;
+  size_t bestDepth = ACT_getQueueUsed(g->members[start]);
+
+  for (size_t i = 1; i < g->numMembers && bestDepth > 0; i++)
+  {
+    size_t member = (start + i) % g->numMembers;
+    size_t depth = ACT_getQueueUsed(g->members[member]);
+    if (depth < bestDepth)
+    {
+      best = member;
+      bestDepth = depth;
+    }
+  }
+
+  return ACT_Group_postMember(g, best, bestDepth, e);
+}
+
+int ACT_postGroupKey(ACT_Group *g, ACT_Evt const *const e, uint32_t key)
+{
+  ACT_ASSERT(g != NULL, "Group is NULL");
+
+  // Multiplicative hash to spread sequential keys
+  size_t member = (size_t)((key * 2654435761u) >> 16) % g->numMembers;
+
+  return ACT_Group_postMember(g, member, ACT_getQueueUsed(g->members[member]), e);
+}
+
+ACT_GroupStats ACT_Group_getStats(ACT_Group *g)
+{
+  ACT_GroupStats stats = {
+      .posted = atomic_load_explicit(&g->posted, memory_order_relaxed),
+      .failed = atomic_load_explicit(&g->failed, memory_order_relaxed),
+      .maxDepth = atomic_load_explicit(&g->maxDepth, memory_order_relaxed)};
+
+  return stats;
+}
+
+size_t ACT_Group_getQueueUsed(ACT_Group *g)
+{
+  size_t used = 0;
+  for (size_t i = 0; i < g->numMembers; i++)
+  {
+    used += ACT_getQueueUsed(g->members[i]);
+  }
+  return used;
+}
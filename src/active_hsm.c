@@ -0,0 +1,143 @@
+#include <active.h>
+
+ACT_HsmState ACT_Hsm_unhandled;
+
+static void ACT_Hsm_precompute(ACT_HsmState *s)
+{
+  size_t depth = 0;
+  for (ACT_HsmState *p = s->parent; p != NULL; p = p->parent)
+  {
+    depth++;
+    ACT_ASSERT(depth < ACT_CFG_HSM_MAX_DEPTH, "State nesting deeper than ACT_CFG_HSM_MAX_DEPTH");
+  }
+
+  s->_depth = (uint8_t)depth;
+  ACT_HsmState *p = s;
+  for (size_t d = depth + 1; d-- > 0; p = p->parent)
+  {
+    s->_path[d] = p;
+  }
+
+  ACT_HsmState *leaf = s;
+  while (leaf->initial != NULL)
+  {
+    ACT_ASSERT(leaf->initial->parent == leaf, "Initial state is not a substate");
+    leaf = leaf->initial;
+  }
+  s->_leaf = leaf;
+}
+
+void ACT_Hsm_init(ACT_Hsm *me, ACT_HsmState *const *states, size_t numStates, ACT_HsmState *initial,
+                  ACT_QueueData const *qd, ACT_ThreadData const *td)
+{
+  ACT_ASSERT(me != NULL, "State machine is NULL");
+  ACT_ASSERT(states != NULL && numStates > 0, "State machine has no states");
+  ACT_ASSERT(initial != NULL, "State machine has no initial state");
+
+  for (size_t i = 0; i < numStates; i++)
+  {
+    ACT_Hsm_precompute(states[i]);
+  }
+  ACT_ASSERT(initial->_leaf != NULL, "Initial state is not in states");
+
+  me->state = NULL;
+  me->initial = initial;
+
+  ACT_init(&me->super, ACT_Hsm_dispatch, qd, td);
+}
+
+/* Enter states on the path of a leaf below depth, and make the leaf the current state */
+static void ACT_Hsm_enter(ACT_Hsm *me, int depth, ACT_HsmState *leaf)
+{
+  for (int d = depth + 1; d <= leaf->_depth; d++)
+  {
+    ACT_HsmState *s = leaf->_path[d];
+    if (s->entry != NULL)
+    {
+      s->entry(&me->super);
+    }
+  }
+  me->state = leaf;
+}
+
+static void ACT_Hsm_transition(ACT_Hsm *me, ACT_HsmState const *source, ACT_HsmState *target)
+{
+  ACT_ASSERT(target->_leaf != NULL, "Target state is not in states");
+
+  // Depth of least common ancestor of source and target, -1 if they have different top level states
+  int lca = -1;
+  int maxLca = source->_depth < target->_depth ? source->_depth : target->_depth;
+  while (lca < maxLca && source->_path[lca + 1] == target->_path[lca + 1])
+  {
+    lca++;
+  }
+
+  // Target is the source or one of its superstates: exit and re-enter it
+  if (lca == target->_depth)
+  {
+    lca--;
+  }
+
+  ACT_HsmState const *current = me->state;
+  for (int d = current->_depth; d > lca; d--)
+  {
+    ACT_HsmState *s = current->_path[d];
+    if (s->exit != NULL)
+    {
+      s->exit(&me->super);
+    }
+  }
+
+  ACT_Hsm_enter(me, lca, target->_leaf);
+}
+
+void ACT_Hsm_dispatch(Active *me, ACT_Evt const *const e)
+{
+  ACT_Hsm *hsm = (ACT_Hsm *)me;
+  uint16_t key;
+
+  if (e->type == ACT_SIGNAL)
+  {
+    key = EVT_CAST(e, ACT_Signal)->sig;
+    if (key == ACT_START_SIG && hsm->state == NULL)
+    {
+      ACT_Hsm_enter(hsm, -1, hsm->initial->_leaf);
+      return;
+    }
+  }
+  else if (e->type == ACT_MESSAGE)
+  {
+    key = EVT_CAST(e, ACT_Message)->header;
+  }
+  else
+  {
+    return;
+  }
+
+  ACT_ASSERT(hsm->state != NULL, "State machine is not started");
+
+  for (ACT_HsmState *s = hsm->state; s != NULL; s = s->parent)
+  {
+    if (key >= s->numHandlers || s->handlers[key] == NULL)
+    {
+      continue;
+    }
+
+    ACT_HsmState *target = s->handlers[key](me, e);
+    if (target == ACT_HSM_UNHANDLED)
+    {
+      continue;
+    }
+    if (target != ACT_HSM_HANDLED)
+    {
+      ACT_Hsm_transition(hsm, s, target);
+    }
+    return;
+  }
+}
+
+bool ACT_Hsm_isIn(ACT_Hsm const *me, ACT_HsmState const *state)
+{
+  ACT_HsmState const *current = me->state;
+  return current != NULL && current->_depth >= state->_depth && current->_path[state->_depth] == state;
+}
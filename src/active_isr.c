@@ -0,0 +1,90 @@
+#include <active.h>
+
+#if ACT_CFG_ISR_POST == 1
+
+_Static_assert(ACT_CFG_ISR_MAX_SOURCES >= 1 && ACT_CFG_ISR_MAX_SOURCES <= 32, "ACT_CFG_ISR_MAX_SOURCES must be 1 to 32");
+
+ACT_SIGNAL_DEFINE(ACT_Isr_doorbell, ACT_START_SIG);
+
+// Queue entry of the doorbell, made in thread context so ISRs do not look up its handle. Never released
+static ACT_QEntry doorbellEntry;
+
+void ACT_IsrSource_init(ACT_IsrSource *src, Active *receiver, ACT_Evt const *e)
+{
+  ACT_ASSERT(src != NULL && receiver != NULL, "Interrupt source or receiver is null");
+  ACT_ASSERT(e != NULL && !e->_dynamic, "Event of interrupt source must be static");
+
+  ACT_IsrSources *isr = &receiver->_isr;
+  ACT_ASSERT(isr->numSources < ACT_CFG_ISR_MAX_SOURCES, "Too many interrupt sources, see ACT_CFG_ISR_MAX_SOURCES");
+
+  doorbellEntry = ACT_QENTRY_FROM_EVT(EVT_UPCAST(&ACT_Isr_doorbell));
+
+  src->receiver = receiver;
+  src->e = e;
+  src->bit = 1u << isr->numSources;
+  atomic_init(&src->overflow, 0);
+
+  isr->sources[isr->numSources++] = src;
+}
+
+int ACT_postFromISR(ACT_IsrSource *src)
+{
+  atomic_uint *pending = &src->receiver->_isr.pending;
+
+  // Only this source sets its bit, so a set bit can not be cleared in between
+  if (atomic_load_explicit(pending, memory_order_relaxed) & src->bit)
+  {
+    atomic_fetch_add_explicit(&src->overflow, 1, memory_order_relaxed);
+    return ACT_ISR_ERR_OVERFLOW;
+  }
+
+  // Wake the receiver if no other source is pending. Otherwise a doorbell is queued already
+  if (atomic_fetch_or(pending, src->bit) == 0)
+  {
+    ACT_QEntry entry = doorbellEntry;
+    ACT_QENTRY_RETAIN(entry);
+#if ACT_CFG_EVT_TIMESTAMP == 1
+    entry.postedAt = ACT_CYCLES_GET();
+#endif
+    int status = ACT_Q_PUT(src->receiver->queue, &entry);
+    ACT_ASSERT(status == ACT_Q_PUT_SUCCESS_STATUS, "Doorbell not put on queue %p. Error: %i", src->receiver->queue, status);
+    ACT_ARG_UNUSED(status);
+  }
+
+  return ACT_ISR_OK;
+}
+
+bool ACT_IsrSource_isFree(ACT_IsrSource const *src)
+{
+  return (atomic_load((atomic_uint *)&src->receiver->_isr.pending) & src->bit) == 0;
+}
+
+uint32_t ACT_IsrSource_getOverflow(ACT_IsrSource const *src)
+{
+  return atomic_load((atomic_uint *)&src->overflow);
+}
+
+void ACT_Isr_process(Active *const me)
+{
+  ACT_IsrSources *isr = &me->_isr;
+  unsigned int pending = atomic_load(&isr->pending);
+
+  // Each pending source is dispatched once per round, so a busy source does not starve the others
+  while (pending != 0)
+  {
+    unsigned int round = pending;
+    while (round != 0)
+    {
+      unsigned int idx = (unsigned int)__builtin_ctz(round);
+      round &= round - 1u;
+
+      ACT_IsrSource *src = isr->sources[idx];
+      me->dispatch(me, src->e);
+
+      // Free the slot. If no source is left pending, the next post queues a new doorbell
+      pending = atomic_fetch_and(&isr->pending, ~src->bit) & ~src->bit;
+    }
+  }
+}
+
+#endif /* ACT_CFG_ISR_POST == 1 */
@@ -0,0 +1,240 @@
+#include <active.h>
+
+#if ACT_CFG_MAILBOX == ACT_MAILBOX_LINKED
+
+static ACT_MEMPOOL_DEFINE(QNode_Mem, ACT_MboxNode, ACT_MEM_NUM_QNODES);
+
+/* @private - used by Active framework tests */
+uint32_t ACT_mem_QNode_getUsed()
+{
+  return ACT_MEMPOOL_USED_GET(&QNode_Mem);
+}
+
+void ACT_Mbox_init(ACT_Mbox *mb, size_t cap)
+{
+  ACT_ASSERT(mb != NULL, "Mailbox is NULL");
+
+  atomic_init(&mb->inbox, NULL);
+  mb->head = NULL;
+  atomic_init(&mb->used, 0);
+  mb->cap = cap;
+  ACT_SEM_INIT(&mb->sem);
+}
+
+int ACT_Mbox_put(ACT_Mbox *mb, ACT_QEntry const *entry)
+{
+  // Reserve room in mailbox before taking a node from the shared pool
+  unsigned int used = atomic_load_explicit(&mb->used, memory_order_relaxed);
+  do
+  {
+    if (mb->cap != 0 && used >= mb->cap)
+    {
+      return ACT_MBOX_ERR_FULL;
+    }
+  } while (!atomic_compare_exchange_weak_explicit(&mb->used, &used, used + 1, memory_order_relaxed, memory_order_relaxed));
+
+  ACT_MboxNode *n = NULL;
+  int status = ACT_MEMPOOL_ALLOC(&QNode_Mem, &n);
+  if (status != ACT_MEMPOOL_ALLOC_SUCCESS_STATUS)
+  {
+    atomic_fetch_sub_explicit(&mb->used, 1, memory_order_relaxed);
+    return ACT_MBOX_ERR_NOMEM;
+  }
+
+  n->entry = *entry;
+
+  // Push node on inbox stack
+  n->next = atomic_load_explicit(&mb->inbox, memory_order_relaxed);
+  while (!atomic_compare_exchange_weak_explicit(&mb->inbox, &n->next, n, memory_order_release, memory_order_relaxed))
+  {
+  }
+
+  // Wake receiver only once node is reachable
+  ACT_SEM_GIVE(&mb->sem);
+
+  return 0;
+}
+
+int ACT_Mbox_get(ACT_Mbox *mb, ACT_QEntry *entry)
+{
+  ACT_SEM_TAKE(&mb->sem);
+
+  if (mb->head == NULL)
+  {
+    // Take all posted nodes at once. Exchange instead of pop avoids ABA on the inbox stack
+    ACT_MboxNode *n = atomic_exchange_explicit(&mb->inbox, NULL, memory_order_acquire);
+
+    // Reverse into FIFO order
+    while (n != NULL)
+    {
+      ACT_MboxNode *next = n->next;
+      n->next = mb->head;
+      mb->head = n;
+      n = next;
+    }
+  }
+
+  ACT_MboxNode *n = mb->head;
+  ACT_ASSERT(n != NULL, "Mailbox signalled without queued entries");
+
+  mb->head = n->next;
+  *entry = n->entry;
+
+  ACT_MEMPOOL_FREE(&QNode_Mem, &n);
+  atomic_fetch_sub_explicit(&mb->used, 1, memory_order_relaxed);
+
+  return 0;
+}
+
+size_t ACT_Mbox_getUsed(ACT_Mbox *mb)
+{
+  return atomic_load_explicit(&mb->used, memory_order_relaxed);
+}
+
+#endif /* ACT_CFG_MAILBOX == ACT_MAILBOX_LINKED */
+
+#if ACT_CFG_MAILBOX == ACT_MAILBOX_EDF
+
+/* True if entry a is dequeued before b. Times and sequence numbers wrap, compare by signed difference */
+static bool ACT_EdfMbox_before(ACT_EdfEntry const *a, ACT_EdfEntry const *b)
+{
+  if (a->hasDeadline != b->hasDeadline)
+  {
+    return a->hasDeadline;
+  }
+  if (a->hasDeadline && a->dueUs != b->dueUs)
+  {
+    return (int32_t)(a->dueUs - b->dueUs) < 0;
+  }
+  return (int32_t)(a->seq - b->seq) < 0;
+}
+
+void ACT_EdfMbox_init(ACT_EdfMbox *mb, char *buf, size_t cap)
+{
+  ACT_ASSERT(mb != NULL && buf != NULL, "Mailbox or buffer is NULL");
+  ACT_ASSERT(cap > 0, "Mailbox capacity is 0");
+
+  mb->heap = (ACT_EdfEntry *)buf;
+  mb->cap = cap;
+  mb->used = 0;
+  mb->seq = 0;
+  atomic_init(&mb->stale, 0);
+  mb->staleFn = NULL;
+  ACT_LOCK_INIT(&mb->lock);
+  ACT_SEM_INIT(&mb->sem);
+}
+
+int ACT_EdfMbox_put(ACT_EdfMbox *mb, ACT_QEntry const *entry)
+{
+  ACT_Evt const *e = ACT_QENTRY_TO_EVT(*entry);
+  ACT_EdfEntry n = {.hasDeadline = e->_deadlineUs != 0, .entry = *entry};
+  if (n.hasDeadline)
+  {
+    n.dueUs = (uint32_t)ACT_TIMEUS_GET() + e->_deadlineUs;
+  }
+
+  ACT_LOCK_KEY key = ACT_LOCK_TAKE(&mb->lock);
+
+  if (mb->used == mb->cap)
+  {
+    ACT_LOCK_GIVE(&mb->lock, key);
+    return ACT_MBOX_ERR_FULL;
+  }
+  n.seq = mb->seq++;
+
+  // Sift up from the new leaf
+  size_t i = mb->used++;
+  while (i > 0)
+  {
+    size_t parent = (i - 1) / 2;
+    if (!ACT_EdfMbox_before(&n, &mb->heap[parent]))
+    {
+      break;
+    }
+    mb->heap[i] = mb->heap[parent];
+    i = parent;
+  }
+  mb->heap[i] = n;
+
+  ACT_LOCK_GIVE(&mb->lock, key);
+
+  ACT_SEM_GIVE(&mb->sem);
+  return 0;
+}
+
+/* Remove the first entry of a non-empty heap. Lock must be held */
+static ACT_EdfEntry ACT_EdfMbox_pop(ACT_EdfMbox *mb)
+{
+  ACT_EdfEntry top = mb->heap[0];
+  ACT_EdfEntry last = mb->heap[--mb->used];
+
+  // Sift the last leaf down from the root
+  size_t i = 0;
+  while (1)
+  {
+    size_t child = 2 * i + 1;
+    if (child >= mb->used)
+    {
+      break;
+    }
+    if (child + 1 < mb->used && ACT_EdfMbox_before(&mb->heap[child + 1], &mb->heap[child]))
+    {
+      child++;
+    }
+    if (!ACT_EdfMbox_before(&mb->heap[child], &last))
+    {
+      break;
+    }
+    mb->heap[i] = mb->heap[child];
+    i = child;
+  }
+  mb->heap[i] = last;
+
+  return top;
+}
+
+int ACT_EdfMbox_get(ACT_EdfMbox *mb, ACT_QEntry *entry)
+{
+  ACT_SEM_TAKE(&mb->sem);
+
+  ACT_LOCK_KEY key = ACT_LOCK_TAKE(&mb->lock);
+  ACT_ASSERT(mb->used > 0, "Mailbox signalled without queued entries");
+  ACT_EdfEntry n = ACT_EdfMbox_pop(mb);
+  ACT_LOCK_GIVE(&mb->lock, key);
+
+  int32_t lateUs = (int32_t)((uint32_t)ACT_TIMEUS_GET() - n.dueUs);
+  if (!n.hasDeadline || lateUs <= 0)
+  {
+    *entry = n.entry;
+    return 0;
+  }
+
+  // Stale. Drop the reference added when posted
+  ACT_Evt const *e = ACT_QENTRY_TO_EVT(n.entry);
+  ACT_QENTRY_RELEASE(n.entry);
+  atomic_fetch_add_explicit(&mb->stale, 1, memory_order_relaxed);
+  if (mb->staleFn != NULL)
+  {
+    mb->staleFn(e, (uint32_t)lateUs);
+  }
+  ACT_mem_refdec(e);
+
+  return ACT_MBOX_STALE;
+}
+
+size_t ACT_EdfMbox_getUsed(ACT_EdfMbox *mb)
+{
+  return mb->used;
+}
+
+void ACT_EdfMbox_setStaleFn(ACT_EdfMbox *mb, ACT_StaleFn fn)
+{
+  mb->staleFn = fn;
+}
+
+uint32_t ACT_EdfMbox_getStale(ACT_EdfMbox *mb)
+{
+  return atomic_load_explicit(&mb->stale, memory_order_relaxed);
+}
+
+#endif /* ACT_CFG_MAILBOX == ACT_MAILBOX_EDF */
@@ -12,6 +12,48 @@ static ACT_MEMPOOL_DEFINE(Message_Mem, ACT_Message, ACT_MEM_NUM_MESSAGES);
 static ACT_MEMPOOL_DEFINE(TimeEvt_Mem, ACT_TimEvt, ACT_MEM_NUM_TIMEEVT);
 // static ACT_MEMPOOL_DEFINE(MemPool_Mem, ACT_Mempool, ACT_MEM_NUM_OBJPOOLS);
 
+#if ACT_CFG_EVT_HANDLES == 1
+/* Event handle layout: pool id (upper 4 bits) | block index (lower 12 bits). Handle 0 is invalid.
+Dynamic events use their event type as pool id. Static events are kept in a table with its own pool id */
+#define HANDLE_POOL_SHIFT 12
+#define HANDLE_INDEX_MASK 0x0FFFu
+#define HANDLE_POOL_STATIC 0xFu
+#endif
+
+_Static_assert(ACT_CFG_MAX_EVT_TYPES > ACT_USER_EVT && ACT_CFG_MAX_EVT_TYPES <= 255, "ACT_CFG_MAX_EVT_TYPES must be above ACT_USER_EVT");
+
+#if ACT_CFG_MEM_QUOTA == 1
+_Static_assert(ACT_CFG_MEM_CLASSES >= 1 && ACT_CFG_MEM_CLASSES <= 255, "ACT_CFG_MEM_CLASSES must be 1 to 255");
+
+/* Quotas and usage per memory class of an event type */
+typedef struct active_memQuota
+{
+  ACT_LOCK(lock);                                // Protects usage and pool, taken for all allocations of the type
+  uint16_t reserveLeft;                          // Reserved blocks not used by their class
+  uint16_t reserved[ACT_CFG_MEM_CLASSES];        // Reserved blocks per class
+  uint16_t max[ACT_CFG_MEM_CLASSES];             // Max used blocks per class
+  ACT_MemClassStats stats[ACT_CFG_MEM_CLASSES];  // Usage per class
+} ACT_MemQuota;
+#endif
+
+/* Pool and destructor of an event type */
+typedef struct active_evtTypeInfo
+{
+  ACT_MEMPOOL_TYPE *pool;         // Pool of events of the type, NULL if not registered
+  ACT_EvtDestructorFn destructor; // Called before freeing, can be NULL
+  atomic_uint failed;             // Number of failed allocations
+#if ACT_CFG_MEM_QUOTA == 1
+  bool limited;       // Quota set for the type
+  ACT_MemQuota quota; // Quotas, used if limited
+#endif
+} ACT_EvtTypeInfo;
+
+/* Event types by type id. Application types are added by ACT_EvtType_register */
+static ACT_EvtTypeInfo evtTypes[ACT_CFG_MAX_EVT_TYPES] = {
+    [ACT_SIGNAL] = {.pool = &Signal_Mem},
+    [ACT_MESSAGE] = {.pool = &Message_Mem},
+    [ACT_TIMEVT] = {.pool = &TimeEvt_Mem}};
+
 /* @private - used by Active framework tests */
 uint32_t ACT_mem_Signal_getUsed()
 {
@@ -51,7 +93,7 @@ void ACT_mem_refdec(const ACT_Evt *e)
   }
 }
 
-refCnt_t ACT_mem_getRefCount(const ACT_Evt *const e)
+uint16_t ACT_mem_getRefCount(const ACT_Evt *const e)
 {
   return atomic_load(&e->_refcnt);
 }
@@ -74,37 +116,157 @@ void ACT_mem_gc(const ACT_Evt *e)
     return;
   }
 
-  switch (e->type)
+  ACT_ASSERT(e->type > ACT_UNUSED && e->type < ACT_CFG_MAX_EVT_TYPES, "Invalid event type");
+  ACT_EvtTypeInfo const *info = &evtTypes[e->type];
+  ACT_ASSERT(info->pool != NULL, "Event type not registered");
+
+  if (info->destructor != NULL)
   {
-  case ACT_SIGNAL:
+    info->destructor((ACT_Evt *)e);
+  }
+
+  ACT_ASSERT(ACT_MEMPOOL_USED_GET(info->pool) > 0, "No events of type to free");
+#if ACT_CFG_RECORDER == 1
+  ACT_Recorder_add(ACT_REC_FREE, ACT_EVT_SENDER(e), e);
+#endif
+#if ACT_CFG_MEM_QUOTA == 1
+  if (info->limited)
   {
-    ACT_ASSERT(ACT_MEMPOOL_USED_GET(&Signal_Mem) > 0, "No Signal events to free");
-    ACT_MEMPOOL_FREE(&Signal_Mem, &e);
-    break;
+    ACT_MemQuota *quota = (ACT_MemQuota *)&info->quota;
+    uint8_t memClass = e->_memClass;
+
+    ACT_LOCK_KEY key = ACT_LOCK_TAKE(&quota->lock);
+    ACT_MEMPOOL_FREE(info->pool, &e);
+    if (--quota->stats[memClass].used < quota->reserved[memClass])
+    {
+      quota->reserveLeft++;
+    }
+    ACT_LOCK_GIVE(&quota->lock, key);
+    return;
   }
-  case ACT_MESSAGE:
+#endif
+  ACT_MEMPOOL_FREE(info->pool, &e);
+}
+
+/* Allocate a block for an event of a type, charged to the memory class of me (class 0 if NULL). NULL if the pool is empty or over quota */
+static void *ACT_mem_alloc(ACT_EvtType type, Active const *const me)
+{
+  ACT_EvtTypeInfo *info = &evtTypes[type];
+  void *block = NULL;
+  int status;
+
+#if ACT_CFG_MEM_QUOTA == 1
+  if (info->limited)
   {
-    ACT_ASSERT(ACT_MEMPOOL_USED_GET(&Message_Mem) > 0, "No Message events to free");
-    ACT_MEMPOOL_FREE(&Message_Mem, &e);
-    break;
+    ACT_MemQuota *quota = &info->quota;
+    // Events allocated without a sender, e.g. by plain threads, are charged to class 0
+    uint8_t memClass = (me != NULL) ? me->_memClass : 0;
+    ACT_MemClassStats *stats = &quota->stats[memClass];
+
+    ACT_LOCK_KEY key = ACT_LOCK_TAKE(&quota->lock);
+    bool inReserve = stats->used < quota->reserved[memClass];
+    int32_t unreserved = (int32_t)ACT_MEMPOOL_NUM_BLOCKS_GET(info->pool) - (int32_t)ACT_MEMPOOL_USED_GET(info->pool) - quota->reserveLeft;
+    status = -1;
+    if (stats->used < quota->max[memClass] && (inReserve || unreserved > 0))
+    {
+      status = ACT_MEMPOOL_ALLOC(info->pool, &block);
+    }
+    if (status == ACT_MEMPOOL_ALLOC_SUCCESS_STATUS)
+    {
+      quota->reserveLeft -= inReserve ? 1 : 0;
+      if (++stats->used > stats->maxUsed)
+      {
+        stats->maxUsed = stats->used;
+      }
+    }
+    else
+    {
+      stats->rejected++;
+    }
+    ACT_LOCK_GIVE(&quota->lock, key);
+
+    if (block != NULL)
+    {
+      ((ACT_Evt *)block)->_memClass = memClass;
+    }
   }
-  case ACT_TIMEVT:
+  else
+#endif
   {
-    ACT_ASSERT(ACT_MEMPOOL_USED_GET(&TimeEvt_Mem) > 0, "No time events to free");
-    ACT_MEMPOOL_FREE(&TimeEvt_Mem, &e);
-    break;
+    ACT_ARG_UNUSED(me);
+    status = ACT_MEMPOOL_ALLOC(info->pool, &block);
   }
-  default:
-    ACT_ASSERT(0, "Invalid event type");
+
+#if ACT_CFG_RECORDER == 1
+  ACT_Recorder_addType(ACT_REC_ALLOC, me, block, type);
+#endif
+
+  if (status != ACT_MEMPOOL_ALLOC_SUCCESS_STATUS)
+  {
+    atomic_fetch_add_explicit(&info->failed, 1, memory_order_relaxed);
+    return NULL;
   }
+  return block;
 }
 
-ACT_Signal *ACT_Signal_new(Active const *const me, uint16_t sig)
+void ACT_EvtType_register(ACT_EvtType type, ACT_MEMPOOL_TYPE *pool, ACT_EvtDestructorFn destructor)
 {
+  ACT_ASSERT(type >= ACT_USER_EVT && type < ACT_CFG_MAX_EVT_TYPES, "Event type out of range, see ACT_CFG_MAX_EVT_TYPES");
+  ACT_ASSERT(pool != NULL, "Event type pool is NULL");
+  ACT_ASSERT(evtTypes[type].pool == NULL, "Event type already registered");
+#if ACT_CFG_EVT_HANDLES == 1
+  ACT_ASSERT(pool->numBlocks <= HANDLE_INDEX_MASK + 1, "Too many events of type for event handles");
+#endif
+
+  evtTypes[type].destructor = destructor;
+  evtTypes[type].pool = pool;
+}
 
-  ACT_Signal *s = NULL;
-  int status = ACT_MEMPOOL_ALLOC(&Signal_Mem, &s);
-  ACT_ASSERT(status == ACT_MEMPOOL_ALLOC_SUCCESS_STATUS, "Failed to allocate new Signal");
+ACT_Evt *ACT_Evt_tryNew(ACT_EvtType type, Active const *const me)
+{
+  ACT_ASSERT(type >= ACT_USER_EVT && type < ACT_CFG_MAX_EVT_TYPES && evtTypes[type].pool != NULL, "Event type not registered");
+
+  ACT_Evt *e = ACT_mem_alloc(type, me);
+  if (e == NULL)
+  {
+    return NULL;
+  }
+
+  // Initialize event as static
+  ACT_Evt_init(e, me, type);
+
+  // Set event dynamic *after* initialization
+  ACT_mem_setDynamic(e);
+
+  return e;
+}
+
+ACT_Evt *ACT_Evt_new(ACT_EvtType type, Active const *const me)
+{
+  ACT_Evt *e = ACT_Evt_tryNew(type, me);
+  ACT_ASSERT(e != NULL, "Failed to allocate new event of type %d", type);
+  return e;
+}
+
+uint32_t ACT_mem_getUsed(ACT_EvtType type)
+{
+  ACT_ASSERT(type > ACT_UNUSED && type < ACT_CFG_MAX_EVT_TYPES && evtTypes[type].pool != NULL, "Event type not registered");
+  return ACT_MEMPOOL_USED_GET(evtTypes[type].pool);
+}
+
+uint32_t ACT_mem_getFailed(ACT_EvtType type)
+{
+  ACT_ASSERT(type > ACT_UNUSED && type < ACT_CFG_MAX_EVT_TYPES, "Invalid event type");
+  return atomic_load_explicit(&evtTypes[type].failed, memory_order_relaxed);
+}
+
+ACT_Signal *ACT_Signal_tryNew(Active const *const me, uint16_t sig)
+{
+  ACT_Signal *s = ACT_mem_alloc(ACT_SIGNAL, me);
+  if (s == NULL)
+  {
+    return NULL;
+  }
 
   // Initialize signal as static
   ACT_Signal_init(s, me, sig);
@@ -112,15 +274,23 @@ ACT_Signal *ACT_Signal_new(Active const *const me, uint16_t sig)
   // Set event dynamic *after* initialization
   ACT_mem_setDynamic(EVT_UPCAST(s));
 
-  ACT_ARG_UNUSED(status);
   return s;
 }
 
-ACT_Message *ACT_Message_new(Active const *const me, uint16_t msgHeader, void *msgPayload, uint16_t payloadLen)
+ACT_Signal *ACT_Signal_new(Active const *const me, uint16_t sig)
 {
-  ACT_Message *m = NULL;
-  int status = ACT_MEMPOOL_ALLOC(&Message_Mem, &m);
-  ACT_ASSERT(status == ACT_MEMPOOL_ALLOC_SUCCESS_STATUS, "Failed to allocate new Message");
+  ACT_Signal *s = ACT_Signal_tryNew(me, sig);
+  ACT_ASSERT(s != NULL, "Failed to allocate new Signal");
+  return s;
+}
+
+ACT_Message *ACT_Message_tryNew(Active const *const me, uint16_t msgHeader, void *msgPayload, uint16_t payloadLen)
+{
+  ACT_Message *m = ACT_mem_alloc(ACT_MESSAGE, me);
+  if (m == NULL)
+  {
+    return NULL;
+  }
 
   // Initialize message as static
   ACT_Message_init(m, me, msgHeader, msgPayload, payloadLen);
@@ -128,25 +298,203 @@ ACT_Message *ACT_Message_new(Active const *const me, uint16_t msgHeader, void *m
   // Set event dynamic *after* initialization
   ACT_mem_setDynamic(EVT_UPCAST(m));
 
-  ACT_ARG_UNUSED(status);
   return m;
 }
 
-ACT_TimEvt *ACT_TimEvt_new(ACT_Evt *const e, const Active *const me, const Active *const receiver, ACT_TimerExpiryFn expFn)
+ACT_Message *ACT_Message_new(Active const *const me, uint16_t msgHeader, void *msgPayload, uint16_t payloadLen)
 {
+  ACT_Message *m = ACT_Message_tryNew(me, msgHeader, msgPayload, payloadLen);
+  ACT_ASSERT(m != NULL, "Failed to allocate new Message");
+  return m;
+}
 
-  ACT_TimEvt *te = NULL;
-  int status = ACT_MEMPOOL_ALLOC(&TimeEvt_Mem, &te);
-  ACT_ASSERT(status == ACT_MEMPOOL_ALLOC_SUCCESS_STATUS, "Failed to allocate new Time Event");
+ACT_TimEvt *ACT_TimEvt_new(ACT_Evt *const e, const Active *const me, const Active *const receiver, ACT_TimerExpiryFn expFn)
+{
+  ACT_TimEvt *te = ACT_mem_alloc(ACT_TIMEVT, me);
+  ACT_ASSERT(te != NULL, "Failed to allocate new Time Event");
 
   ACT_TimEvt_init(te, me, e, receiver, expFn);
 
   // Set event dynamic *after* initialization
   ACT_mem_setDynamic(EVT_UPCAST(te));
 
-  ACT_ARG_UNUSED(status);
   return te;
 }
+
+#if ACT_CFG_MEM_QUOTA == 1
+
+void ACT_mem_setQuota(ACT_EvtType type, uint8_t memClass, uint16_t reserved, uint16_t max)
+{
+  ACT_ASSERT(type > ACT_UNUSED && type < ACT_CFG_MAX_EVT_TYPES && evtTypes[type].pool != NULL, "Event type not registered");
+  ACT_ASSERT(memClass < ACT_CFG_MEM_CLASSES, "Memory class above ACT_CFG_MEM_CLASSES - 1");
+  ACT_ASSERT(reserved <= max, "Reserved blocks above max blocks of memory class");
+
+  ACT_EvtTypeInfo *info = &evtTypes[type];
+  ACT_MemQuota *quota = &info->quota;
+  uint16_t numBlocks = (uint16_t)ACT_MEMPOOL_NUM_BLOCKS_GET(info->pool);
+  ACT_ASSERT(ACT_MEMPOOL_USED_GET(info->pool) == 0, "Quota set after allocating events of type");
+
+  if (!info->limited)
+  {
+    ACT_LOCK_INIT(&quota->lock);
+    for (size_t i = 0; i < ACT_CFG_MEM_CLASSES; i++)
+    {
+      quota->reserved[i] = 0;
+      quota->max[i] = numBlocks;
+      quota->stats[i] = (ACT_MemClassStats){0};
+    }
+    quota->reserveLeft = 0;
+    info->limited = true;
+  }
+
+  quota->reserveLeft = quota->reserveLeft - quota->reserved[memClass] + reserved;
+  ACT_ASSERT(quota->reserveLeft <= numBlocks, "Reserved blocks of all memory classes above pool size");
+  quota->reserved[memClass] = reserved;
+  quota->max[memClass] = max;
+}
+
+void ACT_setMemClass(Active *me, uint8_t memClass)
+{
+  ACT_ASSERT(memClass < ACT_CFG_MEM_CLASSES, "Memory class above ACT_CFG_MEM_CLASSES - 1");
+  me->_memClass = memClass;
+}
+
+ACT_MemClassStats ACT_mem_getClassStats(ACT_EvtType type, uint8_t memClass)
+{
+  ACT_ASSERT(type > ACT_UNUSED && type < ACT_CFG_MAX_EVT_TYPES && evtTypes[type].limited, "No quota set for event type");
+  ACT_ASSERT(memClass < ACT_CFG_MEM_CLASSES, "Memory class above ACT_CFG_MEM_CLASSES - 1");
+
+  ACT_MemQuota *quota = &evtTypes[type].quota;
+  ACT_LOCK_KEY key = ACT_LOCK_TAKE(&quota->lock);
+  ACT_MemClassStats stats = quota->stats[memClass];
+  ACT_LOCK_GIVE(&quota->lock, key);
+  return stats;
+}
+
+#endif /* ACT_CFG_MEM_QUOTA == 1 */
+
+#if ACT_CFG_EVT_HANDLES == 1
+
+_Static_assert(ACT_CFG_MAX_EVT_TYPES <= HANDLE_POOL_STATIC, "Event types do not fit in event handle");
+_Static_assert(ACT_MEM_NUM_SIGNALS <= HANDLE_INDEX_MASK + 1, "Too many signals for event handles");
+_Static_assert(ACT_MEM_NUM_MESSAGES <= HANDLE_INDEX_MASK + 1, "Too many messages for event handles");
+_Static_assert(ACT_MEM_NUM_TIMEEVT <= HANDLE_INDEX_MASK + 1, "Too many time events for event handles");
+_Static_assert(ACT_CFG_HANDLE_NUM_STATIC <= HANDLE_INDEX_MASK + 1, "Too many static events for event handles");
+
+/* Static events in queues. An entry is claimed when its event is posted and not queued yet, and released when the last
+queued reference is taken */
+static _Atomic(const ACT_Evt *) staticEvts[ACT_CFG_HANDLE_NUM_STATIC];
+static atomic_uint staticRefs[ACT_CFG_HANDLE_NUM_STATIC]; // Queued references to the event of an entry
+
+static inline ACT_Handle ACT_mem_makeHandle(unsigned int poolId, size_t idx)
+{
+  return (ACT_Handle)((poolId << HANDLE_POOL_SHIFT) | idx);
+}
+
+static void ACT_mem_staticRelease(size_t idx)
+{
+  ACT_ASSERT(atomic_load(&staticRefs[idx]) > 0, "Static event handle released more often than queued");
+  if (atomic_fetch_sub(&staticRefs[idx], 1) == 1)
+  {
+    atomic_store(&staticEvts[idx], NULL);
+  }
+}
+
+/* Add a reference to an entry holding the event. False if the entry is being released or claimed */
+static bool ACT_mem_staticRetain(size_t idx, const ACT_Evt *e)
+{
+  unsigned int refs = atomic_load(&staticRefs[idx]);
+  do
+  {
+    if (refs == 0)
+    {
+      return false;
+    }
+  } while (!atomic_compare_exchange_weak(&staticRefs[idx], &refs, refs + 1));
+
+  // The entry may have been released and claimed for another event in between
+  if (atomic_load(&staticEvts[idx]) != e)
+  {
+    ACT_mem_staticRelease(idx);
+    return false;
+  }
+  return true;
+}
+
+static ACT_Handle ACT_mem_staticToHandle(const ACT_Evt *e)
+{
+  // Share the entry of the event if it is queued already
+  for (size_t i = 0; i < ACT_CFG_HANDLE_NUM_STATIC; i++)
+  {
+    if (atomic_load(&staticEvts[i]) == e && ACT_mem_staticRetain(i, e))
+    {
+      return ACT_mem_makeHandle(HANDLE_POOL_STATIC, i);
+    }
+  }
+
+  // Claim a free entry
+  for (size_t i = 0; i < ACT_CFG_HANDLE_NUM_STATIC; i++)
+  {
+    const ACT_Evt *entry = NULL;
+    if (atomic_compare_exchange_strong(&staticEvts[i], &entry, e))
+    {
+      atomic_fetch_add(&staticRefs[i], 1);
+      return ACT_mem_makeHandle(HANDLE_POOL_STATIC, i);
+    }
+  }
+
+  ACT_ASSERT(0, "Too many static events queued at a time. Increase ACT_CFG_HANDLE_NUM_STATIC");
+  return 0;
+}
+
+ACT_Handle ACT_mem_toHandle(const ACT_Evt *e)
+{
+  if (!ACT_mem_isDynamic(e))
+  {
+    return ACT_mem_staticToHandle(e);
+  }
+
+  ACT_ASSERT(e->type > ACT_UNUSED && e->type < ACT_CFG_MAX_EVT_TYPES, "Invalid event type");
+  ACT_Mempool *pool = evtTypes[e->type].pool;
+  size_t idx = (size_t)((const char *)e - pool->buf) / pool->blockSize;
+
+  return ACT_mem_makeHandle(e->type, idx);
+}
+
+ACT_Evt *ACT_mem_fromHandle(ACT_Handle h)
+{
+  unsigned int poolId = h >> HANDLE_POOL_SHIFT;
+  size_t idx = h & HANDLE_INDEX_MASK;
+
+  if (poolId == HANDLE_POOL_STATIC)
+  {
+    ACT_ASSERT(idx < ACT_CFG_HANDLE_NUM_STATIC, "Invalid static event handle");
+    return (ACT_Evt *)atomic_load(&staticEvts[idx]);
+  }
+
+  ACT_ASSERT(poolId > ACT_UNUSED && poolId < ACT_CFG_MAX_EVT_TYPES && evtTypes[poolId].pool != NULL, "Invalid event handle");
+  ACT_Mempool *pool = evtTypes[poolId].pool;
+  return (ACT_Evt *)(pool->buf + idx * pool->blockSize);
+}
+
+void ACT_mem_retainHandle(ACT_Handle h)
+{
+  if ((h >> HANDLE_POOL_SHIFT) == HANDLE_POOL_STATIC)
+  {
+    ACT_ASSERT(atomic_load(&staticRefs[h & HANDLE_INDEX_MASK]) > 0, "Static event handle not held");
+    atomic_fetch_add(&staticRefs[h & HANDLE_INDEX_MASK], 1);
+  }
+}
+
+void ACT_mem_releaseHandle(ACT_Handle h)
+{
+  if ((h >> HANDLE_POOL_SHIFT) == HANDLE_POOL_STATIC)
+  {
+    ACT_mem_staticRelease(h & HANDLE_INDEX_MASK);
+  }
+}
+
+#endif /* ACT_CFG_EVT_HANDLES == 1 */
 /*
 ACT_Mempool *ACT_Mempool_new(void *memBuf, size_t objSize, size_t numObjects)
 {
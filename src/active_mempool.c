@@ -0,0 +1,115 @@
+#include <active.h>
+
+#if ACT_CFG_MEMPOOL_LOCKFREE == 1
+
+/* The pool relies on 32 bit compare-and-swap being lock-free to be ISR safe.
+Targets without (e.g. ARMv6-M) must set ACT_CFG_MEMPOOL_LOCKFREE to 0 and use the port's native pool */
+_Static_assert(ATOMIC_INT_LOCK_FREE == 2, "Lock-free memory pool requires lock-free 32 bit atomics");
+
+#define MEMPOOL_REF_MASK 0xFFFFu
+#define MEMPOOL_TAG_INC 0x10000u
+
+static inline char *ACT_Mempool_block(ACT_Mempool const *const pool, uint32_t idx)
+{
+  return pool->buf + (idx * pool->blockSize);
+}
+
+static void ACT_Mempool_accountAlloc(ACT_Mempool *const pool)
+{
+  unsigned int used = atomic_fetch_add_explicit(&pool->used, 1, memory_order_relaxed) + 1;
+  unsigned int maxUsed = atomic_load_explicit(&pool->maxUsed, memory_order_relaxed);
+
+  while (used > maxUsed &&
+         !atomic_compare_exchange_weak_explicit(&pool->maxUsed, &maxUsed, used, memory_order_relaxed, memory_order_relaxed))
+  {
+  }
+}
+
+void ACT_Mempool_init(ACT_Mempool *pool, void *memBuf, size_t objSize, size_t numObjects)
+{
+  ACT_ASSERT(pool != NULL, "Memory pool is NULL");
+  ACT_ASSERT(memBuf != NULL, "Memory pool buffer is NULL");
+  ACT_ASSERT(objSize >= sizeof(uint16_t), "Memory pool objects must be at least 2 bytes");
+  ACT_ASSERT(numObjects <= MEMPOOL_REF_MASK, "Too many objects in memory pool");
+
+  pool->buf = (char *)memBuf;
+  pool->blockSize = objSize;
+  pool->numBlocks = (uint16_t)numObjects;
+  atomic_init(&pool->head, 0);
+  atomic_init(&pool->fresh, 0);
+  atomic_init(&pool->used, 0);
+  atomic_init(&pool->maxUsed, 0);
+}
+
+int ACT_Mempool_alloc(ACT_Mempool *pool, void **blockPptr)
+{
+  ACT_ASSERT(pool != NULL, "Memory pool is NULL");
+
+  // Pop from free stack. The tag is bumped on every pop so a head that was popped and pushed back
+  // between our load and CAS (ABA) will not compare equal.
+  unsigned int head = atomic_load_explicit(&pool->head, memory_order_acquire);
+  while ((head & MEMPOOL_REF_MASK) != 0)
+  {
+    char *block = ACT_Mempool_block(pool, (head & MEMPOOL_REF_MASK) - 1);
+
+    // Link may be stale if another context popped the block meanwhile - the CAS will then fail
+    uint16_t next = *(volatile uint16_t *)block;
+    unsigned int newHead = ((head + MEMPOOL_TAG_INC) & ~MEMPOOL_REF_MASK) | next;
+
+    if (atomic_compare_exchange_weak_explicit(&pool->head, &head, newHead, memory_order_acquire, memory_order_acquire))
+    {
+      ACT_Mempool_accountAlloc(pool);
+      *blockPptr = block;
+      return 0;
+    }
+  }
+
+  // Free stack empty - hand out a block that was never used
+  unsigned int fresh = atomic_load_explicit(&pool->fresh, memory_order_relaxed);
+  while (fresh < pool->numBlocks)
+  {
+    if (atomic_compare_exchange_weak_explicit(&pool->fresh, &fresh, fresh + 1, memory_order_relaxed, memory_order_relaxed))
+    {
+      ACT_Mempool_accountAlloc(pool);
+      *blockPptr = ACT_Mempool_block(pool, fresh);
+      return 0;
+    }
+  }
+
+  *blockPptr = NULL;
+  return ACT_MEMPOOL_ERR_NOMEM;
+}
+
+void ACT_Mempool_free(ACT_Mempool *pool, void **blockPptr)
+{
+  ACT_ASSERT(pool != NULL, "Memory pool is NULL");
+  ACT_ASSERT(blockPptr != NULL && *blockPptr != NULL, "Block to free is NULL");
+
+  char *block = (char *)*blockPptr;
+  ACT_ASSERT(block >= pool->buf && block < ACT_Mempool_block(pool, pool->numBlocks), "Block does not belong to pool");
+  ACT_ASSERT(((size_t)(block - pool->buf) % pool->blockSize) == 0, "Block is not aligned to pool block size");
+
+  uint16_t ref = (uint16_t)(((size_t)(block - pool->buf) / pool->blockSize) + 1);
+
+  // Push on free stack. Link to current head is stored in the free block itself
+  unsigned int head = atomic_load_explicit(&pool->head, memory_order_relaxed);
+  do
+  {
+    *(volatile uint16_t *)block = (uint16_t)(head & MEMPOOL_REF_MASK);
+  } while (!atomic_compare_exchange_weak_explicit(&pool->head, &head, (head & ~MEMPOOL_REF_MASK) | ref,
+                                                  memory_order_release, memory_order_relaxed));
+
+  atomic_fetch_sub_explicit(&pool->used, 1, memory_order_relaxed);
+}
+
+uint32_t ACT_Mempool_getUsed(ACT_Mempool *pool)
+{
+  return atomic_load_explicit(&pool->used, memory_order_relaxed);
+}
+
+uint32_t ACT_Mempool_getMaxUsed(ACT_Mempool *pool)
+{
+  return atomic_load_explicit(&pool->maxUsed, memory_order_relaxed);
+}
+
+#endif /* ACT_CFG_MEMPOOL_LOCKFREE == 1 */
@@ -1,14 +1,12 @@
 #include <stdbool.h>
 #include <active.h>
 
-static void ACT_Evt_init(ACT_Evt *const e, Active const *const me, ACT_EvtType type)
+void ACT_Evt_init(ACT_Evt *const e, Active const *const me, ACT_EvtType type)
 {
-
   ACT_ASSERT(e != NULL, "ACT_Evt is NULL");
-  ACT_ASSERT(me != NULL, "Active object sender not set for event");
 
   e->type = type;
-  e->_sender = (Active *)me;
+  e->_sender = ACT_SENDER_REF(me);
 
   // Cast away const to clear dynamic field
   bool *dyn = (bool *)&(e->_dynamic);
@@ -17,6 +15,14 @@ static void ACT_Evt_init(ACT_Evt *const e, Active const *const me, ACT_EvtType t
   // Cast away const to clear reference count
   refCnt_t *cnt = (refCnt_t *)&(e->_refcnt);
   *cnt = 0;
+
+#if ACT_CFG_RPC == 1
+  e->_corrId = ACT_CORR_NONE;
+#endif
+
+#if ACT_CFG_MAILBOX == ACT_MAILBOX_EDF
+  e->_deadlineUs = 0;
+#endif
 }
 void ACT_Signal_init(ACT_Signal *s, Active const *const me, uint16_t sig)
 {
@@ -36,7 +42,7 @@ void ACT_Message_init(ACT_Message *m, Active const *const me, uint16_t header, v
 
 void ACT_TimEvt_init(ACT_TimEvt *const te, const Active *const me, ACT_Evt *const e, Active const *const receiver, ACT_TimerExpiryFn expFn)
 {
-
+  ACT_ASSERT(me != NULL, "Active object processing time event not set");
   ACT_ASSERT((e == NULL && expFn != NULL) || e != NULL, "ACT_Evt is null without expiry function set");
 
   // Initialize timer event
@@ -47,3 +53,13 @@ void ACT_TimEvt_init(ACT_TimEvt *const te, const Active *const me, ACT_Evt *cons
   te->expFn = expFn;
   ACT_Timer_init(te);
 }
+
+#if ACT_CFG_MAILBOX == ACT_MAILBOX_EDF
+void ACT_Evt_setDeadline(ACT_Evt *const e, uint32_t deadlineUs)
+{
+  ACT_ASSERT(e != NULL, "ACT_Evt is NULL");
+  ACT_ASSERT(deadlineUs <= INT32_MAX, "Deadline too far in the future");
+
+  e->_deadlineUs = deadlineUs;
+}
+#endif
@@ -0,0 +1,159 @@
+#include <active.h>
+
+_Static_assert(ACT_CFG_OFFLOAD_PRIOS >= 1 && ACT_CFG_OFFLOAD_PRIOS <= 255, "ACT_CFG_OFFLOAD_PRIOS must be 1 to 255");
+
+/* Posted to a worker per submitted job. The worker runs the highest priority pending job, not necessarily that one */
+static const ACT_SIGNAL_DEFINE(runSignal, ACT_USER_SIG);
+
+static ACT_Job *ACT_Offload_take(ACT_Offload *pool)
+{
+  ACT_Job *job = NULL;
+
+  ACT_LOCK_KEY key = ACT_LOCK_TAKE(&pool->lock);
+  for (size_t prio = 0; prio < ACT_CFG_OFFLOAD_PRIOS; prio++)
+  {
+    job = pool->head[prio];
+    if (job != NULL)
+    {
+      pool->head[prio] = job->next;
+      if (pool->head[prio] == NULL)
+      {
+        pool->tail[prio] = NULL;
+      }
+      pool->pending--;
+      break;
+    }
+  }
+  ACT_LOCK_GIVE(&pool->lock, key);
+
+  return job;
+}
+
+static void ACT_Offload_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e != EVT_UPCAST(&runSignal))
+  {
+    return;
+  }
+
+  ACT_Offload *pool = ((ACT_OffloadWorker *)me)->pool;
+  ACT_Job *job = ACT_Offload_take(pool);
+  ACT_ASSERT(job != NULL, "Worker woken without pending job");
+
+  job->result = job->fn(job->ctx, job->done.payload, job->done.payloadLen);
+  atomic_fetch_add_explicit(&pool->completed, 1, memory_order_relaxed);
+
+  // Free the job before posting, so the owner can submit it again when processing the completion
+  atomic_store(&job->busy, false);
+  ACT_postEvt(job->owner, EVT_UPCAST(&job->done));
+}
+
+void ACT_Offload_init(ACT_Offload *pool, ACT_OffloadWorker *workers, size_t numWorkers, size_t maxPending,
+                      ACT_QueueData const *qd, ACT_ThreadData const *td)
+{
+  ACT_ASSERT(pool != NULL, "Offload pool is NULL");
+  ACT_ASSERT(workers != NULL && numWorkers > 0 && numWorkers <= ACT_CFG_OFFLOAD_MAX_WORKERS,
+             "Offload pool needs 1 to ACT_CFG_OFFLOAD_MAX_WORKERS workers");
+  ACT_ASSERT(maxPending > 0, "Offload pool can not hold any jobs");
+
+  for (size_t prio = 0; prio < ACT_CFG_OFFLOAD_PRIOS; prio++)
+  {
+    pool->head[prio] = NULL;
+    pool->tail[prio] = NULL;
+  }
+  pool->maxPending = maxPending;
+  pool->pending = 0;
+  ACT_LOCK_INIT(&pool->lock);
+  atomic_init(&pool->submitted, 0);
+  atomic_init(&pool->completed, 0);
+  atomic_init(&pool->rejected, 0);
+  atomic_init(&pool->maxPendingSeen, 0);
+
+  for (size_t i = 0; i < numWorkers; i++)
+  {
+    workers[i].pool = pool;
+    pool->members[i] = &workers[i].super;
+  }
+
+  ACT_Group_init(&pool->group, pool->members, numWorkers, ACT_Offload_dispatch, qd, td);
+}
+
+void ACT_Offload_start(ACT_Offload *pool)
+{
+  ACT_Group_start(&pool->group);
+}
+
+void ACT_Job_init(ACT_Job *job, Active const *owner, ACT_JobFn fn, void *ctx, uint16_t doneHeader)
+{
+  ACT_ASSERT(job != NULL && fn != NULL, "Job or job function is NULL");
+
+  ACT_Message_init(&job->done, owner, doneHeader, NULL, 0);
+  job->owner = owner;
+  job->fn = fn;
+  job->ctx = ctx;
+  job->next = NULL;
+  job->result = 0;
+  atomic_init(&job->busy, false);
+}
+
+int ACT_Offload_submit(ACT_Offload *pool, ACT_Job *job, void *payload, uint16_t payloadLen, uint8_t prio)
+{
+  ACT_ASSERT(pool != NULL && job != NULL, "Offload pool or job is NULL");
+  ACT_ASSERT(prio < ACT_CFG_OFFLOAD_PRIOS, "Job priority above ACT_CFG_OFFLOAD_PRIOS - 1");
+
+  bool idle = false;
+  if (!atomic_compare_exchange_strong(&job->busy, &idle, true))
+  {
+    return ACT_OFFLOAD_ERR_BUSY;
+  }
+
+  job->done.payload = payload;
+  job->done.payloadLen = payloadLen;
+  job->next = NULL;
+
+  ACT_LOCK_KEY key = ACT_LOCK_TAKE(&pool->lock);
+  if (pool->pending == pool->maxPending)
+  {
+    ACT_LOCK_GIVE(&pool->lock, key);
+    atomic_store(&job->busy, false);
+    atomic_fetch_add_explicit(&pool->rejected, 1, memory_order_relaxed);
+    return ACT_OFFLOAD_ERR_FULL;
+  }
+
+  if (pool->tail[prio] == NULL)
+  {
+    pool->head[prio] = job;
+  }
+  else
+  {
+    pool->tail[prio]->next = job;
+  }
+  pool->tail[prio] = job;
+  unsigned int pending = (unsigned int)++pool->pending;
+  ACT_LOCK_GIVE(&pool->lock, key);
+
+  atomic_fetch_add_explicit(&pool->submitted, 1, memory_order_relaxed);
+  unsigned int maxPending = atomic_load_explicit(&pool->maxPendingSeen, memory_order_relaxed);
+  while (pending > maxPending &&
+         !atomic_compare_exchange_weak_explicit(&pool->maxPendingSeen, &maxPending, pending, memory_order_relaxed, memory_order_relaxed))
+  {
+  }
+
+  return ACT_postGroup(&pool->group, EVT_UPCAST(&runSignal));
+}
+
+int32_t ACT_Job_getResult(ACT_Job const *job)
+{
+  return job->result;
+}
+
+ACT_OffloadStats ACT_Offload_getStats(ACT_Offload *pool)
+{
+  ACT_OffloadStats stats = {
+      .submitted = atomic_load_explicit(&pool->submitted, memory_order_relaxed),
+      .completed = atomic_load_explicit(&pool->completed, memory_order_relaxed),
+      .rejected = atomic_load_explicit(&pool->rejected, memory_order_relaxed),
+      .maxPending = atomic_load_explicit(&pool->maxPendingSeen, memory_order_relaxed),
+  };
+  return stats;
+}
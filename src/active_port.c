@@ -1,12 +1,302 @@
 #include <active.h>
 
-#ifdef __ZEPHYR__
+#if ACT_CFG_PORT_SIM == 1
+
+static ACT_SimThread *threadList;      // Active objects in order of ACT_init
+static ACT_SimThread *lastRun;         // Active object that processed the last event
+static ACT_SimTimer *timerList;        // Armed timers sorted by expiry time
+static uint64_t nowUs;                 // Virtual clock
+static bool dispatching;               // An Active object is processing an event
+
+void ACT_init(Active *const me, ACT_DispatchFn dispatch, ACT_QueueData const *qd, ACT_ThreadData const *td)
+{
+  ACT_initCommon(me, dispatch, qd, td);
+  me->thread = td->thread;
+
+  ACT_SimThread *t = td->thread;
+  t->me = me;
+  t->pri = td->pri;
+  t->started = false;
+  t->initialized = false;
+  t->next = NULL;
+
+  ACT_SimThread **pp = &threadList;
+  while (*pp != NULL)
+  {
+    pp = &(*pp)->next;
+  }
+  *pp = t;
+}
+
+void ACT_start(Active *const me)
+{
+  // Start event is processed by the scheduler, like a thread that is made ready but not yet run
+  me->thread->started = true;
+}
+
+void ACT_NativeTimerExpiryFn(ACT_TIMERPTR(nativeTimerPtr))
+{
+  ACT_TimEvt *te = (ACT_TimEvt *)ACT_TIMER_PARAM_GET(nativeTimerPtr);
+  ACT_Timer_expiryCB(te);
+}
+
+/**
+ * @brief Queue
+ *
+ */
+
+void ACT_SimQueue_init(ACT_SimQueue *q, char *buf, size_t maxMsg)
+{
+  q->buf = (ACT_QEntry *)buf;
+  q->maxMsg = maxMsg;
+  q->head = 0;
+  q->used = 0;
+}
+
+int ACT_SimQueue_put(ACT_SimQueue *q, ACT_QEntry const *entry)
+{
+  if (q->used == q->maxMsg)
+  {
+    return -1;
+  }
+
+  q->buf[(q->head + q->used) % q->maxMsg] = *entry;
+  q->used++;
+  return 0;
+}
+
+int ACT_SimQueue_get(ACT_SimQueue *q, ACT_QEntry *entry)
+{
+  if (q->used == 0)
+  {
+    return -1;
+  }
+
+  *entry = q->buf[q->head];
+  q->head = (q->head + 1) % q->maxMsg;
+  q->used--;
+  return 0;
+}
+
+/**
+ * @brief Timers
+ *
+ */
+
+static void ACT_SimTimer_insert(ACT_SimTimer *t)
+{
+  // Timers with equal expiry time expire in order of start
+  ACT_SimTimer **pp = &timerList;
+  while (*pp != NULL && (*pp)->expiryUs <= t->expiryUs)
+  {
+    pp = &(*pp)->next;
+  }
+  t->next = *pp;
+  *pp = t;
+}
+
+static void ACT_SimTimer_remove(ACT_SimTimer *t)
+{
+  for (ACT_SimTimer **pp = &timerList; *pp != NULL; pp = &(*pp)->next)
+  {
+    if (*pp == t)
+    {
+      *pp = t->next;
+      break;
+    }
+  }
+}
+
+void ACT_SimTimer_init(ACT_SimTimer *t, void (*expiryFn)(ACT_SimTimer *))
+{
+  t->expiryFn = expiryFn;
+  t->param = NULL;
+  t->armed = false;
+  t->next = NULL;
+}
+
+void ACT_SimTimer_start(ACT_SimTimer *t, uint64_t durationMs, uint64_t periodMs)
+{
+  if (t->armed)
+  {
+    ACT_SimTimer_remove(t);
+  }
+  t->expiryUs = nowUs + durationMs * 1000u;
+  t->periodUs = periodMs * 1000u;
+  t->armed = true;
+  ACT_SimTimer_insert(t);
+}
+
+void ACT_SimTimer_stop(ACT_SimTimer *t)
+{
+  if (t->armed)
+  {
+    ACT_SimTimer_remove(t);
+    t->armed = false;
+  }
+}
+
+/* Jump virtual clock to the first timer expiry (if not later than untilUs) and expire all timers due at that time */
+static bool ACT_Sim_expireNext(uint64_t untilUs)
+{
+  if (timerList == NULL || timerList->expiryUs > untilUs)
+  {
+    return false;
+  }
+
+  if (timerList->expiryUs > nowUs)
+  {
+    nowUs = timerList->expiryUs;
+  }
+
+  while (timerList != NULL && timerList->expiryUs <= nowUs)
+  {
+    ACT_SimTimer *t = timerList;
+    timerList = t->next;
+
+    if (t->periodUs != 0)
+    {
+      t->expiryUs += t->periodUs;
+      ACT_SimTimer_insert(t);
+    }
+    else
+    {
+      t->armed = false;
+    }
+
+    t->expiryFn(t);
+  }
+
+  return true;
+}
+
+/**
+ * @brief Scheduler
+ *
+ */
+
+static bool ACT_Sim_isReady(ACT_SimThread const *t)
+{
+  if (!t->started)
+  {
+    return false;
+  }
+  return !t->initialized || ACT_threadHasHeld(t->me) || ACT_Q_USED_GET(t->me->queue) > 0;
+}
+
+bool ACT_Sim_step(void)
+{
+  ACT_ASSERT(!dispatching, "Scheduler called from an Active object");
+
+  // Highest priority ready Active object. Search starts after the last one run, to let equal priorities take turns
+  ACT_SimThread *first = (lastRun != NULL && lastRun->next != NULL) ? lastRun->next : threadList;
+  ACT_SimThread *next = NULL;
+  ACT_SimThread *t = first;
+
+  do
+  {
+    if (t == NULL)
+    {
+      break;
+    }
+    if (ACT_Sim_isReady(t) && (next == NULL || t->pri < next->pri))
+    {
+      next = t;
+    }
+    t = (t->next != NULL) ? t->next : threadList;
+  } while (t != first);
+
+  if (next == NULL)
+  {
+    return false;
+  }
+
+  lastRun = next;
+  dispatching = true;
+
+  if (!next->initialized)
+  {
+    next->initialized = true;
+    ACT_threadInit(next->me);
+  }
+  else
+  {
+    // Same order of recalled, held and queued events as ACT_threadFn. The queue is not empty, so taking does not block
+    ACT_Evt *e = ACT_threadNext(next->me);
+    if (e != NULL)
+    {
+      ACT_threadProcess(next->me, e);
+    }
+  }
+
+  dispatching = false;
+  return true;
+}
+
+uint64_t ACT_Sim_nowUs(void)
+{
+  return nowUs;
+}
+
+void ACT_Sim_sleepUs(uint64_t us)
+{
+  uint64_t untilUs = nowUs + us;
+
+  // Run until all Active objects are idle, then jump to the next timer expiry
+  do
+  {
+    while (!dispatching && ACT_Sim_step())
+    {
+    }
+  } while (ACT_Sim_expireNext(untilUs));
+
+  nowUs = untilUs;
+}
+
+void ACT_Sim_semTake(ACT_SimSem *sem)
+{
+  while (sem->count == 0)
+  {
+    ACT_ASSERT(!dispatching, "Active object blocked on semaphore in simulation");
+
+    if (!ACT_Sim_step())
+    {
+      bool expired = ACT_Sim_expireNext(UINT64_MAX);
+      ACT_ASSERT(expired, "Simulation deadlock: semaphore never given");
+      ACT_ARG_UNUSED(expired);
+    }
+  }
+
+  sem->count--;
+}
+
+bool ACT_Sim_semTakeMs(ACT_SimSem *sem, uint32_t ms)
+{
+  uint64_t untilUs = nowUs + (uint64_t)ms * 1000u;
+
+  while (sem->count == 0)
+  {
+    ACT_ASSERT(!dispatching, "Active object blocked on semaphore in simulation");
+
+    if (!ACT_Sim_step() && !ACT_Sim_expireNext(untilUs))
+    {
+      nowUs = untilUs;
+      return false;
+    }
+  }
+
+  sem->count--;
+  return true;
+}
+
+#elif defined(__ZEPHYR__)
 
 #include <zephyr.h>
 
 /* Zephyr puts limits on aligment of queue buffer and size of queue content (ACT_Evt *):
 https://docs.zephyrproject.org/latest/reference/kernel/data_passing/message_queues.html */
 
+#if ACT_CFG_RPC == 0 && ACT_CFG_MAILBOX != ACT_MAILBOX_EDF /* Optional event fields add to the size of all events */
 _Static_assert(sizeof(ACT_Evt) == 12, "ACT_Evt type is not the right size.");
 _Static_assert(_Alignof(ACT_Evt *) == 4, "Alignment of ACT_Evt pointer type must be a power of 2");
 
@@ -21,6 +311,7 @@ _Static_assert(_Alignof(ACT_Message) == 4, "Alignment ACT_Message type");
 
 _Static_assert(sizeof(ACT_Signal) == 16, "ACT_Signal type is not the right size.");
 _Static_assert(_Alignof(ACT_Signal) == 4, "Alignment ACT_Signal type");
+#endif /* Optional event fields */
 
 /* Zephyr thread entry function */
 static void active_entry(void *arg1, void *arg2, void *arg3)
@@ -30,14 +321,7 @@ static void active_entry(void *arg1, void *arg2, void *arg3)
 
 void ACT_init(Active *const me, ACT_DispatchFn dispatch, ACT_QueueData const *qd, ACT_ThreadData const *td)
 {
-  ACT_ASSERT(me != NULL, "Active object is null)");
-  ACT_ASSERT(dispatch != NULL, "Dispatch handler is null");
-
-  me->dispatch = dispatch;
-
-  k_msgq_init(qd->queue, qd->queBuf, sizeof(ACT_Evt *), qd->maxMsg);
-
-  me->queue = qd->queue;
+  ACT_initCommon(me, dispatch, qd, td);
   me->thread = k_thread_create(td->thread, td->stack, td->stack_size, active_entry, (void *)me, NULL, NULL, td->pri, 0, K_FOREVER);
 }
 
@@ -60,4 +344,265 @@ void assert_post_action(const char *file, unsigned int line)
   }
 }
 
-#endif /* __ZEPHYR__ */
\ No newline at end of file
+
+#elif defined(__unix__)
+
+#include <errno.h>
+#include <time.h>
+
+/* pthread entry function */
+static void *active_entry(void *arg)
+{
+  ACT_threadFn((Active *const)arg);
+  return NULL;
+}
+
+void ACT_init(Active *const me, ACT_DispatchFn dispatch, ACT_QueueData const *qd, ACT_ThreadData const *td)
+{
+  ACT_initCommon(me, dispatch, qd, td);
+  // pthreads can not be created suspended - thread is created by ACT_start
+  me->thread = td->thread;
+}
+
+void ACT_start(Active *const me)
+{
+  int status = pthread_create(me->thread, NULL, active_entry, (void *)me);
+  ACT_ASSERT(status == 0, "Failed to create thread. Error: %i", status);
+  ACT_ARG_UNUSED(status);
+}
+
+void ACT_NativeTimerExpiryFn(ACT_TIMERPTR(nativeTimerPtr))
+{
+  ACT_TimEvt *te = (ACT_TimEvt *)ACT_TIMER_PARAM_GET(nativeTimerPtr);
+  ACT_Timer_expiryCB(te);
+}
+
+uint64_t ACT_Posix_nowNs(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+void ACT_Posix_sleepUs(uint64_t us)
+{
+  struct timespec ts = {.tv_sec = us / 1000000u, .tv_nsec = (us % 1000000u) * 1000u};
+  while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+  {
+  }
+}
+
+void ACT_Posix_semTake(sem_t *sem)
+{
+  while (sem_wait(sem) != 0 && errno == EINTR)
+  {
+  }
+}
+
+bool ACT_Posix_semTakeMs(sem_t *sem, uint32_t ms)
+{
+  // sem_timedwait only takes absolute real time
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  uint64_t ns = (uint64_t)ts.tv_nsec + (uint64_t)ms * 1000000u;
+  ts.tv_sec += (time_t)(ns / 1000000000u);
+  ts.tv_nsec = (long)(ns % 1000000000u);
+
+  int status;
+  while ((status = sem_timedwait(sem, &ts)) != 0 && errno == EINTR)
+  {
+  }
+  return status == 0;
+}
+
+/**
+ * @brief Queue
+ *
+ */
+
+void ACT_PosixQueue_init(ACT_PosixQueue *q, char *buf, size_t maxMsg)
+{
+  pthread_mutex_init(&q->lock, NULL);
+  pthread_cond_init(&q->notEmpty, NULL);
+  q->buf = (ACT_QEntry *)buf;
+  q->maxMsg = maxMsg;
+  q->head = 0;
+  q->used = 0;
+}
+
+int ACT_PosixQueue_put(ACT_PosixQueue *q, ACT_QEntry const *entry)
+{
+  int status = -ENOMSG;
+
+  pthread_mutex_lock(&q->lock);
+  if (q->used < q->maxMsg)
+  {
+    q->buf[(q->head + q->used) % q->maxMsg] = *entry;
+    q->used++;
+    status = 0;
+    pthread_cond_signal(&q->notEmpty);
+  }
+  pthread_mutex_unlock(&q->lock);
+
+  return status;
+}
+
+int ACT_PosixQueue_get(ACT_PosixQueue *q, ACT_QEntry *entry)
+{
+  pthread_mutex_lock(&q->lock);
+  while (q->used == 0)
+  {
+    pthread_cond_wait(&q->notEmpty, &q->lock);
+  }
+  *entry = q->buf[q->head];
+  q->head = (q->head + 1) % q->maxMsg;
+  q->used--;
+  pthread_mutex_unlock(&q->lock);
+
+  return 0;
+}
+
+size_t ACT_PosixQueue_getUsed(ACT_PosixQueue *q)
+{
+  pthread_mutex_lock(&q->lock);
+  size_t used = q->used;
+  pthread_mutex_unlock(&q->lock);
+
+  return used;
+}
+
+/**
+ * @brief Timers. Armed timers are kept in a list sorted by expiry time, served by one timer thread.
+ *
+ */
+
+static pthread_mutex_t timerLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t timerCond;
+static pthread_cond_t timerDoneCond;
+static pthread_once_t timerOnce = PTHREAD_ONCE_INIT;
+static pthread_t timerThread;
+static ACT_PosixTimer *timerList;
+static ACT_PosixTimer *timerRunning; // Timer whose expiry function is being called
+
+static void ACT_PosixTimer_insert(ACT_PosixTimer *t)
+{
+  ACT_PosixTimer **pp = &timerList;
+  while (*pp != NULL && (*pp)->expiryNs <= t->expiryNs)
+  {
+    pp = &(*pp)->next;
+  }
+  t->next = *pp;
+  *pp = t;
+}
+
+static void ACT_PosixTimer_remove(ACT_PosixTimer *t)
+{
+  for (ACT_PosixTimer **pp = &timerList; *pp != NULL; pp = &(*pp)->next)
+  {
+    if (*pp == t)
+    {
+      *pp = t->next;
+      break;
+    }
+  }
+}
+
+static void *ACT_PosixTimer_threadFn(void *arg)
+{
+  ACT_ARG_UNUSED(arg);
+
+  pthread_mutex_lock(&timerLock);
+  while (1)
+  {
+    if (timerList == NULL)
+    {
+      pthread_cond_wait(&timerCond, &timerLock);
+      continue;
+    }
+
+    ACT_PosixTimer *t = timerList;
+    if (t->expiryNs > ACT_Posix_nowNs())
+    {
+      struct timespec ts = {.tv_sec = t->expiryNs / 1000000000u, .tv_nsec = t->expiryNs % 1000000000u};
+      pthread_cond_timedwait(&timerCond, &timerLock, &ts);
+      continue;
+    }
+
+    timerList = t->next;
+    if (t->periodNs != 0)
+    {
+      t->expiryNs += t->periodNs;
+      ACT_PosixTimer_insert(t);
+    }
+    else
+    {
+      t->armed = false;
+    }
+
+    // Call expiry function without lock, so it can start and stop timers
+    timerRunning = t;
+    pthread_mutex_unlock(&timerLock);
+    t->expiryFn(t);
+    pthread_mutex_lock(&timerLock);
+    timerRunning = NULL;
+    pthread_cond_broadcast(&timerDoneCond);
+  }
+
+  return NULL;
+}
+
+static void ACT_PosixTimer_serviceInit(void)
+{
+  pthread_condattr_t attr;
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_cond_init(&timerCond, &attr);
+  pthread_cond_init(&timerDoneCond, NULL);
+  pthread_condattr_destroy(&attr);
+
+  pthread_create(&timerThread, NULL, ACT_PosixTimer_threadFn, NULL);
+}
+
+void ACT_PosixTimer_init(ACT_PosixTimer *t, void (*expiryFn)(ACT_PosixTimer *))
+{
+  pthread_once(&timerOnce, ACT_PosixTimer_serviceInit);
+
+  t->expiryFn = expiryFn;
+  t->param = NULL;
+  t->armed = false;
+  t->next = NULL;
+}
+
+void ACT_PosixTimer_start(ACT_PosixTimer *t, uint64_t durationMs, uint64_t periodMs)
+{
+  pthread_mutex_lock(&timerLock);
+  if (t->armed)
+  {
+    ACT_PosixTimer_remove(t);
+  }
+  t->expiryNs = ACT_Posix_nowNs() + durationMs * 1000000u;
+  t->periodNs = periodMs * 1000000u;
+  t->armed = true;
+  ACT_PosixTimer_insert(t);
+  pthread_cond_signal(&timerCond);
+  pthread_mutex_unlock(&timerLock);
+}
+
+void ACT_PosixTimer_stop(ACT_PosixTimer *t)
+{
+  pthread_mutex_lock(&timerLock);
+  if (t->armed)
+  {
+    ACT_PosixTimer_remove(t);
+    t->armed = false;
+  }
+
+  // Like stopping a timer from a thread in an RTOS, wait for a concurrently running expiry to complete
+  while (timerRunning == t && !pthread_equal(pthread_self(), timerThread))
+  {
+    pthread_cond_wait(&timerDoneCond, &timerLock);
+  }
+  pthread_mutex_unlock(&timerLock);
+}
+
+#endif /* ACT_CFG_PORT_SIM, __ZEPHYR__, __unix__ */
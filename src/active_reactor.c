@@ -0,0 +1,161 @@
+#include <active.h>
+
+#if ACT_CFG_REACTOR == 1
+
+#include <errno.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+static uint32_t ACT_Reactor_events(ACT_ReactorWatch const *w)
+{
+  // Level triggered watches are disarmed on readiness, so the owner is not posted to while doing its I/O
+  return w->interest | (w->edge ? EPOLLET : EPOLLONESHOT);
+}
+
+static void *ACT_Reactor_thread(void *arg)
+{
+  ACT_Reactor *r = (ACT_Reactor *)arg;
+  struct epoll_event evs[ACT_CFG_REACTOR_BATCH];
+
+  while (atomic_load(&r->running))
+  {
+    int n = epoll_wait(r->epfd, evs, ACT_CFG_REACTOR_BATCH, -1);
+    if (n < 0)
+    {
+      ACT_ASSERT(errno == EINTR, "epoll_wait failed. Error: %i", errno);
+      continue;
+    }
+
+    atomic_fetch_add_explicit(&r->waits, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&r->events, (unsigned int)n, memory_order_relaxed);
+
+    for (int i = 0; i < n; i++)
+    {
+      ACT_ReactorWatch *w = evs[i].data.ptr;
+      if (w == NULL)
+      {
+        // Stop event
+        continue;
+      }
+
+      // Post only when the owner has taken all earlier readiness, later readiness is taken with it
+      if (atomic_fetch_or(&w->pending, evs[i].events) == 0)
+      {
+        atomic_fetch_add_explicit(&r->posts, 1, memory_order_relaxed);
+        ACT_postEvt(w->owner, EVT_UPCAST(&w->ready));
+      }
+    }
+  }
+
+  return NULL;
+}
+
+int ACT_Reactor_init(ACT_Reactor *r)
+{
+  ACT_ASSERT(r != NULL, "Reactor is NULL");
+
+  r->epfd = epoll_create1(EPOLL_CLOEXEC);
+  if (r->epfd < 0)
+  {
+    return ACT_REACTOR_ERR_OPEN;
+  }
+
+  r->stopFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  struct epoll_event ev = {.events = EPOLLIN, .data.ptr = NULL};
+  if (r->stopFd < 0 || epoll_ctl(r->epfd, EPOLL_CTL_ADD, r->stopFd, &ev) != 0)
+  {
+    if (r->stopFd >= 0)
+    {
+      close(r->stopFd);
+    }
+    close(r->epfd);
+    return ACT_REACTOR_ERR_OPEN;
+  }
+
+  atomic_init(&r->running, false);
+  atomic_init(&r->waits, 0);
+  atomic_init(&r->events, 0);
+  atomic_init(&r->posts, 0);
+  return ACT_REACTOR_OK;
+}
+
+int ACT_Reactor_start(ACT_Reactor *r)
+{
+  ACT_ASSERT(r != NULL && r->epfd >= 0, "Reactor is not initialized");
+
+  atomic_store(&r->running, true);
+  if (pthread_create(&r->thread, NULL, ACT_Reactor_thread, r) != 0)
+  {
+    atomic_store(&r->running, false);
+    return ACT_REACTOR_ERR_THREAD;
+  }
+  return ACT_REACTOR_OK;
+}
+
+void ACT_Reactor_stop(ACT_Reactor *r)
+{
+  ACT_ASSERT(r != NULL && r->epfd >= 0, "Reactor is not initialized");
+
+  if (atomic_exchange(&r->running, false))
+  {
+    uint64_t one = 1;
+    ssize_t written = write(r->stopFd, &one, sizeof(one));
+    ACT_ARG_UNUSED(written);
+    pthread_join(r->thread, NULL);
+  }
+
+  close(r->stopFd);
+  close(r->epfd);
+  r->epfd = -1;
+}
+
+int ACT_Reactor_add(ACT_Reactor *r, ACT_ReactorWatch *w, int fd, uint32_t interest, bool edge, Active const *owner,
+                    uint16_t header)
+{
+  ACT_ASSERT(r != NULL && r->epfd >= 0, "Reactor is not initialized");
+  ACT_ASSERT(w != NULL && owner != NULL, "Watch or owner is NULL");
+
+  ACT_Message_init(&w->ready, owner, header, w, 0);
+  w->reactor = r;
+  w->owner = owner;
+  w->fd = fd;
+  w->interest = interest;
+  w->edge = edge;
+  atomic_init(&w->pending, 0);
+
+  struct epoll_event ev = {.events = ACT_Reactor_events(w), .data.ptr = w};
+  return epoll_ctl(r->epfd, EPOLL_CTL_ADD, fd, &ev) == 0 ? ACT_REACTOR_OK : ACT_REACTOR_ERR_FD;
+}
+
+int ACT_Reactor_remove(ACT_ReactorWatch *w)
+{
+  return epoll_ctl(w->reactor->epfd, EPOLL_CTL_DEL, w->fd, NULL) == 0 ? ACT_REACTOR_OK : ACT_REACTOR_ERR_FD;
+}
+
+uint32_t ACT_ReactorWatch_take(ACT_ReactorWatch *w)
+{
+  return atomic_exchange(&w->pending, 0);
+}
+
+int ACT_ReactorWatch_rearm(ACT_ReactorWatch *w)
+{
+  if (w->edge)
+  {
+    return ACT_REACTOR_OK;
+  }
+
+  struct epoll_event ev = {.events = ACT_Reactor_events(w), .data.ptr = w};
+  return epoll_ctl(w->reactor->epfd, EPOLL_CTL_MOD, w->fd, &ev) == 0 ? ACT_REACTOR_OK : ACT_REACTOR_ERR_FD;
+}
+
+ACT_ReactorStats ACT_Reactor_getStats(ACT_Reactor *r)
+{
+  ACT_ReactorStats stats = {
+      .waits = atomic_load_explicit(&r->waits, memory_order_relaxed),
+      .events = atomic_load_explicit(&r->events, memory_order_relaxed),
+      .posts = atomic_load_explicit(&r->posts, memory_order_relaxed),
+  };
+  return stats;
+}
+
+#endif /* ACT_CFG_REACTOR == 1 */
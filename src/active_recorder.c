@@ -0,0 +1,92 @@
+#include <string.h>
+
+#include <active.h>
+
+#if ACT_CFG_RECORDER == 1
+
+_Static_assert((ACT_CFG_RECORDER_LEN & (ACT_CFG_RECORDER_LEN - 1)) == 0, "ACT_CFG_RECORDER_LEN must be a power of 2");
+
+static ACT_Record records[ACT_CFG_RECORDER_LEN];
+static atomic_uint next; // Index of next record, not wrapped
+static atomic_bool frozen;
+
+static inline void ACT_Recorder_write(ACT_RecKind kind, Active const *const me, ACT_Evt const *const e, uint8_t type, uint16_t sig)
+{
+  if (atomic_load_explicit(&frozen, memory_order_relaxed))
+  {
+    return;
+  }
+
+  // A slot is claimed before it is written, so concurrent posts from ISRs and threads do not share a slot
+  unsigned int idx = atomic_fetch_add_explicit(&next, 1, memory_order_relaxed) & (ACT_CFG_RECORDER_LEN - 1u);
+  ACT_Record *rec = &records[idx];
+  rec->cycles = ACT_CYCLES_GET();
+  rec->me = me;
+  rec->e = e;
+  rec->sig = sig;
+  rec->type = type;
+  rec->kind = (uint8_t)kind;
+}
+
+void ACT_Recorder_add(ACT_RecKind kind, Active const *const me, ACT_Evt const *const e)
+{
+  uint16_t sig = 0;
+  uint8_t type = ACT_UNUSED;
+
+  if (e != NULL)
+  {
+    type = (uint8_t)e->type;
+    if (e->type == ACT_SIGNAL)
+    {
+      sig = EVT_CAST(e, ACT_Signal)->sig;
+    }
+    else if (e->type == ACT_MESSAGE)
+    {
+      sig = EVT_CAST(e, ACT_Message)->header;
+    }
+  }
+
+  ACT_Recorder_write(kind, me, e, type, sig);
+}
+
+void ACT_Recorder_addType(ACT_RecKind kind, Active const *const me, ACT_Evt const *const e, ACT_EvtType type)
+{
+  ACT_Recorder_write(kind, me, e, (uint8_t)type, 0);
+}
+
+size_t ACT_Recorder_copy(ACT_Record *out, size_t maxRecords)
+{
+  unsigned int end = atomic_load(&next);
+  size_t num = end < ACT_CFG_RECORDER_LEN ? end : ACT_CFG_RECORDER_LEN;
+  if (num > maxRecords)
+  {
+    num = maxRecords;
+  }
+
+  for (size_t i = 0; i < num; i++)
+  {
+    out[i] = records[(end - num + i) & (ACT_CFG_RECORDER_LEN - 1u)];
+  }
+  return num;
+}
+
+void ACT_Recorder_freeze(void)
+{
+  atomic_store(&frozen, true);
+}
+
+void ACT_Recorder_reset(void)
+{
+  atomic_store(&frozen, true);
+  memset(records, 0, sizeof(records));
+  atomic_store(&next, 0);
+  atomic_store(&frozen, false);
+}
+
+ACT_Record const *ACT_Recorder_get(uint32_t *nextRecord)
+{
+  *nextRecord = atomic_load(&next) & (ACT_CFG_RECORDER_LEN - 1u);
+  return records;
+}
+
+#endif /* ACT_CFG_RECORDER == 1 */
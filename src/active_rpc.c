@@ -0,0 +1,242 @@
+#include <stddef.h>
+#include <string.h>
+
+#include <active.h>
+
+#if ACT_CFG_RPC == 1
+
+_Static_assert(ACT_CFG_RPC_MAX_PENDING >= 1 && ACT_CFG_RPC_MAX_PENDING <= 32, "ACT_CFG_RPC_MAX_PENDING must be 1 to 32");
+
+/* Correlation ID: bit 15 marks replies and time outs, bits 14-8 slot generation, bits 7-0 slot index + 1 */
+#define RPC_REPLY 0x8000u
+#define RPC_ID_MASK 0x7FFFu
+#define RPC_SLOT(id) (&slots[((id) & 0xFFu) - 1u])
+
+#define RPC_ALL_SLOTS (ACT_CFG_RPC_MAX_PENDING == 32 ? 0xFFFFFFFFu : ((1u << ACT_CFG_RPC_MAX_PENDING) - 1u))
+
+/* The correlation ID is stored in requests and replies, so they must be dynamic and not posted before */
+#define RPC_ASSERT_NEW(e, what)                                            \
+  ACT_ASSERT((e)->_dynamic && atomic_load((refCnt_t *)&(e)->_refcnt) == 0, \
+             what " must be a new dynamic event, as its correlation ID is stored in it")
+
+/* Pending request. The answer (reply or time out) goes to whoever clears pending first */
+typedef struct active_rpcSlot
+{
+  atomic_ushort pending;   // Correlation ID while waiting for an answer, 0 when answered
+  uint16_t corrId;         // Correlation ID of the request
+  uint8_t gen;             // Generation, to tell late replies to a previous request in the slot
+  uint8_t settled;         // Answer dispatched and time event settled. Freed at 2. Only used by the requester
+  Active const *requester; // Requesting Active object, NULL for ACT_call
+  ACT_TimEvt timeout;      // Time out, processed by the requester
+  ACT_Signal timeoutSig;   // Dispatched to the requester on time out
+  ACT_Evt const *reply;    // Reply to ACT_call
+  ACT_SEM(done);           // Given when ACT_call gets a reply
+} ACT_RpcSlot;
+
+static ACT_RpcSlot slots[ACT_CFG_RPC_MAX_PENDING];
+static atomic_uint usedSlots; // Bit per slot in use
+
+static const ACT_SIGNAL_DEFINE(timeoutSignal, ACT_TIMEOUT_SIG);
+
+/* Marks time events of pending requests. Never called, they are processed by ACT_Rpc_process */
+static ACT_Evt *ACT_Rpc_expiry(ACT_TimEvt const *const te)
+{
+  ACT_ARG_UNUSED(te);
+  return NULL;
+}
+
+static ACT_RpcSlot *ACT_Rpc_alloc(Active const *const requester)
+{
+  unsigned int used = atomic_load(&usedSlots);
+  unsigned int idx;
+
+  do
+  {
+    unsigned int free = ~used & RPC_ALL_SLOTS;
+    if (free == 0)
+    {
+      return NULL;
+    }
+    idx = (unsigned int)__builtin_ctz(free);
+  } while (!atomic_compare_exchange_weak(&usedSlots, &used, used | (1u << idx)));
+
+  ACT_RpcSlot *slot = &slots[idx];
+  slot->gen = (uint8_t)((slot->gen + 1u) & 0x7Fu);
+  slot->corrId = (uint16_t)((slot->gen << 8) | (idx + 1u));
+  slot->settled = 0;
+  slot->requester = requester;
+  slot->reply = NULL;
+  atomic_store(&slot->pending, slot->corrId);
+
+  return slot;
+}
+
+static void ACT_Rpc_free(ACT_RpcSlot *slot)
+{
+  atomic_fetch_and(&usedSlots, ~(1u << (unsigned int)(slot - slots)));
+}
+
+static void ACT_Rpc_settle(ACT_RpcSlot *slot)
+{
+  if (++slot->settled == 2)
+  {
+    ACT_Rpc_free(slot);
+  }
+}
+
+/* Take the answer of a pending request. False if already answered */
+static bool ACT_Rpc_answer(ACT_RpcSlot *slot, uint16_t corrId)
+{
+  unsigned short expected = corrId;
+  return atomic_compare_exchange_strong(&slot->pending, &expected, 0);
+}
+
+int ACT_request(Active const *const receiver, ACT_Evt const *const e, uint32_t timeoutMs)
+{
+  ACT_ASSERT(receiver != NULL, "Receiver is null");
+  ACT_ASSERT(e != NULL, "ACT_Evt object is null");
+
+  RPC_ASSERT_NEW(e, "Request");
+
+  Active const *requester = ACT_EVT_SENDER(e);
+  ACT_ASSERT(requester != NULL, "Request has no sender to reply to");
+
+  ACT_RpcSlot *slot = ACT_Rpc_alloc(requester);
+  if (slot == NULL)
+  {
+    // Free the request nobody will receive
+    ACT_mem_refinc(e);
+    ACT_mem_refdec(e);
+    return ACT_RPC_ERR_FULL;
+  }
+
+  // Time out signal appears to be sent by the receiver that did not reply
+  memcpy(&slot->timeoutSig, &timeoutSignal, sizeof(slot->timeoutSig));
+  ACT_Evt *te = EVT_UPCAST(&slot->timeoutSig);
+  te->_sender = ACT_SENDER_REF(receiver);
+  te->_corrId = slot->corrId | RPC_REPLY;
+
+  ACT_TimEvt_init(&slot->timeout, requester, NULL, requester, ACT_Rpc_expiry);
+  ACT_TimeEvt_start(&slot->timeout, timeoutMs, 0);
+
+  ACT_postEvtCorr(receiver, e, slot->corrId);
+
+  return slot->corrId;
+}
+
+int ACT_reply(ACT_Evt const *const request, ACT_Evt const *const reply)
+{
+  ACT_ASSERT(request != NULL && reply != NULL, "Request or reply is null");
+
+  uint16_t corrId = request->_corrId & RPC_ID_MASK;
+  if (corrId == ACT_CORR_NONE)
+  {
+    return ACT_postEvt(ACT_EVT_SENDER(request), reply);
+  }
+  RPC_ASSERT_NEW(reply, "Reply");
+
+  ACT_RpcSlot *slot = RPC_SLOT(corrId);
+  if (!ACT_Rpc_answer(slot, corrId))
+  {
+    // Timed out. Free a dynamic reply nobody will receive
+    ACT_mem_refinc(reply);
+    ACT_mem_refdec(reply);
+    return ACT_RPC_ERR_STALE;
+  }
+
+  // The slot is not freed before the requester got the reply
+  if (slot->requester == NULL)
+  {
+    ACT_mem_refinc(reply);
+    slot->reply = reply;
+    ACT_SEM_GIVE(&slot->done);
+    return ACT_RPC_OK;
+  }
+
+  return ACT_postEvtCorr(slot->requester, reply, corrId | RPC_REPLY);
+}
+
+int ACT_call(Active const *const receiver, ACT_Evt const *const e, uint32_t timeoutMs, ACT_Evt const **reply)
+{
+  ACT_ASSERT(receiver != NULL, "Receiver is null");
+  ACT_ASSERT(e != NULL && reply != NULL, "ACT_Evt object or reply is null");
+  RPC_ASSERT_NEW(e, "Request");
+
+  ACT_RpcSlot *slot = ACT_Rpc_alloc(NULL);
+  if (slot == NULL)
+  {
+    // Free the request nobody will receive
+    ACT_mem_refinc(e);
+    ACT_mem_refdec(e);
+    return ACT_RPC_ERR_FULL;
+  }
+
+  ACT_SEM_INIT(&slot->done);
+  ACT_postEvtCorr(receiver, e, slot->corrId);
+
+  if (!ACT_SEM_TAKE_MS(&slot->done, timeoutMs))
+  {
+    if (ACT_Rpc_answer(slot, slot->corrId))
+    {
+      ACT_Rpc_free(slot);
+      return ACT_RPC_ERR_TIMEOUT;
+    }
+    // Reply was taken just before the time out and is given right away
+    ACT_SEM_TAKE(&slot->done);
+  }
+
+  *reply = slot->reply;
+  ACT_Rpc_free(slot);
+  return ACT_RPC_OK;
+}
+
+uint16_t ACT_getCorrId(ACT_Evt const *const e)
+{
+  return e->_corrId & RPC_ID_MASK;
+}
+
+bool ACT_Rpc_process(Active *const me, ACT_Evt const *const e)
+{
+  ACT_RpcSlot *slot;
+
+  if (e->type == ACT_TIMEVT)
+  {
+    ACT_TimEvt const *te = EVT_CAST(e, ACT_TimEvt);
+    if (te->expFn != ACT_Rpc_expiry)
+    {
+      return false;
+    }
+
+    slot = (ACT_RpcSlot *)((char *)te - offsetof(ACT_RpcSlot, timeout));
+    if (ACT_Rpc_answer(slot, slot->corrId))
+    {
+      // Timed out. A late reply is dropped by ACT_reply
+      me->dispatch(me, EVT_UPCAST(&slot->timeoutSig));
+      ACT_Rpc_settle(slot);
+    }
+    // Time event settled. If the reply came first, it settled the answer
+    ACT_Rpc_settle(slot);
+    return true;
+  }
+
+  if ((e->_corrId & RPC_REPLY) == 0)
+  {
+    return false;
+  }
+
+  slot = RPC_SLOT(e->_corrId & RPC_ID_MASK);
+
+  // Stop the time out. If it expired, its time event is on the way and settles the timer when processed
+  bool stopped = ACT_TimeEvt_stop(&slot->timeout) && slot->timeout.timer.sync;
+
+  me->dispatch(me, e);
+
+  if (stopped)
+  {
+    ACT_Rpc_settle(slot);
+  }
+  ACT_Rpc_settle(slot);
+  return true;
+}
+
+#endif /* ACT_CFG_RPC == 1 */
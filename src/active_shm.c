@@ -0,0 +1,446 @@
+#include <active.h>
+
+#if ACT_CFG_SHM == 1
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+_Static_assert((ACT_CFG_SHM_RING_SIZE & (ACT_CFG_SHM_RING_SIZE - 1)) == 0, "ACT_CFG_SHM_RING_SIZE must be a power of two");
+_Static_assert(ACT_CFG_SHM_MAX_PORTS < ACT_SHM_PORT_NONE, "ACT_CFG_SHM_MAX_PORTS too large");
+_Static_assert(ATOMIC_INT_LOCK_FREE == 2, "Shared memory rings require lock-free atomics");
+
+#define SHM_MAGIC 0x41435431u /* "ACT1" */
+
+/* Poll interval of the bridge thread while received messages are still being processed */
+#define SHM_RELEASE_POLL_NS 200000L
+/* Max sleep of an idle bridge thread, bounds the time to close a link */
+#define SHM_IDLE_POLL_NS 100000000L
+
+/* Record in a ring. Followed by payload, padded to a multiple of the record size */
+typedef struct active_shmRecord
+{
+  uint32_t len;        // Record length incl. header and padding
+  uint16_t sig;        // Signal (ACT_Signal) or header (ACT_Message)
+  uint16_t payloadLen; // Message payload length
+  uint8_t type;        // ACT_SIGNAL or ACT_MESSAGE. ACT_UNUSED for padding up to the end of the ring
+  uint8_t dstPort;     // Port of receiver in the receiving process
+  uint8_t srcPort;     // Port of sender in the sending process, ACT_SHM_PORT_NONE if not bound
+  uint8_t reserved[5];
+} ACT_ShmRecord;
+
+_Static_assert(sizeof(ACT_ShmRecord) == 16, "ACT_ShmRecord type is not the right size.");
+
+#define SHM_RECORD_LEN(payloadLen) \
+  ((uint32_t)(sizeof(ACT_ShmRecord) + (((size_t)(payloadLen) + sizeof(ACT_ShmRecord) - 1) & ~(sizeof(ACT_ShmRecord) - 1))))
+
+/* Producer and consumer positions are free running byte counters, on separate cache lines */
+struct active_shmRing
+{
+  _Alignas(64) atomic_uint head; // Bytes published by the producer. Futex word the consumer sleeps on
+  atomic_uint waiting;           // Set by the consumer before sleeping, producer wakes it when set
+  _Alignas(64) atomic_uint tail; // Bytes released by the consumer
+  _Alignas(64) char data[ACT_CFG_SHM_RING_SIZE];
+};
+
+struct active_shmSegment
+{
+  atomic_uint magic; // SHM_MAGIC when initialized by side 0
+  uint32_t ringSize; // ACT_CFG_SHM_RING_SIZE of side 0
+  ACT_ShmRing ring[2];
+};
+
+static void ACT_Shm_futexWait(atomic_uint *word, uint32_t val, long ns)
+{
+  struct timespec ts = {.tv_sec = ns / 1000000000L, .tv_nsec = ns % 1000000000L};
+  // Not FUTEX_PRIVATE: the word is shared between processes
+  syscall(SYS_futex, (uint32_t *)word, FUTEX_WAIT, val, &ts, NULL, 0);
+}
+
+static void ACT_Shm_futexWake(atomic_uint *word)
+{
+  syscall(SYS_futex, (uint32_t *)word, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+int ACT_ShmLink_open(ACT_ShmLink *link, char const *name, int side)
+{
+  ACT_ASSERT(link != NULL && name != NULL, "Link or name is NULL");
+  ACT_ASSERT(side == 0 || side == 1, "Side must be 0 or 1");
+  ACT_ASSERT(strlen(name) < sizeof(link->name), "Shared memory name too long");
+
+  memset(link, 0, sizeof(*link));
+  strcpy(link->name, name);
+  link->side = side;
+
+  int fd;
+  if (side == 0)
+  {
+    // Remove a segment left by a previous run, so the peer never sees stale ring positions
+    shm_unlink(name);
+    fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0 || ftruncate(fd, sizeof(ACT_ShmSegment)) != 0)
+    {
+      if (fd >= 0)
+      {
+        close(fd);
+      }
+      return ACT_SHM_ERR_OPEN;
+    }
+  }
+  else
+  {
+    struct stat st;
+    fd = shm_open(name, O_RDWR, 0600);
+    if (fd < 0)
+    {
+      return ACT_SHM_ERR_OPEN;
+    }
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size != sizeof(ACT_ShmSegment))
+    {
+      close(fd);
+      return ACT_SHM_ERR_LAYOUT;
+    }
+  }
+
+  void *mem = mmap(NULL, sizeof(ACT_ShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mem == MAP_FAILED)
+  {
+    return ACT_SHM_ERR_OPEN;
+  }
+  link->seg = (ACT_ShmSegment *)mem;
+
+  if (side == 0)
+  {
+    // ftruncate zero fills the rings
+    link->seg->ringSize = ACT_CFG_SHM_RING_SIZE;
+    atomic_store_explicit(&link->seg->magic, SHM_MAGIC, memory_order_release);
+  }
+  else if (atomic_load_explicit(&link->seg->magic, memory_order_acquire) != SHM_MAGIC ||
+           link->seg->ringSize != ACT_CFG_SHM_RING_SIZE)
+  {
+    munmap(mem, sizeof(ACT_ShmSegment));
+    link->seg = NULL;
+    return ACT_SHM_ERR_LAYOUT;
+  }
+
+  link->tx = &link->seg->ring[side];
+  link->rx = &link->seg->ring[1 - side];
+  link->rxPos = atomic_load(&link->rx->tail);
+  pthread_mutex_init(&link->txLock, NULL);
+
+  return ACT_SHM_OK;
+}
+
+void ACT_ShmLink_bind(ACT_ShmLink *link, uint8_t port, Active *me)
+{
+  ACT_ASSERT(link != NULL && link->seg != NULL, "Link is not open");
+  ACT_ASSERT(port < ACT_CFG_SHM_MAX_PORTS, "Port out of range. Increase ACT_CFG_SHM_MAX_PORTS");
+  ACT_ASSERT(me != NULL && me->_post == NULL, "Only local Active objects can be bound");
+
+  link->bound[port] = me;
+}
+
+static uint8_t ACT_ShmLink_portOf(ACT_ShmLink const *link, Active const *me)
+{
+  for (uint8_t port = 0; me != NULL && port < ACT_CFG_SHM_MAX_PORTS; port++)
+  {
+    if (link->bound[port] == me)
+    {
+      return port;
+    }
+  }
+  return ACT_SHM_PORT_NONE;
+}
+
+/* Release ring space of received messages that all receivers have processed, in ring order */
+static void ACT_ShmLink_release(ACT_ShmLink *link)
+{
+  uint32_t released = 0;
+  bool any = false;
+
+  while (link->inflightCount > 0)
+  {
+    ACT_Evt const *e = link->inflight[link->inflightHead];
+    // Only the bridge's reference is left when processed
+    if (ACT_mem_getRefCount(e) > 1)
+    {
+      break;
+    }
+    ACT_mem_refdec(e);
+    released = link->inflightEnd[link->inflightHead];
+    any = true;
+    link->inflightHead = (link->inflightHead + 1) % ACT_CFG_SHM_INFLIGHT;
+    link->inflightCount--;
+  }
+
+  if (link->inflightCount == 0)
+  {
+    atomic_store_explicit(&link->rx->tail, link->rxPos, memory_order_release);
+  }
+  else if (any)
+  {
+    atomic_store_explicit(&link->rx->tail, released, memory_order_release);
+  }
+}
+
+/* Turn the next record in the receive ring into an event and post it */
+static void ACT_ShmLink_receive(ACT_ShmLink *link)
+{
+  uint32_t pos = link->rxPos & (ACT_CFG_SHM_RING_SIZE - 1);
+  ACT_ShmRecord const *rec = (ACT_ShmRecord const *)&link->rx->data[pos];
+
+  ACT_ASSERT(rec->len >= sizeof(ACT_ShmRecord) && rec->len <= ACT_CFG_SHM_RING_SIZE - pos &&
+                 (rec->len & (sizeof(ACT_ShmRecord) - 1)) == 0,
+             "Corrupt shared memory record");
+  link->rxPos += rec->len;
+
+  if (rec->type == ACT_UNUSED)
+  {
+    return;
+  }
+
+  Active *receiver = rec->dstPort < ACT_CFG_SHM_MAX_PORTS ? link->bound[rec->dstPort] : NULL;
+  if (receiver == NULL)
+  {
+    atomic_fetch_add_explicit(&link->unbound, 1, memory_order_relaxed);
+    return;
+  }
+
+  // Replies to the proxy of the sending port go back over the link
+  Active const *sender = receiver;
+  if (rec->srcPort < ACT_CFG_SHM_MAX_PORTS && link->proxies[rec->srcPort] != NULL)
+  {
+    sender = &link->proxies[rec->srcPort]->super;
+  }
+
+  if (rec->type == ACT_SIGNAL)
+  {
+    ACT_postEvt(receiver, EVT_UPCAST(ACT_Signal_new(sender, rec->sig)));
+  }
+  else if (rec->payloadLen == 0)
+  {
+    ACT_postEvt(receiver, EVT_UPCAST(ACT_Message_new(sender, rec->sig, NULL, 0)));
+  }
+  else
+  {
+    // Payload stays in the ring. Hold a reference to release the ring space when the message is processed
+    ACT_Evt const *e = EVT_UPCAST(ACT_Message_new(sender, rec->sig, (void *)(rec + 1), rec->payloadLen));
+    ACT_mem_refinc(e);
+    uint32_t idx = (link->inflightHead + link->inflightCount) % ACT_CFG_SHM_INFLIGHT;
+    link->inflight[idx] = e;
+    link->inflightEnd[idx] = link->rxPos;
+    link->inflightCount++;
+    ACT_postEvt(receiver, e);
+  }
+
+  atomic_fetch_add_explicit(&link->received, 1, memory_order_relaxed);
+}
+
+static void *ACT_ShmLink_bridge(void *arg)
+{
+  ACT_ShmLink *link = (ACT_ShmLink *)arg;
+  ACT_ShmRing *rx = link->rx;
+
+  while (atomic_load_explicit(&link->running, memory_order_relaxed))
+  {
+    ACT_ShmLink_release(link);
+
+    bool canReceive = link->inflightCount < ACT_CFG_SHM_INFLIGHT;
+    uint32_t head = atomic_load_explicit(&rx->head, memory_order_acquire);
+    if (canReceive && head != link->rxPos)
+    {
+      ACT_ShmLink_receive(link);
+      continue;
+    }
+
+    if (!canReceive)
+    {
+      struct timespec ts = {.tv_sec = 0, .tv_nsec = SHM_RELEASE_POLL_NS};
+      nanosleep(&ts, NULL);
+      continue;
+    }
+
+    // Announce sleep, then check again so a record published meanwhile is not missed
+    atomic_store(&rx->waiting, 1);
+    head = atomic_load(&rx->head);
+    if (head == link->rxPos)
+    {
+      ACT_Shm_futexWait(&rx->head, head, link->inflightCount > 0 ? SHM_RELEASE_POLL_NS : SHM_IDLE_POLL_NS);
+    }
+    atomic_store_explicit(&rx->waiting, 0, memory_order_relaxed);
+  }
+
+  return NULL;
+}
+
+int ACT_ShmLink_start(ACT_ShmLink *link)
+{
+  ACT_ASSERT(link != NULL && link->seg != NULL, "Link is not open");
+
+  atomic_store(&link->running, true);
+  if (pthread_create(&link->bridge, NULL, ACT_ShmLink_bridge, link) != 0)
+  {
+    atomic_store(&link->running, false);
+    return ACT_SHM_ERR_THREAD;
+  }
+  return ACT_SHM_OK;
+}
+
+void ACT_ShmLink_close(ACT_ShmLink *link)
+{
+  ACT_ASSERT(link != NULL && link->seg != NULL, "Link is not open");
+
+  if (atomic_exchange(&link->running, false))
+  {
+    ACT_Shm_futexWake(&link->rx->head);
+    pthread_join(link->bridge, NULL);
+  }
+
+  ACT_ShmLink_release(link);
+  ACT_ASSERT(link->inflightCount == 0, "Received messages are still being processed");
+
+  munmap(link->seg, sizeof(ACT_ShmSegment));
+  link->seg = NULL;
+  if (link->side == 0)
+  {
+    shm_unlink(link->name);
+  }
+  pthread_mutex_destroy(&link->txLock);
+}
+
+void ACT_ShmLink_getStats(ACT_ShmLink *link, ACT_ShmStats *stats)
+{
+  stats->sent = atomic_load(&link->sent);
+  stats->received = atomic_load(&link->received);
+  stats->full = atomic_load(&link->full);
+  stats->unbound = atomic_load(&link->unbound);
+}
+
+/* Reserve a record in the send ring with the send lock held. Returns NULL and unlocks if the ring is full */
+static ACT_ShmRecord *ACT_ShmProxy_reserve(ACT_ShmProxy *p, uint8_t type, uint16_t sig, uint16_t payloadLen)
+{
+  ACT_ShmLink *link = p->link;
+  ACT_ShmRing *tx = link->tx;
+  uint32_t len = SHM_RECORD_LEN(payloadLen);
+
+  ACT_ASSERT(len <= ACT_CFG_SHM_RING_SIZE / 2, "Message too large for shared memory ring");
+
+  pthread_mutex_lock(&link->txLock);
+
+  // Only this process writes head
+  uint32_t head = atomic_load_explicit(&tx->head, memory_order_relaxed);
+  uint32_t tail = atomic_load_explicit(&tx->tail, memory_order_acquire);
+  uint32_t pos = head & (ACT_CFG_SHM_RING_SIZE - 1);
+  // Records are contiguous. Pad to the end of the ring if the record does not fit before it
+  uint32_t pad = (pos + len > ACT_CFG_SHM_RING_SIZE) ? ACT_CFG_SHM_RING_SIZE - pos : 0;
+
+  if (len + pad > ACT_CFG_SHM_RING_SIZE - (head - tail))
+  {
+    pthread_mutex_unlock(&link->txLock);
+    atomic_fetch_add_explicit(&link->full, 1, memory_order_relaxed);
+    return NULL;
+  }
+
+  if (pad > 0)
+  {
+    ACT_ShmRecord *padRec = (ACT_ShmRecord *)&tx->data[pos];
+    padRec->len = pad;
+    padRec->type = ACT_UNUSED;
+    pos = 0;
+  }
+
+  ACT_ShmRecord *rec = (ACT_ShmRecord *)&tx->data[pos];
+  rec->len = len;
+  rec->sig = sig;
+  rec->payloadLen = payloadLen;
+  rec->type = type;
+  rec->dstPort = p->port;
+
+  link->txRec = rec;
+  link->txNext = head + pad + len;
+  return rec;
+}
+
+void *ACT_ShmProxy_claim(ACT_ShmProxy *p, uint16_t header, uint16_t payloadLen)
+{
+  ACT_ASSERT(p != NULL && p->link != NULL, "Proxy is not initialized");
+
+  ACT_ShmRecord *rec = ACT_ShmProxy_reserve(p, ACT_MESSAGE, header, payloadLen);
+  return rec != NULL ? (void *)(rec + 1) : NULL;
+}
+
+int ACT_ShmProxy_commit(ACT_ShmProxy *p, Active const *const sender)
+{
+  ACT_ShmLink *link = p->link;
+  ACT_ShmRing *tx = link->tx;
+
+  ((ACT_ShmRecord *)link->txRec)->srcPort = ACT_ShmLink_portOf(link, sender);
+  atomic_store_explicit(&tx->head, link->txNext, memory_order_release);
+  pthread_mutex_unlock(&link->txLock);
+
+  // Pairs with the announce and check in the bridge thread
+  atomic_thread_fence(memory_order_seq_cst);
+  if (atomic_load_explicit(&tx->waiting, memory_order_relaxed) != 0)
+  {
+    ACT_Shm_futexWake(&tx->head);
+  }
+
+  atomic_fetch_add_explicit(&link->sent, 1, memory_order_relaxed);
+  return ACT_SHM_OK;
+}
+
+/* Post function of proxies, called by ACT_postEvt */
+static int ACT_ShmProxy_post(Active const *const receiver, ACT_Evt const *const e)
+{
+  ACT_ShmProxy *p = (ACT_ShmProxy *)receiver;
+  ACT_ShmRecord *rec;
+
+  if (e->type == ACT_SIGNAL)
+  {
+    rec = ACT_ShmProxy_reserve(p, ACT_SIGNAL, EVT_CAST(e, ACT_Signal)->sig, 0);
+  }
+  else
+  {
+    ACT_ASSERT(e->type == ACT_MESSAGE, "Only signals and messages can be posted to other processes");
+    ACT_Message const *m = EVT_CAST(e, ACT_Message);
+    uint16_t len = m->payload != NULL ? m->payloadLen : 0;
+    rec = ACT_ShmProxy_reserve(p, ACT_MESSAGE, m->header, len);
+    if (rec != NULL && len > 0)
+    {
+      memcpy(rec + 1, m->payload, len);
+    }
+  }
+
+  if (rec == NULL)
+  {
+    return ACT_SHM_ERR_FULL;
+  }
+  return ACT_ShmProxy_commit(p, ACT_EVT_SENDER(e));
+}
+
+void ACT_ShmProxy_init(ACT_ShmProxy *p, ACT_ShmLink *link, uint8_t port)
+{
+  ACT_ASSERT(p != NULL && link != NULL && link->seg != NULL, "Proxy is NULL or link is not open");
+  ACT_ASSERT(port < ACT_CFG_SHM_MAX_PORTS, "Port out of range. Increase ACT_CFG_SHM_MAX_PORTS");
+
+  memset(&p->super, 0, sizeof(p->super));
+  p->super._post = ACT_ShmProxy_post;
+  p->link = link;
+  p->port = port;
+
+#if ACT_ACTOR_REGISTRY == 1
+  // Proxies need a handle to be the sender of received events
+  ACT_register(&p->super);
+#endif
+
+  link->proxies[port] = p;
+}
+
+#endif /* ACT_CFG_SHM == 1 */
@@ -0,0 +1,82 @@
+#include <active.h>
+
+void ACT_Stream_init(ACT_Stream *s, Active const *producer, Active const *consumer, void *buf, uint32_t size,
+                     uint32_t threshold, uint16_t wakeSig)
+{
+  ACT_ASSERT(s != NULL, "Stream is NULL");
+  ACT_ASSERT(producer != NULL && consumer != NULL, "Stream producer or consumer is NULL");
+  ACT_ASSERT(buf != NULL, "Stream buffer is NULL");
+  ACT_ASSERT(size != 0 && (size & (size - 1)) == 0 && size <= (1u << 31), "Stream ring size must be a power of 2");
+  ACT_ASSERT(threshold > 0 && threshold <= size, "Stream threshold must be 1 to ring size");
+
+  s->buf = (uint8_t *)buf;
+  s->size = size;
+  s->threshold = threshold;
+  atomic_init(&s->head, 0);
+  atomic_init(&s->tail, 0);
+  s->reserved = 0;
+  atomic_init(&s->idle, true);
+  s->consumer = consumer;
+  ACT_Signal_init(&s->wakeSig, producer, wakeSig);
+  s->overruns = 0;
+}
+
+void *ACT_Stream_reserve(ACT_Stream *s, uint32_t *len)
+{
+  uint32_t head = atomic_load_explicit(&s->head, memory_order_relaxed);
+  uint32_t space = s->size - (head - atomic_load_explicit(&s->tail, memory_order_acquire));
+  uint32_t toEnd = s->size - (head & (s->size - 1));
+
+  s->reserved = space < toEnd ? space : toEnd;
+  *len = s->reserved;
+  if (s->reserved == 0)
+  {
+    s->overruns++;
+    return NULL;
+  }
+  return s->buf + (head & (s->size - 1));
+}
+
+void ACT_Stream_commit(ACT_Stream *s, uint32_t len)
+{
+  ACT_ASSERT(len <= s->reserved, "Committed more bytes than reserved");
+  s->reserved = 0;
+
+  uint32_t head = atomic_fetch_add(&s->head, len) + len;
+
+  // Wake the consumer if it waits for bytes. A busy consumer reads the bytes before going idle
+  if (head - atomic_load(&s->tail) >= s->threshold && atomic_load(&s->idle) && atomic_exchange(&s->idle, false))
+  {
+    ACT_postEvt(s->consumer, EVT_UPCAST(&s->wakeSig));
+  }
+}
+
+const void *ACT_Stream_peek(ACT_Stream *s, uint32_t *len)
+{
+  uint32_t tail = atomic_load_explicit(&s->tail, memory_order_relaxed);
+  uint32_t unread = atomic_load_explicit(&s->head, memory_order_acquire) - tail;
+
+  if (unread < s->threshold)
+  {
+    // Going idle. Set flag before checking again, so bytes committed in between either
+    // are seen here or make the producer post a new wake signal
+    atomic_store(&s->idle, true);
+    unread = atomic_load(&s->head) - tail;
+  }
+
+  uint32_t toEnd = s->size - (tail & (s->size - 1));
+  *len = unread < toEnd ? unread : toEnd;
+  return *len > 0 ? s->buf + (tail & (s->size - 1)) : NULL;
+}
+
+void ACT_Stream_consume(ACT_Stream *s, uint32_t len)
+{
+  ACT_ASSERT(len <= atomic_load_explicit(&s->head, memory_order_acquire) - atomic_load_explicit(&s->tail, memory_order_relaxed),
+             "Consumed more bytes than unread");
+  atomic_fetch_add_explicit(&s->tail, len, memory_order_release);
+}
+
+uint32_t ACT_Stream_getUnread(ACT_Stream *s)
+{
+  return atomic_load(&s->head) - atomic_load(&s->tail);
+}
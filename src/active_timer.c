@@ -14,6 +14,9 @@ static TimerType getTimerType(const ACT_Timer *const timer)
 // Runs in ISR context - called from underlying port/framework
 void ACT_Timer_expiryCB(ACT_TimEvt *const te)
 {
+#if ACT_CFG_RECORDER == 1
+  ACT_Recorder_add(ACT_REC_TIMER, ACT_EVT_SENDER(te), EVT_UPCAST(te));
+#endif
 
   // Post time event
   ACT_postTimEvt(te);
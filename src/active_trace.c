@@ -0,0 +1,284 @@
+#include <string.h>
+
+#include <active.h>
+
+#if ACT_CFG_TRACE == 1
+
+_Static_assert(sizeof(ACT_TraceRecord) == 12, "ACT_TraceRecord type is not the right size.");
+_Static_assert(ACT_CFG_TRACE_PAYLOAD_MAX <= UINT8_MAX, "ACT_CFG_TRACE_PAYLOAD_MAX too large");
+
+/* Record size incl. payload padded to 4 bytes, to keep records (and replayed payloads) aligned */
+#define TRACE_RECORD_SIZE(payloadLen) (sizeof(ACT_TraceRecord) + (((size_t)(payloadLen) + 3u) & ~(size_t)3u))
+
+static char *traceBuf;
+static size_t traceSize;
+static atomic_uint traceHead;
+static atomic_uint traceDropped;
+static atomic_bool recording;
+static uint64_t traceStartUs;
+
+static ACT_TraceStats stats[ACT_CFG_MAX_ACTORS];
+static atomic_uint maxDepth[ACT_CFG_MAX_ACTORS]; // Updated by posting contexts, not the processing Active object
+
+static ACT_Handle ACT_Trace_senderOf(ACT_Evt const *const e)
+{
+#if ACT_CFG_EVT_HANDLES == 1
+  return e->_sender;
+#else
+  return e->_sender != NULL ? e->_sender->_id : ACT_HANDLE_NONE;
+#endif
+}
+
+void ACT_Trace_start(void *buf, size_t size)
+{
+  ACT_ASSERT(buf != NULL, "Trace buffer is NULL");
+  ACT_ASSERT(((uintptr_t)buf & 3u) == 0, "Trace buffer must be aligned to 4 bytes");
+
+  atomic_store(&recording, false);
+
+  traceBuf = (char *)buf;
+  traceSize = size;
+  atomic_store(&traceHead, 0);
+  atomic_store(&traceDropped, 0);
+  traceStartUs = ACT_TIMEUS_GET();
+
+  atomic_store_explicit(&recording, true, memory_order_release);
+}
+
+void ACT_Trace_stop(void)
+{
+  atomic_store(&recording, false);
+}
+
+size_t ACT_Trace_getLen(void)
+{
+  return atomic_load(&traceHead);
+}
+
+uint32_t ACT_Trace_getDropped(void)
+{
+  return atomic_load(&traceDropped);
+}
+
+void ACT_Trace_post(Active const *const receiver, ACT_Evt const *const e)
+{
+  ACT_Handle id = receiver->_id;
+
+  if (id != ACT_HANDLE_NONE)
+  {
+    // Event is not queued yet
+    unsigned int depth = (unsigned int)ACT_Q_USED_GET(receiver->queue) + 1;
+    unsigned int max = atomic_load_explicit(&maxDepth[id - 1], memory_order_relaxed);
+    while (depth > max &&
+           !atomic_compare_exchange_weak_explicit(&maxDepth[id - 1], &max, depth, memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+  }
+
+  if (!atomic_load_explicit(&recording, memory_order_acquire))
+  {
+    return;
+  }
+
+  ACT_TraceRecord rec = {.timeUs = (uint32_t)(ACT_TIMEUS_GET() - traceStartUs),
+                         .sender = ACT_Trace_senderOf(e),
+                         .receiver = id,
+                         .sig = 0,
+                         .type = (uint8_t)e->type,
+                         .payloadLen = 0};
+  void const *payload = NULL;
+
+  if (e->type == ACT_SIGNAL)
+  {
+    rec.sig = EVT_CAST(e, ACT_Signal)->sig;
+  }
+  else if (e->type == ACT_MESSAGE)
+  {
+    ACT_Message const *m = EVT_CAST(e, ACT_Message);
+    rec.sig = m->header;
+    rec.payloadLen = (uint8_t)(m->payloadLen < ACT_CFG_TRACE_PAYLOAD_MAX ? m->payloadLen : ACT_CFG_TRACE_PAYLOAD_MAX);
+    payload = m->payload;
+    if (payload == NULL)
+    {
+      rec.payloadLen = 0;
+    }
+  }
+
+  // Reserve space for the record
+  size_t recSize = TRACE_RECORD_SIZE(rec.payloadLen);
+  unsigned int pos = atomic_load_explicit(&traceHead, memory_order_relaxed);
+  do
+  {
+    if (pos + recSize > traceSize)
+    {
+      atomic_fetch_add_explicit(&traceDropped, 1, memory_order_relaxed);
+      return;
+    }
+  } while (!atomic_compare_exchange_weak_explicit(&traceHead, &pos, pos + recSize, memory_order_relaxed, memory_order_relaxed));
+
+  memcpy(traceBuf + pos, &rec, sizeof(rec));
+  if (rec.payloadLen > 0)
+  {
+    memcpy(traceBuf + pos + sizeof(rec), payload, rec.payloadLen);
+  }
+}
+
+void ACT_Trace_process(Active const *const me)
+{
+  if (me->_id == ACT_HANDLE_NONE)
+  {
+    return;
+  }
+
+  uint32_t latencyUs = (uint32_t)(ACT_CYCLES_TO_NS((uint32_t)(ACT_CYCLES_GET() - me->_postedAt)) / 1000u);
+  ACT_TraceStats *s = &stats[me->_id - 1];
+
+  s->events++;
+  s->sumLatencyUs += latencyUs;
+  if (latencyUs > s->maxLatencyUs)
+  {
+    s->maxLatencyUs = latencyUs;
+  }
+
+  size_t bucket = 0;
+  while (bucket < ACT_TRACE_HIST_BUCKETS - 1 && latencyUs >= (1u << bucket))
+  {
+    bucket++;
+  }
+  s->hist[bucket]++;
+}
+
+uint32_t ACT_Trace_replay(void const *buf, size_t len, uint32_t speedup, ACT_TraceFilterFn filter)
+{
+  ACT_ASSERT(buf != NULL, "Trace buffer is NULL");
+
+  char const *p = (char const *)buf;
+  uint64_t startUs = ACT_TIMEUS_GET();
+  uint64_t traceUs = 0; // Unwrapped time of record since first record
+  uint32_t prevUs = 0;
+  uint32_t replayed = 0;
+  size_t pos = 0;
+  bool first = true;
+
+  while (pos + sizeof(ACT_TraceRecord) <= len)
+  {
+    ACT_TraceRecord rec;
+    memcpy(&rec, p + pos, sizeof(rec));
+    void const *payload = p + pos + sizeof(rec);
+
+    ACT_ASSERT(pos + TRACE_RECORD_SIZE(rec.payloadLen) <= len, "Trace record is truncated");
+    pos += TRACE_RECORD_SIZE(rec.payloadLen);
+
+    // Records from concurrent posts may be slightly out of order. Never step back in time
+    if (first)
+    {
+      prevUs = rec.timeUs;
+      first = false;
+    }
+    int32_t deltaUs = (int32_t)(rec.timeUs - prevUs);
+    if (deltaUs > 0)
+    {
+      traceUs += (uint32_t)deltaUs;
+      prevUs = rec.timeUs;
+    }
+
+    if ((rec.type != ACT_SIGNAL && rec.type != ACT_MESSAGE) || (filter != NULL && !filter(&rec)))
+    {
+      continue;
+    }
+
+    Active *receiver = ACT_fromHandle(rec.receiver);
+    if (receiver == NULL)
+    {
+      continue;
+    }
+    // Events sent from outside Active objects are replayed with the receiver as sender
+    Active *sender = ACT_fromHandle(rec.sender);
+    sender = (sender != NULL) ? sender : receiver;
+
+    if (speedup != 0)
+    {
+      uint64_t dueUs = startUs + traceUs / speedup;
+      uint64_t nowUs = ACT_TIMEUS_GET();
+      if (dueUs > nowUs)
+      {
+        ACT_SLEEPUS(dueUs - nowUs);
+      }
+    }
+
+    ACT_Evt *e;
+    if (rec.type == ACT_SIGNAL)
+    {
+      e = EVT_UPCAST(ACT_Signal_new(sender, rec.sig));
+    }
+    else
+    {
+      e = EVT_UPCAST(ACT_Message_new(sender, rec.sig, rec.payloadLen > 0 ? (void *)payload : NULL, rec.payloadLen));
+    }
+
+    ACT_postEvt(receiver, e);
+    replayed++;
+  }
+
+  return replayed;
+}
+
+void ACT_Trace_getStats(Active const *const me, ACT_TraceStats *s)
+{
+  ACT_ASSERT(me != NULL && me->_id != ACT_HANDLE_NONE, "Active object is not initialized");
+
+  *s = stats[me->_id - 1];
+  s->maxQueueDepth = atomic_load(&maxDepth[me->_id - 1]);
+}
+
+void ACT_Trace_resetStats(void)
+{
+  memset(stats, 0, sizeof(stats));
+  for (size_t i = 0; i < ACT_CFG_MAX_ACTORS; i++)
+  {
+    atomic_store(&maxDepth[i], 0);
+  }
+}
+
+/* Upper bound of latency percentile pct, from histogram */
+static uint32_t ACT_Trace_percentileUs(ACT_TraceStats const *s, uint32_t pct)
+{
+  uint32_t target = (uint32_t)(((uint64_t)s->events * pct + 99u) / 100u);
+  uint32_t count = 0;
+
+  for (size_t i = 0; i < ACT_TRACE_HIST_BUCKETS - 1; i++)
+  {
+    count += s->hist[i];
+    if (count >= target)
+    {
+      return (1u << i) < s->maxLatencyUs ? (1u << i) : s->maxLatencyUs;
+    }
+  }
+  return s->maxLatencyUs;
+}
+
+void ACT_Trace_printStats(void)
+{
+  for (ACT_Handle h = 1; h <= ACT_CFG_MAX_ACTORS; h++)
+  {
+    Active const *me = ACT_fromHandle(h);
+    if (me == NULL)
+    {
+      break;
+    }
+
+    ACT_TraceStats s;
+    ACT_Trace_getStats(me, &s);
+    if (s.events == 0)
+    {
+      continue;
+    }
+
+    ACT_DBGPRINT("{\"actor\":%u,\"events\":%lu,\"lat_mean_us\":%lu,\"lat_p50_us\":%lu,\"lat_p99_us\":%lu,\"lat_max_us\":%lu,\"max_depth\":%lu}\n",
+                 (unsigned int)h, (unsigned long)s.events, (unsigned long)(s.sumLatencyUs / s.events),
+                 (unsigned long)ACT_Trace_percentileUs(&s, 50), (unsigned long)ACT_Trace_percentileUs(&s, 99),
+                 (unsigned long)s.maxLatencyUs, (unsigned long)s.maxQueueDepth);
+  }
+}
+
+#endif /* ACT_CFG_TRACE == 1 */
@@ -0,0 +1 @@
+#define ACT_MEM_NUM_SIGNALS 64
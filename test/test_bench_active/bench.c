@@ -0,0 +1,52 @@
+#include <stdlib.h>
+
+#include "bench.h"
+
+static int Bench_compare(const void *a, const void *b)
+{
+  uint32_t x = *(const uint32_t *)a;
+  uint32_t y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+static uint32_t Bench_percentile(Bench_Samples const *s, uint32_t pct)
+{
+  return s->ns[((s->num - 1) * pct) / 100];
+}
+
+void Bench_Samples_reset(Bench_Samples *s)
+{
+  s->num = 0;
+}
+
+void Bench_Samples_add(Bench_Samples *s, uint32_t ns)
+{
+  if (s->num < BENCH_MAX_SAMPLES)
+  {
+    s->ns[s->num++] = ns;
+  }
+}
+
+void Bench_reportLatency(const char *bench, uint32_t param, Bench_Samples *s)
+{
+  if (s->num == 0)
+  {
+    return;
+  }
+
+  qsort(s->ns, s->num, sizeof(s->ns[0]), Bench_compare);
+
+  ACT_PRINT("{\"bench\":\"%s\",\"param\":%lu,\"unit\":\"ns\",\"n\":%lu,\"min\":%lu,\"p50\":%lu,\"p90\":%lu,\"p99\":%lu,\"max\":%lu}\n",
+            bench, (unsigned long)param, (unsigned long)s->num, (unsigned long)s->ns[0],
+            (unsigned long)Bench_percentile(s, 50), (unsigned long)Bench_percentile(s, 90),
+            (unsigned long)Bench_percentile(s, 99), (unsigned long)s->ns[s->num - 1]);
+}
+
+void Bench_reportRate(const char *bench, uint32_t param, uint32_t numEvents, uint64_t elapsedNs)
+{
+  uint64_t elapsedUs = elapsedNs / 1000u;
+  uint32_t rate = elapsedUs != 0 ? (uint32_t)(((uint64_t)numEvents * 1000000u) / elapsedUs) : 0;
+
+  ACT_PRINT("{\"bench\":\"%s\",\"param\":%lu,\"events\":%lu,\"elapsed_us\":%llu,\"events_per_s\":%lu}\n",
+            bench, (unsigned long)param, (unsigned long)numEvents, (unsigned long long)elapsedUs, (unsigned long)rate);
+}
@@ -0,0 +1,55 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <active.h>
+
+/**
+ * @brief Helpers for Active benchmarks. Results are printed as one JSON object per line with ACT_PRINT, so they can
+ * be collected from the test output (also with ACT_CFG_DEBUG_PRINT disabled) and compared between framework versions.
+ *
+ */
+
+/* Max number of latency samples per benchmark */
+#define BENCH_MAX_SAMPLES 1000
+
+/* Latency samples in nanoseconds */
+typedef struct
+{
+  uint32_t ns[BENCH_MAX_SAMPLES];
+  size_t num;
+} Bench_Samples;
+
+/* Get high resolution time stamp */
+static inline uint32_t Bench_now(void)
+{
+  return ACT_CYCLES_GET();
+}
+
+/* Get nanoseconds elapsed since time stamp (wrap around safe) */
+static inline uint32_t Bench_elapsedNs(uint32_t start)
+{
+  return (uint32_t)ACT_CYCLES_TO_NS((uint32_t)(ACT_CYCLES_GET() - start));
+}
+
+/* Get time stamp in microseconds, for intervals longer than the cycle counter wraps (4.29 s on hosts) */
+static inline uint64_t Bench_nowUs(void)
+{
+  return (uint64_t)ACT_TIMEUS_GET();
+}
+
+/* Clear all samples */
+void Bench_Samples_reset(Bench_Samples *s);
+
+/* Add a sample. Samples beyond BENCH_MAX_SAMPLES are dropped */
+void Bench_Samples_add(Bench_Samples *s, uint32_t ns);
+
+/* Print min, max and percentiles of samples as JSON. Sorts the samples */
+void Bench_reportLatency(const char *bench, uint32_t param, Bench_Samples *s);
+
+/* Print throughput of numEvents processed in elapsedNs as JSON */
+void Bench_reportRate(const char *bench, uint32_t param, uint32_t numEvents, uint64_t elapsedNs);
+
+#endif /* BENCH_H */
@@ -0,0 +1,437 @@
+#include <stdatomic.h>
+
+#include <active.h>
+#include <unity.h>
+
+#include "bench.h"
+
+/**
+ * @brief Active framework benchmarks. Run with the bench environments, e.g. `pio test -e bench_native`.
+ * Each benchmark prints one JSON line with its results and asserts that all events were processed.
+ *
+ */
+
+#define STACK_SIZE 1024
+
+#define RTT_ROUNDS 1000
+
+#define PIPE_STAGES 4
+#define PIPE_WINDOW 8
+#define PIPE_EVENTS 5000
+
+#define FANOUT_RECEIVERS 4
+#define FANOUT_ROUNDS 500
+
+#define POOL_BURST 32
+#define POOL_ROUNDS 500
+
+#define TIMER_PERIOD_MS 5
+#define TIMER_TICKS 200
+#define LOAD_SPIN_NS 50000
+
+/* Declare queue, thread and stack of an Active object used by the benchmarks */
+#define BENCH_ACTOR_DATA(name, maxMsg)                    \
+  static ACT_QBUF(name##QBuf, maxMsg);                    \
+  static ACT_Q(name##Q);                                  \
+  static ACT_THREAD(name##T);                             \
+  static ACT_THREAD_STACK_DEFINE(name##Stack, STACK_SIZE); \
+  static ACT_THREAD_STACK_SIZE(name##StackSz, name##Stack)
+
+#define BENCH_QD(name, qMaxMsg) {.maxMsg = (qMaxMsg), .queBuf = name##QBuf, .queue = &name##Q}
+#define BENCH_TD(name, prio) {.thread = &name##T, .pri = (prio), .stack = name##Stack, .stack_size = name##StackSz}
+
+enum BenchUserSignal
+{
+  GO_SIG = ACT_USER_SIG,
+  PING_SIG,
+  PONG_SIG,
+  DATA_SIG,
+  ACK_SIG,
+  FAN_SIG,
+  TICK_SIG,
+  LOAD_SIG
+};
+
+static ACT_SEM(done);
+static Active mainActor; // Sender of events posted from the test thread. Never started.
+static ACT_Signal goSig;
+
+/**
+ * @brief Round trip latency. Client posts a ping to server, which replies with a pong.
+ *
+ */
+
+BENCH_ACTOR_DATA(client, 2);
+BENCH_ACTOR_DATA(server, 2);
+
+static Active client;
+static Active server;
+static ACT_Signal pingSig;
+static ACT_Signal pongSig;
+static Bench_Samples samples;
+static uint32_t rttRounds;
+static uint32_t rttStart;
+
+static void client_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_SIGNAL)
+  {
+    return;
+  }
+
+  switch (EVT_CAST(e, ACT_Signal)->sig)
+  {
+  case GO_SIG:
+    rttRounds = 0;
+    rttStart = Bench_now();
+    ACT_postEvt(&server, EVT_UPCAST(&pingSig));
+    break;
+  case PONG_SIG:
+    Bench_Samples_add(&samples, Bench_elapsedNs(rttStart));
+    if (++rttRounds < RTT_ROUNDS)
+    {
+      rttStart = Bench_now();
+      ACT_postEvt(&server, EVT_UPCAST(&pingSig));
+    }
+    else
+    {
+      ACT_SEM_GIVE(&done);
+    }
+    break;
+  }
+}
+
+static void server_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type == ACT_SIGNAL && EVT_CAST(e, ACT_Signal)->sig == PING_SIG)
+  {
+    ACT_postEvt(ACT_EVT_SENDER(e), EVT_UPCAST(&pongSig));
+  }
+}
+
+/**
+ * @brief Pipeline throughput. Source keeps PIPE_WINDOW dynamic events in flight through PIPE_STAGES stages.
+ * The last stage acknowledges each event to the source, which then posts the next.
+ *
+ */
+
+BENCH_ACTOR_DATA(source, PIPE_WINDOW);
+BENCH_ACTOR_DATA(stage0, PIPE_WINDOW);
+BENCH_ACTOR_DATA(stage1, PIPE_WINDOW);
+BENCH_ACTOR_DATA(stage2, PIPE_WINDOW);
+BENCH_ACTOR_DATA(stage3, PIPE_WINDOW);
+
+static Active source;
+static Active stages[PIPE_STAGES];
+static ACT_Signal ackSig;
+static uint32_t pipeSent;
+static uint32_t pipeReceived;
+static uint64_t pipeStartUs;
+static uint64_t pipeElapsedNs;
+
+static void source_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_SIGNAL)
+  {
+    return;
+  }
+
+  switch (EVT_CAST(e, ACT_Signal)->sig)
+  {
+  case GO_SIG:
+    pipeSent = 0;
+    pipeReceived = 0;
+    pipeStartUs = Bench_nowUs();
+    for (; pipeSent < PIPE_WINDOW; pipeSent++)
+    {
+      ACT_postEvt(&stages[0], EVT_UPCAST(ACT_Signal_new(me, DATA_SIG)));
+    }
+    break;
+  case ACK_SIG:
+    if (pipeSent < PIPE_EVENTS)
+    {
+      pipeSent++;
+      ACT_postEvt(&stages[0], EVT_UPCAST(ACT_Signal_new(me, DATA_SIG)));
+    }
+    break;
+  }
+}
+
+static void stage_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_SIGNAL || EVT_CAST(e, ACT_Signal)->sig != DATA_SIG)
+  {
+    return;
+  }
+
+  size_t idx = me - stages;
+  if (idx < PIPE_STAGES - 1)
+  {
+    ACT_postEvt(&stages[idx + 1], e);
+    return;
+  }
+
+  if (++pipeReceived == PIPE_EVENTS)
+  {
+    pipeElapsedNs = (Bench_nowUs() - pipeStartUs) * 1000u;
+    ACT_SEM_GIVE(&done);
+  }
+  else
+  {
+    ACT_postEvt(&source, EVT_UPCAST(&ackSig));
+  }
+}
+
+/**
+ * @brief Fan-out latency. One dynamic event is posted to all receivers, measured until the last one processed it.
+ *
+ */
+
+BENCH_ACTOR_DATA(recv0, 2);
+BENCH_ACTOR_DATA(recv1, 2);
+BENCH_ACTOR_DATA(recv2, 2);
+BENCH_ACTOR_DATA(recv3, 2);
+
+static Active receivers[FANOUT_RECEIVERS];
+static atomic_uint fanRemaining;
+
+static void receiver_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type == ACT_SIGNAL && EVT_CAST(e, ACT_Signal)->sig == FAN_SIG)
+  {
+    if (atomic_fetch_sub(&fanRemaining, 1) == 1)
+    {
+      ACT_SEM_GIVE(&done);
+    }
+  }
+}
+
+/**
+ * @brief Periodic time event jitter while a lower priority Active object keeps the CPU busy.
+ *
+ */
+
+BENCH_ACTOR_DATA(ticker, 8);
+BENCH_ACTOR_DATA(loader, 2);
+
+static Active ticker;
+static Active loader;
+static ACT_Signal tickSig;
+static ACT_Signal loadSig;
+static ACT_TimEvt tickTimEvt;
+static atomic_bool loading;
+static uint32_t ticks;
+static uint32_t lastTick;
+
+static void ticker_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_SIGNAL || EVT_CAST(e, ACT_Signal)->sig != TICK_SIG || ticks >= TIMER_TICKS)
+  {
+    return;
+  }
+
+  uint32_t now = Bench_now();
+  if (ticks > 0)
+  {
+    int64_t deltaNs = (int64_t)ACT_CYCLES_TO_NS((uint32_t)(now - lastTick)) - (int64_t)TIMER_PERIOD_MS * 1000000;
+    Bench_Samples_add(&samples, (uint32_t)(deltaNs < 0 ? -deltaNs : deltaNs));
+  }
+  lastTick = now;
+
+  if (++ticks == TIMER_TICKS)
+  {
+    ACT_TimeEvt_stop(&tickTimEvt);
+    ACT_SEM_GIVE(&done);
+  }
+}
+
+static void loader_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type == ACT_SIGNAL && EVT_CAST(e, ACT_Signal)->sig == LOAD_SIG && atomic_load(&loading))
+  {
+    uint32_t start = Bench_now();
+    while (Bench_elapsedNs(start) < LOAD_SPIN_NS)
+    {
+    }
+    ACT_postEvt(me, EVT_UPCAST(&loadSig));
+  }
+}
+
+/**
+ * @brief Benchmarks
+ *
+ */
+
+static void bench_rtt()
+{
+  Bench_Samples_reset(&samples);
+
+  ACT_postEvt(&client, EVT_UPCAST(&goSig));
+  ACT_SEM_TAKE(&done);
+
+  TEST_ASSERT_EQUAL_UINT32(RTT_ROUNDS, rttRounds);
+  Bench_reportLatency("rtt", 0, &samples);
+}
+
+static void bench_pipeline()
+{
+  ACT_postEvt(&source, EVT_UPCAST(&goSig));
+  ACT_SEM_TAKE(&done);
+
+  TEST_ASSERT_EQUAL_UINT32(PIPE_EVENTS, pipeReceived);
+  Bench_reportRate("pipeline", PIPE_STAGES, PIPE_EVENTS, pipeElapsedNs);
+
+  ACT_SLEEPMS(10);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Signal_getUsed());
+}
+
+static void bench_fanout()
+{
+  Bench_Samples_reset(&samples);
+
+  for (uint32_t i = 0; i < FANOUT_ROUNDS; i++)
+  {
+    ACT_Signal *s = ACT_Signal_new(&mainActor, FAN_SIG);
+    atomic_store(&fanRemaining, FANOUT_RECEIVERS);
+
+    // Hold a reference while posting, so the first receiver can not free the event before it is posted to all
+    uint32_t start = Bench_now();
+    ACT_mem_refinc(EVT_UPCAST(s));
+    for (size_t r = 0; r < FANOUT_RECEIVERS; r++)
+    {
+      ACT_postEvt(&receivers[r], EVT_UPCAST(s));
+    }
+    ACT_mem_refdec(EVT_UPCAST(s));
+    ACT_SEM_TAKE(&done);
+    Bench_Samples_add(&samples, Bench_elapsedNs(start));
+  }
+
+  Bench_reportLatency("fanout", FANOUT_RECEIVERS, &samples);
+
+  ACT_SLEEPMS(10);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Signal_getUsed());
+}
+
+static void bench_pool()
+{
+  ACT_Signal *burst[POOL_BURST];
+  uint64_t totalNs = 0;
+
+  Bench_Samples_reset(&samples);
+
+  for (uint32_t i = 0; i < POOL_ROUNDS; i++)
+  {
+    uint32_t start = Bench_now();
+    for (size_t j = 0; j < POOL_BURST; j++)
+    {
+      burst[j] = ACT_Signal_new(&mainActor, DATA_SIG);
+    }
+    for (size_t j = 0; j < POOL_BURST; j++)
+    {
+      ACT_mem_gc(EVT_UPCAST(burst[j]));
+    }
+    uint32_t elapsedNs = Bench_elapsedNs(start);
+
+    // Latency of one alloc and free pair
+    Bench_Samples_add(&samples, elapsedNs / POOL_BURST);
+    totalNs += elapsedNs;
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Signal_getUsed());
+  Bench_reportLatency("pool", POOL_BURST, &samples);
+  Bench_reportRate("pool", POOL_BURST, POOL_ROUNDS * POOL_BURST, totalNs);
+}
+
+static void bench_timer_jitter()
+{
+  Bench_Samples_reset(&samples);
+  ticks = 0;
+
+  atomic_store(&loading, true);
+  ACT_postEvt(&loader, EVT_UPCAST(&loadSig));
+
+  ACT_TimeEvt_start(&tickTimEvt, TIMER_PERIOD_MS, TIMER_PERIOD_MS);
+  ACT_SEM_TAKE(&done);
+
+  atomic_store(&loading, false);
+
+  TEST_ASSERT_EQUAL_UINT32(TIMER_TICKS, ticks);
+  Bench_reportLatency("timer_jitter", TIMER_PERIOD_MS, &samples);
+}
+
+int main(void)
+{
+  static const ACT_QueueData qdclient = BENCH_QD(client, 2);
+  static const ACT_QueueData qdserver = BENCH_QD(server, 2);
+  static const ACT_ThreadData tdclient = BENCH_TD(client, 2);
+  static const ACT_ThreadData tdserver = BENCH_TD(server, 1);
+
+  static const ACT_QueueData qdsource = BENCH_QD(source, PIPE_WINDOW);
+  static const ACT_ThreadData tdsource = BENCH_TD(source, 1);
+  static const ACT_QueueData qdstages[PIPE_STAGES] = {
+      BENCH_QD(stage0, PIPE_WINDOW), BENCH_QD(stage1, PIPE_WINDOW), BENCH_QD(stage2, PIPE_WINDOW), BENCH_QD(stage3, PIPE_WINDOW)};
+  static const ACT_ThreadData tdstages[PIPE_STAGES] = {
+      BENCH_TD(stage0, 1), BENCH_TD(stage1, 1), BENCH_TD(stage2, 1), BENCH_TD(stage3, 1)};
+
+  static const ACT_QueueData qdreceivers[FANOUT_RECEIVERS] = {
+      BENCH_QD(recv0, 2), BENCH_QD(recv1, 2), BENCH_QD(recv2, 2), BENCH_QD(recv3, 2)};
+  static const ACT_ThreadData tdreceivers[FANOUT_RECEIVERS] = {
+      BENCH_TD(recv0, 1), BENCH_TD(recv1, 1), BENCH_TD(recv2, 1), BENCH_TD(recv3, 1)};
+
+  static const ACT_QueueData qdticker = BENCH_QD(ticker, 8);
+  static const ACT_QueueData qdloader = BENCH_QD(loader, 2);
+  static const ACT_ThreadData tdticker = BENCH_TD(ticker, 1);
+  static const ACT_ThreadData tdloader = BENCH_TD(loader, 3);
+
+  ACT_SLEEPMS(2000);
+
+  ACT_SEM_INIT(&done);
+  ACT_Signal_init(&goSig, &mainActor, GO_SIG);
+
+  ACT_init(&client, client_dispatch, &qdclient, &tdclient);
+  ACT_init(&server, server_dispatch, &qdserver, &tdserver);
+  ACT_Signal_init(&pingSig, &client, PING_SIG);
+  ACT_Signal_init(&pongSig, &server, PONG_SIG);
+
+  ACT_init(&source, source_dispatch, &qdsource, &tdsource);
+  for (size_t i = 0; i < PIPE_STAGES; i++)
+  {
+    ACT_init(&stages[i], stage_dispatch, &qdstages[i], &tdstages[i]);
+  }
+  ACT_Signal_init(&ackSig, &stages[PIPE_STAGES - 1], ACK_SIG);
+
+  for (size_t i = 0; i < FANOUT_RECEIVERS; i++)
+  {
+    ACT_init(&receivers[i], receiver_dispatch, &qdreceivers[i], &tdreceivers[i]);
+  }
+
+  ACT_init(&ticker, ticker_dispatch, &qdticker, &tdticker);
+  ACT_init(&loader, loader_dispatch, &qdloader, &tdloader);
+  ACT_Signal_init(&tickSig, &ticker, TICK_SIG);
+  ACT_Signal_init(&loadSig, &loader, LOAD_SIG);
+  ACT_TimEvt_init(&tickTimEvt, &ticker, EVT_UPCAST(&tickSig), &ticker, NULL);
+
+  ACT_start(&client);
+  ACT_start(&server);
+  ACT_start(&source);
+  for (size_t i = 0; i < PIPE_STAGES; i++)
+  {
+    ACT_start(&stages[i]);
+  }
+  for (size_t i = 0; i < FANOUT_RECEIVERS; i++)
+  {
+    ACT_start(&receivers[i]);
+  }
+  ACT_start(&ticker);
+  ACT_start(&loader);
+
+  UNITY_BEGIN();
+
+  RUN_TEST(bench_rtt);
+  RUN_TEST(bench_pipeline);
+  RUN_TEST(bench_fanout);
+  RUN_TEST(bench_pool);
+  RUN_TEST(bench_timer_jitter);
+
+  return UNITY_END();
+}
@@ -0,0 +1,143 @@
+#include <active.h>
+#include <unity.h>
+
+#define NUM_SLOTS 8
+
+static ACT_QBUF(fastQBuf, 2);
+static ACT_Q(fastQ);
+static ACT_THREAD(fastT);
+static ACT_THREAD_STACK_DEFINE(fastTStack, 512);
+static ACT_THREAD_STACK_SIZE(fastTStackSz, fastTStack);
+
+const static ACT_QueueData qdfast = {.maxMsg = 2,
+                                     .queBuf = fastQBuf,
+                                     .queue = &fastQ};
+
+const static ACT_ThreadData tdfast = {.thread = &fastT,
+                                      .pri = 1,
+                                      .stack = fastTStack,
+                                      .stack_size = fastTStackSz};
+
+static ACT_QBUF(slowQBuf, 2);
+static ACT_Q(slowQ);
+static ACT_THREAD(slowT);
+static ACT_THREAD_STACK_DEFINE(slowTStack, 512);
+static ACT_THREAD_STACK_SIZE(slowTStackSz, slowTStack);
+
+const static ACT_QueueData qdslow = {.maxMsg = 2,
+                                     .queBuf = slowQBuf,
+                                     .queue = &slowQ};
+
+const static ACT_ThreadData tdslow = {.thread = &slowT,
+                                      .pri = 2,
+                                      .stack = slowTStack,
+                                      .stack_size = slowTStackSz};
+
+enum TestUserSignal
+{
+  SAMPLE_SIG = ACT_USER_SIG
+};
+
+typedef struct
+{
+  Active super;
+  ACT_BcastSub *sub;
+  uint32_t received;
+  uint32_t sum;
+} Subscriber;
+
+Active producer;
+Subscriber fast, slow;
+
+static ACT_BCAST_BUF(ringBuf, uint32_t, NUM_SLOTS);
+static ACT_BcastSub subs[2];
+static ACT_Bcast bcast;
+
+static void sub_dispatch(Active *me, ACT_Evt const *const e)
+{
+  Subscriber *s = (Subscriber *)me;
+
+  if (e->type == ACT_SIGNAL && EVT_CAST(e, ACT_Signal)->sig == SAMPLE_SIG)
+  {
+    const uint32_t *sample;
+    while ((sample = ACT_Bcast_read(s->sub)) != NULL)
+    {
+      s->received++;
+      s->sum += *sample;
+      ACT_Bcast_release(s->sub);
+    }
+  }
+}
+
+static bool publish(uint32_t value)
+{
+  uint32_t *slot = ACT_Bcast_claim(&bcast);
+  if (slot == NULL)
+  {
+    return false;
+  }
+  *slot = value;
+  ACT_Bcast_publish(&bcast);
+  return true;
+}
+
+static void test_bcast_backpressure()
+{
+  /* Subscribers are not started - ring fills up */
+  for (uint32_t i = 0; i < NUM_SLOTS; i++)
+  {
+    TEST_ASSERT_TRUE(publish(i));
+  }
+  TEST_ASSERT_FALSE(publish(NUM_SLOTS));
+  TEST_ASSERT_EQUAL_UINT32(1, bcast.overruns);
+}
+
+static void test_bcast_all_subscribers_read_all()
+{
+  ACT_start(ACT_UPCAST(&fast));
+  ACT_start(ACT_UPCAST(&slow));
+  ACT_SLEEPMS(50);
+
+  uint32_t expectedSum = 0;
+  for (uint32_t i = 0; i < NUM_SLOTS; i++)
+  {
+    expectedSum += i;
+  }
+
+  for (uint32_t i = 0; i < 100; i++)
+  {
+    while (!publish(i))
+    {
+      ACT_SLEEPMS(1);
+    }
+    expectedSum += i;
+  }
+  ACT_SLEEPMS(50);
+
+  TEST_ASSERT_EQUAL_UINT32(NUM_SLOTS + 100, fast.received);
+  TEST_ASSERT_EQUAL_UINT32(NUM_SLOTS + 100, slow.received);
+  TEST_ASSERT_EQUAL_UINT32(expectedSum, fast.sum);
+  TEST_ASSERT_EQUAL_UINT32(expectedSum, slow.sum);
+
+  /* Producer can use all slots again */
+  TEST_ASSERT_NOT_NULL(ACT_Bcast_claim(&bcast));
+}
+
+void main()
+{
+  ACT_SLEEPMS(2000);
+
+  UNITY_BEGIN();
+
+  ACT_init(ACT_UPCAST(&fast), sub_dispatch, &qdfast, &tdfast);
+  ACT_init(ACT_UPCAST(&slow), sub_dispatch, &qdslow, &tdslow);
+
+  ACT_Bcast_init(&bcast, &producer, ringBuf, sizeof(uint32_t), NUM_SLOTS, subs, 2);
+  fast.sub = ACT_Bcast_subscribe(&bcast, ACT_UPCAST(&fast), SAMPLE_SIG);
+  slow.sub = ACT_Bcast_subscribe(&bcast, ACT_UPCAST(&slow), SAMPLE_SIG);
+
+  RUN_TEST(test_bcast_backpressure);
+  RUN_TEST(test_bcast_all_subscribers_read_all);
+
+  UNITY_END();
+}
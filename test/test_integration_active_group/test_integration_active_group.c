@@ -0,0 +1,163 @@
+#include <active.h>
+#include <unity.h>
+
+#define NUM_WORKERS 3
+#define MAX_MSG 4
+
+static ACT_QBUF(w0QBuf, MAX_MSG);
+static ACT_QBUF(w1QBuf, MAX_MSG);
+static ACT_QBUF(w2QBuf, MAX_MSG);
+static ACT_Q(w0Q);
+static ACT_Q(w1Q);
+static ACT_Q(w2Q);
+static ACT_THREAD(w0T);
+static ACT_THREAD(w1T);
+static ACT_THREAD(w2T);
+static ACT_THREAD_STACK_DEFINE(w0Stack, 512);
+static ACT_THREAD_STACK_DEFINE(w1Stack, 512);
+static ACT_THREAD_STACK_DEFINE(w2Stack, 512);
+static ACT_THREAD_STACK_SIZE(w0StackSz, w0Stack);
+static ACT_THREAD_STACK_SIZE(w1StackSz, w1Stack);
+static ACT_THREAD_STACK_SIZE(w2StackSz, w2Stack);
+
+const static ACT_QueueData qdworkers[NUM_WORKERS] = {
+    {.maxMsg = MAX_MSG, .queBuf = w0QBuf, .queue = &w0Q},
+    {.maxMsg = MAX_MSG, .queBuf = w1QBuf, .queue = &w1Q},
+    {.maxMsg = MAX_MSG, .queBuf = w2QBuf, .queue = &w2Q}};
+
+const static ACT_ThreadData tdworkers[NUM_WORKERS] = {
+    {.thread = &w0T, .pri = 1, .stack = w0Stack, .stack_size = w0StackSz},
+    {.thread = &w1T, .pri = 1, .stack = w1Stack, .stack_size = w1StackSz},
+    {.thread = &w2T, .pri = 1, .stack = w2Stack, .stack_size = w2StackSz}};
+
+enum TestUserSignal
+{
+  WORK_SIG = ACT_USER_SIG
+};
+
+typedef struct
+{
+  Active super;
+  uint16_t processed;
+} Worker;
+
+Worker workers[NUM_WORKERS];
+Active *const members[NUM_WORKERS] = {ACT_UPCAST(&workers[0]), ACT_UPCAST(&workers[1]), ACT_UPCAST(&workers[2])};
+
+ACT_Group group;
+Active sender;
+ACT_Signal workSig;
+
+static void worker_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type == ACT_SIGNAL && EVT_CAST(e, ACT_Signal)->sig == WORK_SIG)
+  {
+    ((Worker *)me)->processed++;
+    ACT_SLEEPMS(20);
+  }
+}
+
+static void reset()
+{
+  for (size_t i = 0; i < NUM_WORKERS; i++)
+  {
+    workers[i].processed = 0;
+  }
+}
+
+static void test_group_least_loaded()
+{
+  reset();
+
+  for (uint16_t i = 0; i < NUM_WORKERS * 2; i++)
+  {
+    TEST_ASSERT_EQUAL_INT(0, ACT_postGroup(&group, EVT_UPCAST(&workSig)));
+  }
+  ACT_SLEEPMS(100);
+
+  /* Load is spread evenly over idle workers */
+  for (size_t i = 0; i < NUM_WORKERS; i++)
+  {
+    TEST_ASSERT_EQUAL_UINT16(2, workers[i].processed);
+  }
+  TEST_ASSERT_EQUAL(0, ACT_Group_getQueueUsed(&group));
+}
+
+static void test_group_key()
+{
+  reset();
+
+  for (uint16_t i = 0; i < 3; i++)
+  {
+    TEST_ASSERT_EQUAL_INT(0, ACT_postGroupKey(&group, EVT_UPCAST(&workSig), 42));
+  }
+  ACT_SLEEPMS(100);
+
+  /* All events with same key processed by the same worker */
+  uint16_t maxProcessed = 0;
+  for (size_t i = 0; i < NUM_WORKERS; i++)
+  {
+    if (workers[i].processed > maxProcessed)
+    {
+      maxProcessed = workers[i].processed;
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT16(3, maxProcessed);
+}
+
+static void test_group_stats()
+{
+  ACT_GroupStats stats = ACT_Group_getStats(&group);
+
+  TEST_ASSERT_EQUAL_UINT32(NUM_WORKERS * 2 + 3, stats.posted);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.failed);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, stats.maxDepth);
+}
+
+static void test_group_full()
+{
+  reset();
+  ACT_GroupStats before = ACT_Group_getStats(&group);
+
+  /* Same key, so all go to one worker, which takes at most one before the queue is full */
+  size_t rejected = 0;
+  for (uint16_t i = 0; i < MAX_MSG + 2; i++)
+  {
+    if (ACT_postGroupKey(&group, EVT_UPCAST(&workSig), 7) == ACT_GROUP_ERR_FULL)
+    {
+      rejected++;
+    }
+  }
+  ACT_SLEEPMS(200);
+
+  ACT_GroupStats stats = ACT_Group_getStats(&group);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, rejected);
+  TEST_ASSERT_EQUAL_UINT32(MAX_MSG + 2, stats.posted - before.posted);
+  TEST_ASSERT_EQUAL_UINT32(rejected, stats.failed - before.failed);
+  TEST_ASSERT_EQUAL_UINT32(MAX_MSG, stats.maxDepth);
+
+  uint16_t processed = 0;
+  for (size_t i = 0; i < NUM_WORKERS; i++)
+  {
+    processed += workers[i].processed;
+  }
+  TEST_ASSERT_EQUAL_UINT16(MAX_MSG + 2 - rejected, processed);
+}
+
+void main()
+{
+  ACT_SLEEPMS(2000);
+
+  UNITY_BEGIN();
+
+  ACT_Group_init(&group, members, NUM_WORKERS, worker_dispatch, qdworkers, tdworkers);
+  ACT_Group_start(&group);
+  ACT_Signal_init(&workSig, &sender, WORK_SIG);
+
+  RUN_TEST(test_group_least_loaded);
+  RUN_TEST(test_group_key);
+  RUN_TEST(test_group_stats);
+  RUN_TEST(test_group_full);
+
+  UNITY_END();
+}
@@ -0,0 +1 @@
+#define ACT_CFG_REACTOR 1
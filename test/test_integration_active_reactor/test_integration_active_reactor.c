@@ -0,0 +1,188 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <active.h>
+#include <unity.h>
+
+/* Linux host only. Pipes and socketpairs are watched by an Active object through a reactor thread */
+
+#define MAX_MSG 32
+#define NUM_PIPES 16
+#define TIMEOUT_MS 1000
+
+static ACT_QBUF(qBuf, MAX_MSG);
+static ACT_Q(q);
+static ACT_THREAD(t);
+static ACT_THREAD_STACK_DEFINE(stack, 512);
+static ACT_THREAD_STACK_SIZE(stackSz, stack);
+
+const static ACT_QueueData qd = {.maxMsg = MAX_MSG, .queBuf = qBuf, .queue = &q};
+const static ACT_ThreadData td = {.thread = &t, .pri = 1, .stack = stack, .stack_size = stackSz};
+
+enum TestUserSignal
+{
+  PIPE_MSG = ACT_USER_SIG,
+  SOCKET_MSG
+};
+
+static Active conn;
+static ACT_Reactor reactor;
+static ACT_SEM(done);
+
+static int pipes[NUM_PIPES][2];
+static ACT_ReactorWatch pipeWatches[NUM_PIPES];
+static int sockets[2];
+static ACT_ReactorWatch socketWatch;
+
+static atomic_uint bytesRead;
+static atomic_uint numReady;
+static atomic_uint hangups;
+static atomic_uint expected;
+
+static void conn_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_MESSAGE)
+  {
+    return;
+  }
+
+  ACT_Message const *m = EVT_CAST(e, ACT_Message);
+  ACT_ReactorWatch *w = m->payload;
+  uint32_t events = ACT_ReactorWatch_take(w);
+  atomic_fetch_add(&numReady, 1);
+
+  char buf[64];
+  ssize_t n;
+  if (m->header == PIPE_MSG)
+  {
+    // Level triggered: one read, then rearm
+    n = read(w->fd, buf, sizeof(buf));
+    if (n > 0)
+    {
+      atomic_fetch_add(&bytesRead, (unsigned int)n);
+    }
+    if (events & EPOLLHUP)
+    {
+      atomic_fetch_add(&hangups, 1);
+      ACT_Reactor_remove(w);
+    }
+    else
+    {
+      ACT_ReactorWatch_rearm(w);
+    }
+  }
+  else
+  {
+    // Edge triggered: read until EAGAIN
+    while ((n = read(w->fd, buf, sizeof(buf))) > 0)
+    {
+      atomic_fetch_add(&bytesRead, (unsigned int)n);
+    }
+    TEST_ASSERT_EQUAL_INT(EAGAIN, errno);
+  }
+
+  if (atomic_load(&bytesRead) + atomic_load(&hangups) == atomic_load(&expected))
+  {
+    ACT_SEM_GIVE(&done);
+  }
+}
+
+static void waitDone(void)
+{
+  TEST_ASSERT_TRUE(ACT_SEM_TAKE_MS(&done, TIMEOUT_MS));
+}
+
+void setUp(void)
+{
+  atomic_store(&bytesRead, 0);
+  atomic_store(&numReady, 0);
+  atomic_store(&hangups, 0);
+}
+
+void test_level_watch_on_many_pipes()
+{
+  atomic_store(&expected, NUM_PIPES);
+  for (size_t i = 0; i < NUM_PIPES; i++)
+  {
+    TEST_ASSERT_EQUAL(1, write(pipes[i][1], "x", 1));
+  }
+  waitDone();
+
+  TEST_ASSERT_EQUAL_UINT32(NUM_PIPES, atomic_load(&bytesRead));
+  TEST_ASSERT_EQUAL_UINT32(NUM_PIPES, atomic_load(&numReady));
+}
+
+void test_level_watch_rearmed_until_drained()
+{
+  // More bytes than one read takes, the rearmed watch is ready again until all are read
+  char data[150] = {0};
+  atomic_store(&expected, sizeof(data));
+  TEST_ASSERT_EQUAL(sizeof(data), write(pipes[0][1], data, sizeof(data)));
+  waitDone();
+
+  TEST_ASSERT_EQUAL_UINT32(sizeof(data), atomic_load(&bytesRead));
+  TEST_ASSERT_EQUAL_UINT32(3, atomic_load(&numReady));
+}
+
+void test_edge_watch_on_socketpair()
+{
+  atomic_store(&expected, 300);
+  for (int i = 0; i < 3; i++)
+  {
+    char data[100] = {0};
+    TEST_ASSERT_EQUAL(sizeof(data), write(sockets[1], data, sizeof(data)));
+  }
+  waitDone();
+
+  TEST_ASSERT_EQUAL_UINT32(300, atomic_load(&bytesRead));
+  TEST_ASSERT_TRUE(atomic_load(&numReady) <= 3);
+}
+
+void test_hangup_reported()
+{
+  atomic_store(&expected, 1);
+  close(pipes[1][1]);
+  waitDone();
+
+  TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&hangups));
+}
+
+void test_stats()
+{
+  ACT_ReactorStats stats = ACT_Reactor_getStats(&reactor);
+
+  TEST_ASSERT_TRUE(stats.waits > 0);
+  TEST_ASSERT_TRUE(stats.events >= stats.posts);
+  TEST_ASSERT_TRUE(stats.waits <= stats.events);
+}
+
+void main()
+{
+  UNITY_BEGIN();
+
+  ACT_SEM_INIT(&done);
+  ACT_init(&conn, conn_dispatch, &qd, &td);
+  ACT_start(&conn);
+
+  TEST_ASSERT_EQUAL(ACT_REACTOR_OK, ACT_Reactor_init(&reactor));
+  for (size_t i = 0; i < NUM_PIPES; i++)
+  {
+    TEST_ASSERT_EQUAL(0, pipe(pipes[i]));
+    TEST_ASSERT_EQUAL(ACT_REACTOR_OK, ACT_Reactor_add(&reactor, &pipeWatches[i], pipes[i][0], EPOLLIN, ACT_REACTOR_LEVEL, &conn, PIPE_MSG));
+  }
+  TEST_ASSERT_EQUAL(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sockets));
+  TEST_ASSERT_EQUAL(ACT_REACTOR_OK, ACT_Reactor_add(&reactor, &socketWatch, sockets[0], EPOLLIN, ACT_REACTOR_EDGE, &conn, SOCKET_MSG));
+  TEST_ASSERT_EQUAL(ACT_REACTOR_OK, ACT_Reactor_start(&reactor));
+
+  RUN_TEST(test_level_watch_on_many_pipes);
+  RUN_TEST(test_level_watch_rearmed_until_drained);
+  RUN_TEST(test_edge_watch_on_socketpair);
+  RUN_TEST(test_hangup_reported);
+  RUN_TEST(test_stats);
+
+  ACT_Reactor_stop(&reactor);
+
+  UNITY_END();
+}
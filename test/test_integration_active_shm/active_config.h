@@ -0,0 +1,3 @@
+#define ACT_CFG_SHM 1
+#define ACT_MEM_NUM_SIGNALS 8
+#define ACT_MEM_NUM_MESSAGES 8
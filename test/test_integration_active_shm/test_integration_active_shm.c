@@ -0,0 +1,202 @@
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <active.h>
+#include <unity.h>
+
+/* Linux host only. An echo Active object runs in a forked peer process and replies over a shared memory link */
+
+#define MAX_MSG 8
+#define NUM_ROUNDTRIPS 2000
+#define PAYLOAD_LEN 64
+
+static ACT_QBUF(qBuf, MAX_MSG);
+static ACT_Q(q);
+static ACT_THREAD(t);
+static ACT_THREAD_STACK_DEFINE(stack, 512);
+static ACT_THREAD_STACK_SIZE(stackSz, stack);
+
+const static ACT_QueueData qd = {.maxMsg = MAX_MSG, .queBuf = qBuf, .queue = &q};
+const static ACT_ThreadData td = {.thread = &t, .pri = 1, .stack = stack, .stack_size = stackSz};
+
+enum TestUserSignal
+{
+  PING_SIG = ACT_USER_SIG,
+  PONG_SIG,
+  STOP_SIG,
+  DATA_MSG,
+  ECHO_MSG
+};
+
+/* Both processes bind their Active object to port 0 */
+#define PORT 0
+
+static char linkName[32];
+static ACT_ShmLink shmLink;
+static ACT_ShmProxy peer;
+static Active local;
+static ACT_SEM(done);
+static pid_t peerPid;
+
+static uint32_t pongs;
+static char echoed[PAYLOAD_LEN];
+static uint16_t echoedLen;
+
+/* Peer process: echo signals and messages back to the sender */
+static void echo_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type == ACT_SIGNAL)
+  {
+    uint16_t sig = EVT_CAST(e, ACT_Signal)->sig;
+    if (sig == PING_SIG)
+    {
+      ACT_postEvt(ACT_EVT_SENDER(e), EVT_UPCAST(ACT_Signal_new(me, PONG_SIG)));
+    }
+    else if (sig == STOP_SIG)
+    {
+      ACT_SEM_GIVE(&done);
+    }
+  }
+  else if (e->type == ACT_MESSAGE)
+  {
+    // Payload is in the receive ring. The proxy copies it into the send ring before returning
+    ACT_Message const *m = EVT_CAST(e, ACT_Message);
+    ACT_postEvt(ACT_EVT_SENDER(e), EVT_UPCAST(ACT_Message_new(me, ECHO_MSG, m->payload, m->payloadLen)));
+  }
+}
+
+static int runPeer(void)
+{
+  if (ACT_ShmLink_open(&shmLink, linkName, 1) != ACT_SHM_OK)
+  {
+    return 1;
+  }
+
+  ACT_SEM_INIT(&done);
+  ACT_init(&local, echo_dispatch, &qd, &td);
+  ACT_ShmLink_bind(&shmLink, PORT, &local);
+  ACT_ShmProxy_init(&peer, &shmLink, PORT);
+  ACT_start(&local);
+  ACT_ShmLink_start(&shmLink);
+
+  ACT_SEM_TAKE(&done);
+  ACT_SLEEPMS(10);
+  ACT_ShmLink_close(&shmLink);
+  return 0;
+}
+
+/* Test process */
+static void client_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type == ACT_SIGNAL && EVT_CAST(e, ACT_Signal)->sig == PONG_SIG)
+  {
+    pongs++;
+    ACT_SEM_GIVE(&done);
+  }
+  else if (e->type == ACT_MESSAGE && EVT_CAST(e, ACT_Message)->header == ECHO_MSG)
+  {
+    ACT_Message const *m = EVT_CAST(e, ACT_Message);
+    echoedLen = m->payloadLen;
+    memcpy(echoed, m->payload, m->payloadLen < sizeof(echoed) ? m->payloadLen : sizeof(echoed));
+    ACT_SEM_GIVE(&done);
+  }
+}
+
+static void test_shm_signal_roundtrip()
+{
+  TEST_ASSERT_EQUAL_INT(ACT_SHM_OK, ACT_postEvt(ACT_UPCAST(&peer), EVT_UPCAST(ACT_Signal_new(&local, PING_SIG))));
+  ACT_SEM_TAKE(&done);
+
+  TEST_ASSERT_EQUAL_UINT32(1, pongs);
+}
+
+static void test_shm_message_in_place()
+{
+  static const char text[] = "written in place";
+
+  char *payload = ACT_ShmProxy_claim(&peer, DATA_MSG, sizeof(text));
+  TEST_ASSERT_NOT_NULL(payload);
+  memcpy(payload, text, sizeof(text));
+  TEST_ASSERT_EQUAL_INT(ACT_SHM_OK, ACT_ShmProxy_commit(&peer, &local));
+  ACT_SEM_TAKE(&done);
+
+  TEST_ASSERT_EQUAL_UINT16(sizeof(text), echoedLen);
+  TEST_ASSERT_EQUAL_STRING(text, echoed);
+}
+
+static void test_shm_ring_space_is_released()
+{
+  // Records of all round trips are several times the ring size in total
+  TEST_ASSERT_GREATER_THAN(ACT_CFG_SHM_RING_SIZE, NUM_ROUNDTRIPS * (PAYLOAD_LEN + 16));
+
+  static char payload[PAYLOAD_LEN];
+  uint64_t startNs = ACT_Posix_nowNs();
+
+  for (uint32_t i = 0; i < NUM_ROUNDTRIPS; i++)
+  {
+    memcpy(payload, &i, sizeof(i));
+    TEST_ASSERT_EQUAL_INT(ACT_SHM_OK, ACT_postEvt(ACT_UPCAST(&peer), EVT_UPCAST(ACT_Message_new(&local, DATA_MSG, payload, PAYLOAD_LEN))));
+    ACT_SEM_TAKE(&done);
+
+    uint32_t echoedI;
+    memcpy(&echoedI, echoed, sizeof(echoedI));
+    TEST_ASSERT_EQUAL_UINT32(i, echoedI);
+  }
+
+  uint64_t rttNs = (ACT_Posix_nowNs() - startNs) / NUM_ROUNDTRIPS;
+  ACT_DBGPRINT("{\"bench\":\"shm_rtt\",\"n\":%u,\"mean_ns\":%llu}\n", NUM_ROUNDTRIPS, (unsigned long long)rttNs);
+
+  ACT_ShmStats stats;
+  ACT_ShmLink_getStats(&shmLink, &stats);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.full);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.unbound);
+  TEST_ASSERT_EQUAL_UINT32(stats.sent, stats.received);
+}
+
+static void test_shm_peer_exits()
+{
+  int status;
+
+  ACT_postEvt(ACT_UPCAST(&peer), EVT_UPCAST(ACT_Signal_new(&local, STOP_SIG)));
+  TEST_ASSERT_EQUAL_INT(peerPid, waitpid(peerPid, &status, 0));
+  TEST_ASSERT_TRUE(WIFEXITED(status));
+  TEST_ASSERT_EQUAL_INT(0, WEXITSTATUS(status));
+}
+
+int main(void)
+{
+  snprintf(linkName, sizeof(linkName), "/act_test_%d", (int)getpid());
+
+  // Side 0 creates the segment before the peer opens it
+  if (ACT_ShmLink_open(&shmLink, linkName, 0) != ACT_SHM_OK)
+  {
+    return 1;
+  }
+
+  peerPid = fork();
+  if (peerPid == 0)
+  {
+    // The peer opens its own side of the link
+    _exit(runPeer());
+  }
+
+  UNITY_BEGIN();
+
+  ACT_SEM_INIT(&done);
+  ACT_init(&local, client_dispatch, &qd, &td);
+  ACT_ShmLink_bind(&shmLink, PORT, &local);
+  ACT_ShmProxy_init(&peer, &shmLink, PORT);
+  ACT_start(&local);
+  ACT_ShmLink_start(&shmLink);
+
+  RUN_TEST(test_shm_signal_roundtrip);
+  RUN_TEST(test_shm_message_in_place);
+  RUN_TEST(test_shm_ring_space_is_released);
+  RUN_TEST(test_shm_peer_exits);
+
+  ACT_ShmLink_close(&shmLink);
+
+  return UNITY_END();
+}
@@ -0,0 +1,2 @@
+#define ACT_CFG_PORT_SIM 1
+#define ACT_MEM_NUM_SIGNALS 4
@@ -0,0 +1,108 @@
+#include <string.h>
+
+#include <active.h>
+#include <unity.h>
+
+/* Runs on the simulation port. Active objects are defined statically and started with ACT_startAll */
+
+enum TestUserSignal
+{
+  HELLO_SIG = ACT_USER_SIG
+};
+
+typedef struct
+{
+  Active super;
+  uint32_t started;
+  uint32_t hellos;
+} Node;
+
+static void Node_dispatch(Active *me, ACT_Evt const *const e);
+
+ACT_DEFINE_TYPE(Node, left, Node_dispatch, 4, 512, 1);
+ACT_DEFINE_TYPE(Node, right, Node_dispatch, 8, 1024, 2);
+ACT_DEFINE(plain, Node_dispatch, 2, 256, 3);
+
+static uint32_t plainStarts;
+
+static void Node_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_SIGNAL)
+  {
+    return;
+  }
+
+  uint16_t sig = EVT_CAST(e, ACT_Signal)->sig;
+  if (me == &plain)
+  {
+    plainStarts += sig == ACT_START_SIG ? 1 : 0;
+    return;
+  }
+
+  Node *node = (Node *)me;
+  if (sig == ACT_START_SIG)
+  {
+    node->started++;
+    // Peers are initialized before any start event, so they can be posted to
+    Active *peer = me == ACT_UPCAST(&left) ? ACT_UPCAST(&right) : ACT_UPCAST(&left);
+    ACT_postEvt(peer, EVT_UPCAST(ACT_Signal_new(me, HELLO_SIG)));
+  }
+  else if (sig == HELLO_SIG)
+  {
+    node->hellos++;
+  }
+}
+
+void setUp(void)
+{
+}
+
+void test_all_started_once()
+{
+  TEST_ASSERT_EQUAL_UINT32(1, left.started);
+  TEST_ASSERT_EQUAL_UINT32(1, right.started);
+  TEST_ASSERT_EQUAL_UINT32(1, plainStarts);
+}
+
+void test_start_events_post_to_peers()
+{
+  TEST_ASSERT_EQUAL_UINT32(1, left.hellos);
+  TEST_ASSERT_EQUAL_UINT32(1, right.hellos);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Signal_getUsed());
+}
+
+void test_table_lists_definitions()
+{
+  size_t num = 0;
+  bool foundRight = false;
+
+  ACT_ACTOR_FOREACH(def)
+  {
+    num++;
+    if (strcmp(def->name, "right") == 0)
+    {
+      foundRight = true;
+      TEST_ASSERT_EQUAL_PTR(ACT_UPCAST(&right), def->me);
+      TEST_ASSERT_EQUAL(8, def->qd.maxMsg);
+      TEST_ASSERT_EQUAL_INT(2, def->td.pri);
+      TEST_ASSERT_EQUAL(0, ACT_getQueueUsed(def->me));
+    }
+  }
+
+  TEST_ASSERT_EQUAL(3, num);
+  TEST_ASSERT_TRUE(foundRight);
+}
+
+void main()
+{
+  UNITY_BEGIN();
+
+  ACT_startAll();
+  ACT_SLEEPMS(1);
+
+  RUN_TEST(test_all_started_once);
+  RUN_TEST(test_start_events_post_to_peers);
+  RUN_TEST(test_table_lists_definitions);
+
+  UNITY_END();
+}
@@ -0,0 +1,4 @@
+#define ACT_CFG_PORT_SIM 1
+#define ACT_CFG_BATCH 1
+#define ACT_CFG_EVT_TIMESTAMP 1
+#define ACT_MEM_NUM_MESSAGES 10
@@ -0,0 +1,133 @@
+#include <active.h>
+#include <unity.h>
+
+/* Runs on the simulation port. Events posted by the test are processed when it sleeps */
+
+#define MAX_MSG 10
+#define BATCH_CAP 4
+#define MAX_LOG 8
+
+static ACT_QBUF(dspQBuf, MAX_MSG);
+static ACT_Q(dspQ);
+static ACT_THREAD(dspT);
+static ACT_THREAD_STACK_DEFINE(dspStack, 512);
+static ACT_THREAD_STACK_SIZE(dspStackSz, dspStack);
+
+const static ACT_QueueData qddsp = {.maxMsg = MAX_MSG, .queBuf = dspQBuf, .queue = &dspQ};
+const static ACT_ThreadData tddsp = {.thread = &dspT, .pri = 1, .stack = dspStack, .stack_size = dspStackSz};
+
+enum TestUserSignal
+{
+  SAMPLE_MSG = ACT_USER_SIG,
+  FLUSH_SIG
+};
+
+Active dsp;
+
+/* Batch sizes and dispatched signals in order of processing. Dispatched signals are negative */
+static int actions[MAX_LOG];
+static size_t numLog;
+static float sum;
+static bool timestamped;
+static bool aligned;
+
+static void dsp_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type == ACT_SIGNAL && EVT_CAST(e, ACT_Signal)->sig == FLUSH_SIG)
+  {
+    actions[numLog++] = -FLUSH_SIG;
+  }
+}
+
+static void dsp_samples(Active *me, uint16_t header, ACT_BatchSpan const *span)
+{
+  float const *values = span->values;
+  for (size_t i = 0; i < span->len; i++)
+  {
+    sum += values[i];
+  }
+  actions[numLog++] = (int)span->len;
+  timestamped = span->timestamps != NULL;
+  aligned = ((uintptr_t)span->values % ACT_CFG_BATCH_ALIGN) == 0;
+}
+
+static ACT_BATCH_DEFINE(samplesBatch, SAMPLE_MSG, dsp_samples, float, BATCH_CAP);
+
+static float samples[MAX_MSG];
+
+static void postSample(size_t idx)
+{
+  samples[idx] = (float)(idx + 1);
+  ACT_postEvt(&dsp, EVT_UPCAST(ACT_Message_new(&dsp, SAMPLE_MSG, &samples[idx], sizeof(float))));
+}
+
+void setUp(void)
+{
+  numLog = 0;
+  sum = 0;
+  timestamped = false;
+  aligned = false;
+}
+
+void test_batch_gathers_queued_messages()
+{
+  postSample(0);
+  postSample(1);
+  postSample(2);
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(1, numLog);
+  TEST_ASSERT_EQUAL_INT(3, actions[0]);
+  TEST_ASSERT_EQUAL_FLOAT(6.0f, sum);
+  TEST_ASSERT_TRUE(timestamped);
+  TEST_ASSERT_TRUE(aligned);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Message_getUsed());
+}
+
+void test_batch_split_at_capacity()
+{
+  for (size_t i = 0; i < 6; i++)
+  {
+    postSample(i);
+  }
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(2, numLog);
+  TEST_ASSERT_EQUAL_INT(BATCH_CAP, actions[0]);
+  TEST_ASSERT_EQUAL_INT(2, actions[1]);
+  TEST_ASSERT_EQUAL_FLOAT(21.0f, sum);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Message_getUsed());
+}
+
+void test_batch_keeps_event_order()
+{
+  static const ACT_SIGNAL_DEFINE(flushSig, FLUSH_SIG);
+
+  postSample(0);
+  postSample(1);
+  ACT_postEvt(&dsp, EVT_UPCAST(&flushSig));
+  postSample(2);
+  ACT_SLEEPMS(1);
+
+  // The signal ends the first batch and is dispatched before the next one
+  TEST_ASSERT_EQUAL(3, numLog);
+  TEST_ASSERT_EQUAL_INT(2, actions[0]);
+  TEST_ASSERT_EQUAL_INT(-FLUSH_SIG, actions[1]);
+  TEST_ASSERT_EQUAL_INT(1, actions[2]);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Message_getUsed());
+}
+
+void main()
+{
+  UNITY_BEGIN();
+
+  ACT_init(&dsp, dsp_dispatch, &qddsp, &tddsp);
+  ACT_setBatch(&dsp, &samplesBatch);
+  ACT_start(&dsp);
+
+  RUN_TEST(test_batch_gathers_queued_messages);
+  RUN_TEST(test_batch_split_at_capacity);
+  RUN_TEST(test_batch_keeps_event_order);
+
+  UNITY_END();
+}
@@ -0,0 +1,3 @@
+#define ACT_CFG_PORT_SIM 1
+#define ACT_CFG_BOOST 1
+#define ACT_CFG_EVT_TIMESTAMP 1
@@ -0,0 +1,190 @@
+#include <active.h>
+#include <unity.h>
+
+/* Runs on the simulation port. The highest priority ready Active object processes the next event */
+
+#define MAX_MSG 8
+#define NUM_WORK 20
+
+static ACT_QBUF(producerQBuf, MAX_MSG);
+static ACT_Q(producerQ);
+static ACT_THREAD(producerT);
+static ACT_THREAD_STACK_DEFINE(producerStack, 512);
+static ACT_THREAD_STACK_SIZE(producerStackSz, producerStack);
+
+static ACT_QBUF(consumerQBuf, MAX_MSG);
+static ACT_Q(consumerQ);
+static ACT_THREAD(consumerT);
+static ACT_THREAD_STACK_DEFINE(consumerStack, 512);
+static ACT_THREAD_STACK_SIZE(consumerStackSz, consumerStack);
+
+static ACT_QBUF(lateQBuf, MAX_MSG);
+static ACT_Q(lateQ);
+static ACT_THREAD(lateT);
+static ACT_THREAD_STACK_DEFINE(lateStack, 512);
+static ACT_THREAD_STACK_SIZE(lateStackSz, lateStack);
+
+static ACT_QBUF(observerQBuf, MAX_MSG);
+static ACT_Q(observerQ);
+static ACT_THREAD(observerT);
+static ACT_THREAD_STACK_DEFINE(observerStack, 512);
+static ACT_THREAD_STACK_SIZE(observerStackSz, observerStack);
+
+const static ACT_QueueData qdproducer = {.maxMsg = MAX_MSG, .queBuf = producerQBuf, .queue = &producerQ};
+const static ACT_ThreadData tdproducer = {.thread = &producerT, .pri = 1, .stack = producerStack, .stack_size = producerStackSz};
+const static ACT_QueueData qdconsumer = {.maxMsg = MAX_MSG, .queBuf = consumerQBuf, .queue = &consumerQ};
+const static ACT_ThreadData tdconsumer = {.thread = &consumerT, .pri = 2, .stack = consumerStack, .stack_size = consumerStackSz};
+const static ACT_QueueData qdlate = {.maxMsg = MAX_MSG, .queBuf = lateQBuf, .queue = &lateQ};
+const static ACT_ThreadData tdlate = {.thread = &lateT, .pri = 2, .stack = lateStack, .stack_size = lateStackSz};
+const static ACT_QueueData qdobserver = {.maxMsg = MAX_MSG, .queBuf = observerQBuf, .queue = &observerQ};
+const static ACT_ThreadData tdobserver = {.thread = &observerT, .pri = 0, .stack = observerStack, .stack_size = observerStackSz};
+
+enum TestUserSignal
+{
+  WORK_SIG = ACT_USER_SIG,
+  DATA_SIG,
+  HIGH_SIG,
+  LOW_SIG
+};
+
+static const ACT_SIGNAL_DEFINE(workSig, WORK_SIG);
+static const ACT_SIGNAL_DEFINE(dataSig, DATA_SIG);
+
+Active producer;
+Active consumer;
+Active late;
+Active observer;
+
+static size_t numWork;
+static size_t numData;
+static size_t maxDepth;
+static size_t numHigh;
+static size_t numLow;
+static Active const *lastWatermarkSender;
+
+static void producer_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e != EVT_UPCAST(&workSig))
+  {
+    return;
+  }
+
+  ACT_postEvt(&consumer, EVT_UPCAST(&dataSig));
+  size_t depth = ACT_getQueueUsed(&consumer);
+  maxDepth = depth > maxDepth ? depth : maxDepth;
+
+  // Always ready while there is work, starving lower priority Active objects
+  if (++numWork < NUM_WORK)
+  {
+    ACT_postEvt(me, EVT_UPCAST(&workSig));
+  }
+}
+
+static void consumer_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e == EVT_UPCAST(&dataSig))
+  {
+    numData++;
+  }
+}
+
+static void observer_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_SIGNAL)
+  {
+    return;
+  }
+
+  switch (EVT_CAST(e, ACT_Signal)->sig)
+  {
+  case HIGH_SIG:
+    numHigh++;
+    lastWatermarkSender = ACT_EVT_SENDER(e);
+    break;
+  case LOW_SIG:
+    numLow++;
+    break;
+  }
+}
+
+void setUp(void)
+{
+  numWork = 0;
+  numData = 0;
+  maxDepth = 0;
+  numHigh = 0;
+  numLow = 0;
+  lastWatermarkSender = NULL;
+}
+
+void test_boost_on_depth_keeps_queue_below_high_watermark()
+{
+  static const ACT_BoostPolicy policy = {.highDepth = 4, .lowDepth = 1, .pri = 0, .observer = &observer, .highSig = HIGH_SIG, .lowSig = LOW_SIG};
+  ACT_setBoost(&consumer, &policy);
+
+  ACT_postEvt(&producer, EVT_UPCAST(&workSig));
+  ACT_SLEEPMS(1);
+
+  // Without boost, the consumer queue would overflow before the producer is done
+  TEST_ASSERT_EQUAL(NUM_WORK, numData);
+  TEST_ASSERT_EQUAL(4, maxDepth);
+  TEST_ASSERT_FALSE(ACT_isBoosted(&consumer));
+  TEST_ASSERT_TRUE(ACT_getBoosts(&consumer) > 1);
+
+  // Every boost is restored, and both watermarks are seen by the observer
+  TEST_ASSERT_EQUAL(ACT_getBoosts(&consumer), numHigh);
+  TEST_ASSERT_EQUAL(numHigh, numLow);
+  TEST_ASSERT_EQUAL_PTR(&consumer, lastWatermarkSender);
+}
+
+void test_no_boost_below_high_watermark()
+{
+  static const ACT_BoostPolicy policy = {.highDepth = MAX_MSG, .lowDepth = 1, .pri = 0, .observer = &observer, .highSig = HIGH_SIG, .lowSig = LOW_SIG};
+  ACT_setBoost(&consumer, &policy);
+
+  ACT_postEvt(&consumer, EVT_UPCAST(&dataSig));
+  ACT_postEvt(&consumer, EVT_UPCAST(&dataSig));
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(2, numData);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_getBoosts(&consumer));
+  TEST_ASSERT_EQUAL(0, numHigh);
+}
+
+void test_boost_on_event_age()
+{
+  static const ACT_BoostPolicy policy = {.maxAgeUs = 1000, .lowDepth = 1, .pri = 0, .observer = &observer, .highSig = HIGH_SIG, .lowSig = LOW_SIG};
+  ACT_setBoost(&late, &policy);
+
+  // Events wait in the queue until the Active object is started
+  ACT_postEvt(&late, EVT_UPCAST(&dataSig));
+  ACT_postEvt(&late, EVT_UPCAST(&dataSig));
+  ACT_SLEEPMS(5);
+  ACT_start(&late);
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL_UINT32(1, ACT_getBoosts(&late));
+  TEST_ASSERT_FALSE(ACT_isBoosted(&late));
+  TEST_ASSERT_EQUAL(1, numHigh);
+  TEST_ASSERT_EQUAL(1, numLow);
+  TEST_ASSERT_EQUAL_PTR(&late, lastWatermarkSender);
+}
+
+void main()
+{
+  UNITY_BEGIN();
+
+  ACT_init(&producer, producer_dispatch, &qdproducer, &tdproducer);
+  ACT_init(&consumer, consumer_dispatch, &qdconsumer, &tdconsumer);
+  ACT_init(&late, consumer_dispatch, &qdlate, &tdlate);
+  ACT_init(&observer, observer_dispatch, &qdobserver, &tdobserver);
+  ACT_start(&producer);
+  ACT_start(&consumer);
+  ACT_start(&observer);
+
+  RUN_TEST(test_boost_on_depth_keeps_queue_below_high_watermark);
+  RUN_TEST(test_no_boost_below_high_watermark);
+  RUN_TEST(test_boost_on_event_age);
+
+  UNITY_END();
+}
@@ -0,0 +1,348 @@
+#include <string.h>
+
+#include <active.h>
+#include <unity.h>
+
+/* Runs on the simulation port. Events posted by the test are processed when it sleeps */
+
+#define MAX_MSG 8
+#define MAX_TRIES 3
+#define ACK_TIMEOUT_MS 50
+#define NUM_SESSIONS 3
+
+static ACT_QBUF(linkQBuf, MAX_MSG);
+static ACT_Q(linkQ);
+static ACT_THREAD(linkT);
+static ACT_THREAD_STACK_DEFINE(linkStack, 512);
+static ACT_THREAD_STACK_SIZE(linkStackSz, linkStack);
+
+static ACT_QBUF(hubQBuf, MAX_MSG);
+static ACT_Q(hubQ);
+static ACT_THREAD(hubT);
+static ACT_THREAD_STACK_DEFINE(hubStack, 512);
+static ACT_THREAD_STACK_SIZE(hubStackSz, hubStack);
+
+static ACT_QBUF(lateQBuf, MAX_MSG);
+static ACT_Q(lateQ);
+static ACT_THREAD(lateT);
+static ACT_THREAD_STACK_DEFINE(lateStack, 512);
+static ACT_THREAD_STACK_SIZE(lateStackSz, lateStack);
+
+const static ACT_QueueData qdlink = {.maxMsg = MAX_MSG, .queBuf = linkQBuf, .queue = &linkQ};
+const static ACT_ThreadData tdlink = {.thread = &linkT, .pri = 1, .stack = linkStack, .stack_size = linkStackSz};
+const static ACT_QueueData qdhub = {.maxMsg = MAX_MSG, .queBuf = hubQBuf, .queue = &hubQ};
+const static ACT_ThreadData tdhub = {.thread = &hubT, .pri = 1, .stack = hubStack, .stack_size = hubStackSz};
+const static ACT_QueueData qdlate = {.maxMsg = MAX_MSG, .queBuf = lateQBuf, .queue = &lateQ};
+const static ACT_ThreadData tdlate = {.thread = &lateT, .pri = 1, .stack = lateStack, .stack_size = lateStackSz};
+
+enum TestUserSignal
+{
+  REQ_SIG = ACT_USER_SIG, // Starts a request to the link peer
+  ACK_SIG                 // Acknowledge of the link peer
+};
+
+enum TestUserHeader
+{
+  OPEN_MSG = 1, // Starts the session in the payload
+  ACK_MSG       // Acknowledge to the session in the payload
+};
+
+/* Coroutine Active object sending requests, retried until acknowledged */
+typedef struct
+{
+  ACT_CoroActive super;
+  uint8_t tries;
+  uint32_t sent;
+  uint32_t acked;
+  uint32_t failed;
+} Link;
+
+/* Session coroutine sharing the thread of a hub */
+typedef struct
+{
+  ACT_Coro co;
+  uint8_t tries;
+  uint32_t sent;
+  bool acked;
+  bool failed;
+} Session;
+
+/* Active object hosting sessions */
+typedef struct
+{
+  Active super;
+  Session *sessions;
+  size_t numSessions;
+  uint32_t unhandled;
+} Hub;
+
+static Link link;
+static Hub hub;
+static Hub late;
+static Session sessions[NUM_SESSIONS];
+static Session lateSession;
+static ACT_Signal ackSig;
+static ACT_TimEvt ackTimer; // Posts an acknowledge to the link
+
+static void Link_run(ACT_Coro *co, ACT_Evt const *const e)
+{
+  Link *me = (Link *)co->host;
+
+  ACT_CORO_BEGIN(co);
+  for (;;)
+  {
+    ACT_AWAIT_EVT(REQ_SIG, 0);
+    for (me->tries = 0; me->tries < MAX_TRIES; me->tries++)
+    {
+      me->sent++;
+      ACT_AWAIT_EVT(ACK_SIG, ACK_TIMEOUT_MS);
+      if (e != NULL)
+      {
+        break;
+      }
+    }
+
+    if (me->tries == MAX_TRIES)
+    {
+      me->failed++;
+    }
+    else
+    {
+      me->acked++;
+    }
+  }
+  ACT_CORO_END();
+}
+
+static void Session_run(ACT_Coro *co, ACT_Evt const *const e)
+{
+  Session *me = (Session *)co;
+
+  ACT_CORO_BEGIN(co);
+  for (me->tries = 0; me->tries < MAX_TRIES; me->tries++)
+  {
+    me->sent++;
+    ACT_AWAIT_EVT(ACK_MSG, ACK_TIMEOUT_MS);
+    if (e != NULL)
+    {
+      me->acked = true;
+      ACT_Coro_stop(co);
+      return;
+    }
+  }
+  me->failed = true;
+  ACT_CORO_END();
+}
+
+static void Hub_dispatch(Active *me, ACT_Evt const *const e)
+{
+  Hub *hubPtr = (Hub *)me;
+
+  // Session messages are routed by payload, timeouts are offered to all sessions
+  if (e->type == ACT_MESSAGE)
+  {
+    ACT_Message const *msg = EVT_CAST(e, ACT_Message);
+    Session *session = msg->payload;
+    if (msg->header == OPEN_MSG)
+    {
+      ACT_Coro_start(&session->co, e);
+      return;
+    }
+    if (ACT_Coro_dispatch(&session->co, e))
+    {
+      return;
+    }
+  }
+  else if (e->type == ACT_SIGNAL && EVT_CAST(e, ACT_Signal)->sig == ACT_START_SIG)
+  {
+    return;
+  }
+  else
+  {
+    for (size_t i = 0; i < hubPtr->numSessions; i++)
+    {
+      if (ACT_Coro_dispatch(&hubPtr->sessions[i].co, e))
+      {
+        return;
+      }
+    }
+  }
+
+  hubPtr->unhandled++;
+}
+
+static void postSig(Active *receiver, uint16_t sig)
+{
+  ACT_postEvt(receiver, EVT_UPCAST(ACT_Signal_new(receiver, sig)));
+}
+
+static void postMsg(Active *receiver, uint16_t header, Session *session)
+{
+  ACT_postEvt(receiver, EVT_UPCAST(ACT_Message_new(receiver, header, session, sizeof(*session))));
+}
+
+void setUp(void)
+{
+  link.sent = 0;
+  link.acked = 0;
+  link.failed = 0;
+  hub.unhandled = 0;
+  late.unhandled = 0;
+  memset(sessions, 0, sizeof(sessions));
+  memset(&lateSession, 0, sizeof(lateSession));
+  for (size_t i = 0; i < NUM_SESSIONS; i++)
+  {
+    ACT_Coro_init(&sessions[i].co, &hub.super, Session_run);
+  }
+}
+
+void test_ack_before_timeout()
+{
+  postSig(ACT_UPCAST(&link), REQ_SIG);
+  ACT_SLEEPMS(30);
+  postSig(ACT_UPCAST(&link), ACK_SIG);
+  ACT_SLEEPMS(200);
+
+  TEST_ASSERT_EQUAL_UINT32(1, link.sent);
+  TEST_ASSERT_EQUAL_UINT32(1, link.acked);
+  TEST_ASSERT_EQUAL_UINT32(0, link.failed);
+  TEST_ASSERT_TRUE(ACT_Coro_isRunning(&link.super.coro));
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Signal_getUsed());
+}
+
+void test_retry_on_timeout()
+{
+  postSig(ACT_UPCAST(&link), REQ_SIG);
+  ACT_SLEEPMS(ACK_TIMEOUT_MS + 10);
+  TEST_ASSERT_EQUAL_UINT32(2, link.sent);
+
+  postSig(ACT_UPCAST(&link), ACK_SIG);
+  ACT_SLEEPMS(200);
+  TEST_ASSERT_EQUAL_UINT32(2, link.sent);
+  TEST_ASSERT_EQUAL_UINT32(1, link.acked);
+
+  // Awaits the next request again
+  postSig(ACT_UPCAST(&link), REQ_SIG);
+  ACT_SLEEPMS(200);
+  TEST_ASSERT_EQUAL_UINT32(2 + MAX_TRIES, link.sent);
+  TEST_ASSERT_EQUAL_UINT32(1, link.failed);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Signal_getUsed());
+}
+
+void test_unawaited_event_not_consumed()
+{
+  ACT_Signal *ack = ACT_Signal_new(ACT_UPCAST(&link), ACK_SIG);
+
+  // Awaiting REQ_SIG
+  TEST_ASSERT_FALSE(ACT_Coro_dispatch(&link.super.coro, EVT_UPCAST(ack)));
+  TEST_ASSERT_EQUAL_UINT32(0, link.acked);
+
+  ACT_postEvt(ACT_UPCAST(&link), EVT_UPCAST(ack));
+  ACT_SLEEPMS(1);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Signal_getUsed());
+}
+
+void test_sessions_share_host_thread()
+{
+  for (size_t i = 0; i < NUM_SESSIONS; i++)
+  {
+    postMsg(&hub.super, OPEN_MSG, &sessions[i]);
+  }
+  ACT_SLEEPMS(10);
+  TEST_ASSERT_TRUE(ACT_Coro_isRunning(&sessions[1].co));
+
+  postMsg(&hub.super, ACK_MSG, &sessions[0]);
+  ACT_SLEEPMS(ACK_TIMEOUT_MS);
+  postMsg(&hub.super, ACK_MSG, &sessions[2]);
+  ACT_SLEEPMS(200);
+
+  TEST_ASSERT_TRUE(sessions[0].acked);
+  TEST_ASSERT_EQUAL_UINT32(1, sessions[0].sent);
+  TEST_ASSERT_TRUE(sessions[1].failed);
+  TEST_ASSERT_EQUAL_UINT32(MAX_TRIES, sessions[1].sent);
+  TEST_ASSERT_TRUE(sessions[2].acked);
+  TEST_ASSERT_EQUAL_UINT32(2, sessions[2].sent);
+
+  for (size_t i = 0; i < NUM_SESSIONS; i++)
+  {
+    TEST_ASSERT_FALSE(ACT_Coro_isRunning(&sessions[i].co));
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, hub.unhandled);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Message_getUsed());
+}
+
+void test_expired_timeout_dropped_after_ack()
+{
+  ACT_Coro_init(&lateSession.co, &late.super, Session_run);
+  ACT_Coro_start(&lateSession.co, NULL);
+
+  // Host is not started, so the expired timeout stays queued while the acknowledge is dispatched
+  ACT_SLEEPMS(ACK_TIMEOUT_MS + 10);
+  ACT_Message *ack = ACT_Message_new(&late.super, ACK_MSG, &lateSession, sizeof(lateSession));
+  TEST_ASSERT_TRUE(ACT_Coro_dispatch(&lateSession.co, EVT_UPCAST(ack)));
+  TEST_ASSERT_TRUE(lateSession.acked);
+  ACT_mem_gc(EVT_UPCAST(ack));
+
+  // The expired timeout does not time out the next session
+  lateSession.acked = false;
+  ACT_Coro_start(&lateSession.co, NULL);
+  ACT_start(&late.super);
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL_UINT32(2, lateSession.sent);
+  TEST_ASSERT_EQUAL_UINT32(0, late.unhandled);
+
+  ACT_SLEEPMS(ACK_TIMEOUT_MS);
+  TEST_ASSERT_EQUAL_UINT32(3, lateSession.sent);
+
+  // Stops the timeout, setUp clears the session
+  ACT_Coro_stop(&lateSession.co);
+}
+
+void test_ack_in_same_tick_as_timeout()
+{
+  // Started first, so the acknowledge is posted in the tick the timeout expires, before it
+  ACT_TimeEvt_start(&ackTimer, ACK_TIMEOUT_MS, 0);
+  postSig(ACT_UPCAST(&link), REQ_SIG);
+  ACT_SLEEPMS(ACK_TIMEOUT_MS + 10);
+  TEST_ASSERT_EQUAL_UINT32(1, link.sent);
+  TEST_ASSERT_EQUAL_UINT32(1, link.acked);
+
+  // The expired timeout does not time out the next request
+  postSig(ACT_UPCAST(&link), REQ_SIG);
+  ACT_SLEEPMS(ACK_TIMEOUT_MS / 2);
+  postSig(ACT_UPCAST(&link), ACK_SIG);
+  ACT_SLEEPMS(200);
+  TEST_ASSERT_EQUAL_UINT32(2, link.sent);
+  TEST_ASSERT_EQUAL_UINT32(2, link.acked);
+  TEST_ASSERT_EQUAL_UINT32(0, link.failed);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Signal_getUsed());
+}
+
+void main()
+{
+  UNITY_BEGIN();
+
+  ACT_CoroActive_init(&link.super, Link_run, &qdlink, &tdlink);
+  ACT_start(ACT_UPCAST(&link));
+  ACT_Signal_init(&ackSig, ACT_UPCAST(&link), ACK_SIG);
+  ACT_TimEvt_init(&ackTimer, ACT_UPCAST(&link), EVT_UPCAST(&ackSig), ACT_UPCAST(&link), NULL);
+
+  hub.sessions = sessions;
+  hub.numSessions = NUM_SESSIONS;
+  ACT_init(&hub.super, Hub_dispatch, &qdhub, &tdhub);
+  ACT_start(&hub.super);
+
+  late.sessions = &lateSession;
+  late.numSessions = 1;
+  ACT_init(&late.super, Hub_dispatch, &qdlate, &tdlate);
+
+  RUN_TEST(test_ack_before_timeout);
+  RUN_TEST(test_retry_on_timeout);
+  RUN_TEST(test_unawaited_event_not_consumed);
+  RUN_TEST(test_sessions_share_host_thread);
+  RUN_TEST(test_expired_timeout_dropped_after_ack);
+  RUN_TEST(test_ack_in_same_tick_as_timeout);
+
+  UNITY_END();
+}
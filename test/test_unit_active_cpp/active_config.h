@@ -0,0 +1,2 @@
+#define ACT_CFG_PORT_SIM 1
+#define ACT_CFG_MAX_EVT_TYPES 7
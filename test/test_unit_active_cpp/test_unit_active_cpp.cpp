@@ -0,0 +1,244 @@
+#include <active.hpp>
+#include <unity.h>
+
+/* Runs on the simulation port. Events posted by the test are processed when it sleeps */
+
+#define MAX_MSG 4
+#define NUM_SAMPLES 2
+
+enum TestSignals
+{
+  PING_SIG = ACT_USER_SIG,
+  OTHER_SIG
+};
+
+struct Sample
+{
+  static constexpr ACT_EvtType type = act::evtType(0);
+  uint32_t timestamp;
+  int16_t axis[4];
+};
+
+/* Event with a destructor, run when the event is freed */
+struct Tracked
+{
+  static constexpr ACT_EvtType type = act::evtType(1);
+  static size_t numDestroyed;
+
+  explicit Tracked(uint32_t v) : value(v) {}
+  ~Tracked() { numDestroyed++; }
+
+  uint32_t value;
+};
+size_t Tracked::numDestroyed;
+
+/* Not handled by Sink */
+struct Unhandled
+{
+  static constexpr ACT_EvtType type = act::evtType(2);
+  uint8_t dummy;
+};
+
+static act::EventPool<Sample, NUM_SAMPLES> samplePool;
+static act::EventPool<Tracked, 1> trackedPool;
+static act::EventPool<Unhandled, 1> unhandledPool;
+
+class Sink : public act::Actor<Sink, act::Sig<ACT_START_SIG>, act::Sig<PING_SIG>, Sample, Tracked, ACT_Signal, ACT_Message>
+{
+public:
+  void on(act::Sig<ACT_START_SIG>) { numStarted++; }
+  void on(act::Sig<PING_SIG>) { numPings++; }
+  void on(ACT_Signal const &s) { lastOtherSig = s.sig; }
+  void on(ACT_Message const &m) { lastHeader = m.header; }
+  void on(Sample const &s)
+  {
+    numSamples++;
+    lastTimestamp = s.timestamp;
+    lastSender = ACT_EVT_SENDER(act::evtOf(s));
+  }
+  void on(Tracked const &t) { lastTracked = t.value; }
+
+  size_t numStarted;
+  size_t numPings;
+  uint16_t lastOtherSig;
+  uint16_t lastHeader;
+  size_t numSamples;
+  uint32_t lastTimestamp;
+  Active const *lastSender;
+  uint32_t lastTracked;
+};
+
+// Not static: alignas must precede the declaration specifiers in C++
+ACT_QBUF(sinkQBuf, MAX_MSG);
+static ACT_Q(sinkQ);
+static ACT_THREAD(sinkT);
+static ACT_THREAD_STACK_DEFINE(sinkStack, 512);
+static ACT_THREAD_STACK_SIZE(sinkStackSz, sinkStack);
+
+// Designators in declaration order in C++
+const static ACT_QueueData qdsink = {.queue = &sinkQ, .queBuf = sinkQBuf, .maxMsg = MAX_MSG};
+const static ACT_ThreadData tdsink = {.thread = &sinkT, .stack = sinkStack, .stack_size = sinkStackSz, .pri = 1};
+
+static Sink sink;
+
+void setUp(void)
+{
+  sink.numPings = 0;
+  sink.lastOtherSig = 0;
+  sink.lastHeader = 0;
+  sink.numSamples = 0;
+  sink.lastTimestamp = 0;
+  sink.lastSender = nullptr;
+  sink.lastTracked = 0;
+  Tracked::numDestroyed = 0;
+}
+
+void test_block_holds_base_and_event()
+{
+  TEST_ASSERT_GREATER_OR_EQUAL(sizeof(ACT_Evt), act::EventInfo<Sample>::offset);
+  TEST_ASSERT_EQUAL(0, act::EventInfo<Sample>::offset % alignof(Sample));
+  TEST_ASSERT_GREATER_OR_EQUAL(act::EventInfo<Sample>::offset + sizeof(Sample), act::EventInfo<Sample>::blockSize);
+}
+
+void test_start_signal_dispatched()
+{
+  TEST_ASSERT_EQUAL(1, sink.numStarted);
+}
+
+void test_make_event_holds_reference()
+{
+  act::EventPtr<Sample> s = act::make_event<Sample>(sink.active(), 42u);
+
+  TEST_ASSERT_TRUE(s);
+  TEST_ASSERT_EQUAL_UINT32(42, s->timestamp);
+  TEST_ASSERT_EQUAL(Sample::type, s.evt()->type);
+  TEST_ASSERT_EQUAL_UINT16(1, ACT_mem_getRefCount(s.evt()));
+  TEST_ASSERT_EQUAL_UINT32(1, samplePool.used());
+
+  s.reset();
+
+  TEST_ASSERT_FALSE(s);
+  TEST_ASSERT_EQUAL_UINT32(0, samplePool.used());
+}
+
+void test_post_dispatches_typed_handler()
+{
+  act::EventPtr<Sample> s = act::make_event<Sample>(sink.active(), 7u);
+  TEST_ASSERT_EQUAL_INT(0, s.post(sink.active()));
+
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(1, sink.numSamples);
+  TEST_ASSERT_EQUAL_UINT32(7, sink.lastTimestamp);
+  TEST_ASSERT_EQUAL_PTR(sink.active(), sink.lastSender);
+
+  // Kept by the handle after dispatch
+  TEST_ASSERT_EQUAL_UINT32(1, samplePool.used());
+  s.reset();
+  TEST_ASSERT_EQUAL_UINT32(0, samplePool.used());
+}
+
+void test_freed_after_dispatch_when_handle_released()
+{
+  {
+    act::EventPtr<Sample> s = act::make_event<Sample>(sink.active(), 8u);
+    s.post(sink.active());
+    s.post(sink.active());
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, samplePool.used());
+
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(2, sink.numSamples);
+  TEST_ASSERT_EQUAL_UINT32(0, samplePool.used());
+}
+
+void test_moved_handle_released_once()
+{
+  act::EventPtr<Sample> a = act::make_event<Sample>(sink.active(), 1u);
+  act::EventPtr<Sample> b = std::move(a);
+
+  TEST_ASSERT_FALSE(a);
+  TEST_ASSERT_TRUE(b);
+  TEST_ASSERT_EQUAL_UINT16(1, ACT_mem_getRefCount(b.evt()));
+
+  a = std::move(b);
+  TEST_ASSERT_TRUE(a);
+  a.reset();
+  b.reset();
+
+  TEST_ASSERT_EQUAL_UINT32(0, samplePool.used());
+}
+
+void test_try_make_event_empty_pool()
+{
+  act::EventPtr<Sample> s1 = act::try_make_event<Sample>(sink.active(), 1u);
+  act::EventPtr<Sample> s2 = act::try_make_event<Sample>(sink.active(), 2u);
+  act::EventPtr<Sample> s3 = act::try_make_event<Sample>(sink.active(), 3u);
+
+  TEST_ASSERT_TRUE(s1);
+  TEST_ASSERT_TRUE(s2);
+  TEST_ASSERT_FALSE(s3);
+  TEST_ASSERT_NULL(s3.get());
+}
+
+void test_destructor_run_when_freed()
+{
+  act::EventPtr<Tracked> t = act::make_event<Tracked>(sink.active(), 5u);
+  t.post(sink.active());
+  t.reset();
+
+  TEST_ASSERT_EQUAL(0, Tracked::numDestroyed);
+
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL_UINT32(5, sink.lastTracked);
+  TEST_ASSERT_EQUAL(1, Tracked::numDestroyed);
+}
+
+void test_signals_dispatched_by_signal()
+{
+  ACT_postEvt(sink.active(), EVT_UPCAST(ACT_Signal_new(sink.active(), PING_SIG)));
+  ACT_postEvt(sink.active(), EVT_UPCAST(ACT_Signal_new(sink.active(), OTHER_SIG)));
+  ACT_postEvt(sink.active(), EVT_UPCAST(ACT_Message_new(sink.active(), 3, nullptr, 0)));
+
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(1, sink.numPings);
+  TEST_ASSERT_EQUAL_UINT16(OTHER_SIG, sink.lastOtherSig);
+  TEST_ASSERT_EQUAL_UINT16(3, sink.lastHeader);
+}
+
+void test_unlisted_event_dropped()
+{
+  act::EventPtr<Unhandled> u = act::make_event<Unhandled>(sink.active());
+  u.post(sink.active());
+  u.reset();
+
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(0, sink.numSamples);
+  TEST_ASSERT_EQUAL_UINT32(0, unhandledPool.used());
+}
+
+int main()
+{
+  UNITY_BEGIN();
+
+  sink.init(&qdsink, &tdsink);
+  sink.start();
+  ACT_SLEEPMS(1);
+
+  RUN_TEST(test_block_holds_base_and_event);
+  RUN_TEST(test_start_signal_dispatched);
+  RUN_TEST(test_make_event_holds_reference);
+  RUN_TEST(test_post_dispatches_typed_handler);
+  RUN_TEST(test_freed_after_dispatch_when_handle_released);
+  RUN_TEST(test_moved_handle_released_once);
+  RUN_TEST(test_try_make_event_empty_pool);
+  RUN_TEST(test_destructor_run_when_freed);
+  RUN_TEST(test_signals_dispatched_by_signal);
+  RUN_TEST(test_unlisted_event_dropped);
+
+  return UNITY_END();
+}
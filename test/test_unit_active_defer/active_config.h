@@ -0,0 +1,4 @@
+#define ACT_CFG_PORT_SIM 1
+#define ACT_CFG_DEFER 1
+#define ACT_CFG_DEFER_MAX 2
+#define ACT_MEM_NUM_SIGNALS 8
@@ -0,0 +1,157 @@
+#include <string.h>
+
+#include <active.h>
+#include <unity.h>
+
+/* Runs on the simulation port. Events posted by the test are processed when it sleeps */
+
+#define MAX_MSG 8
+#define MAX_LOG 8
+
+static ACT_QBUF(flashQBuf, MAX_MSG);
+static ACT_Q(flashQ);
+static ACT_THREAD(flashT);
+static ACT_THREAD_STACK_DEFINE(flashStack, 512);
+static ACT_THREAD_STACK_SIZE(flashStackSz, flashStack);
+
+const static ACT_QueueData qdflash = {.maxMsg = MAX_MSG, .queBuf = flashQBuf, .queue = &flashQ};
+const static ACT_ThreadData tdflash = {.thread = &flashT, .pri = 1, .stack = flashStack, .stack_size = flashStackSz};
+
+enum TestUserSignal
+{
+  ERASE_SIG = ACT_USER_SIG, // Requests are deferred until DONE_SIG
+  DONE_SIG,                 // Recalls all deferred requests
+  REQ_A_SIG,
+  REQ_B_SIG,
+  REQ_C_SIG
+};
+
+Active flash;
+
+static bool erasing;
+static uint16_t served[MAX_LOG];
+static size_t numServed;
+static int lastDeferStatus;
+
+static void flash_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_SIGNAL)
+  {
+    return;
+  }
+
+  uint16_t sig = EVT_CAST(e, ACT_Signal)->sig;
+  switch (sig)
+  {
+  case ERASE_SIG:
+    erasing = true;
+    break;
+  case DONE_SIG:
+    erasing = false;
+    while (ACT_recall(me))
+    {
+    }
+    break;
+  case ACT_START_SIG:
+    break;
+  default:
+    if (erasing)
+    {
+      lastDeferStatus = ACT_defer(me, e);
+      if (lastDeferStatus == ACT_DEFER_OK)
+      {
+        break;
+      }
+    }
+    served[numServed++] = sig;
+    break;
+  }
+}
+
+static ACT_Signal *post(uint16_t sig)
+{
+  ACT_Signal *s = ACT_Signal_new(&flash, sig);
+  ACT_postEvt(&flash, EVT_UPCAST(s));
+  return s;
+}
+
+void setUp(void)
+{
+  erasing = false;
+  numServed = 0;
+  memset(served, 0, sizeof(served));
+  lastDeferStatus = ACT_DEFER_OK;
+}
+
+void test_defer_keeps_reference_until_recalled()
+{
+  post(ERASE_SIG);
+  ACT_Signal *a = post(REQ_A_SIG);
+  post(REQ_B_SIG);
+  ACT_SLEEPMS(1);
+
+  // Deferred events keep the reference taken when posted
+  TEST_ASSERT_EQUAL(0, numServed);
+  TEST_ASSERT_EQUAL(2, ACT_getDeferred(&flash));
+  TEST_ASSERT_EQUAL_UINT32(2, ACT_mem_Signal_getUsed());
+  TEST_ASSERT_EQUAL_UINT16(1, ACT_mem_getRefCount(EVT_UPCAST(a)));
+
+  post(DONE_SIG);
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(2, numServed);
+  TEST_ASSERT_EQUAL(0, ACT_getDeferred(&flash));
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Signal_getUsed());
+}
+
+void test_recalled_events_go_before_queued_events()
+{
+  post(ERASE_SIG);
+  post(REQ_A_SIG);
+  post(REQ_B_SIG);
+  post(DONE_SIG);
+  post(REQ_C_SIG);
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(3, numServed);
+  TEST_ASSERT_EQUAL_UINT16(REQ_A_SIG, served[0]);
+  TEST_ASSERT_EQUAL_UINT16(REQ_B_SIG, served[1]);
+  TEST_ASSERT_EQUAL_UINT16(REQ_C_SIG, served[2]);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Signal_getUsed());
+}
+
+void test_defer_full()
+{
+  post(ERASE_SIG);
+  post(REQ_A_SIG);
+  post(REQ_B_SIG);
+  post(REQ_C_SIG);
+  ACT_SLEEPMS(1);
+
+  // Third request does not fit and is processed at once
+  TEST_ASSERT_EQUAL_INT(ACT_DEFER_ERR_FULL, lastDeferStatus);
+  TEST_ASSERT_EQUAL(1, numServed);
+  TEST_ASSERT_EQUAL_UINT16(REQ_C_SIG, served[0]);
+
+  post(DONE_SIG);
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(3, numServed);
+  TEST_ASSERT_EQUAL_UINT16(REQ_A_SIG, served[1]);
+  TEST_ASSERT_EQUAL_UINT16(REQ_B_SIG, served[2]);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Signal_getUsed());
+}
+
+void main()
+{
+  UNITY_BEGIN();
+
+  ACT_init(&flash, flash_dispatch, &qdflash, &tdflash);
+  ACT_start(&flash);
+
+  RUN_TEST(test_defer_keeps_reference_until_recalled);
+  RUN_TEST(test_recalled_events_go_before_queued_events);
+  RUN_TEST(test_defer_full);
+
+  UNITY_END();
+}
@@ -0,0 +1,3 @@
+#define ACT_CFG_PORT_SIM 1
+#define ACT_CFG_MAILBOX ACT_MAILBOX_EDF
+#define ACT_MEM_NUM_SIGNALS 10
@@ -0,0 +1,136 @@
+#include <active.h>
+#include <unity.h>
+
+/* Runs on the simulation port, so deadlines are checked against exact virtual times */
+
+#define MAX_MSG 8
+#define MAX_LOG 8
+
+static ACT_QBUF(rxQBuf, MAX_MSG);
+static ACT_Q(rxQ);
+static ACT_THREAD(rxT);
+static ACT_THREAD_STACK_DEFINE(rxStack, 512);
+static ACT_THREAD_STACK_SIZE(rxStackSz, rxStack);
+
+const static ACT_QueueData qdrx = {.maxMsg = MAX_MSG, .queBuf = rxQBuf, .queue = &rxQ};
+const static ACT_ThreadData tdrx = {.thread = &rxT, .pri = 1, .stack = rxStack, .stack_size = rxStackSz};
+
+enum TestUserSignal
+{
+  BUSY_SIG = ACT_USER_SIG, // Processing takes 20 ms
+  A_SIG,
+  B_SIG,
+  C_SIG,
+  D_SIG,
+  E_SIG
+};
+
+Active rx;
+
+static uint16_t processed[MAX_LOG];
+static size_t numProcessed;
+static uint16_t staleSig;
+static uint32_t staleLateUs;
+
+static void rx_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_SIGNAL || EVT_CAST(e, ACT_Signal)->sig == ACT_START_SIG)
+  {
+    return;
+  }
+
+  uint16_t sig = EVT_CAST(e, ACT_Signal)->sig;
+  processed[numProcessed++] = sig;
+  if (sig == BUSY_SIG)
+  {
+    ACT_SLEEPMS(20);
+  }
+}
+
+static void onStale(ACT_Evt const *e, uint32_t lateUs)
+{
+  staleSig = EVT_CAST(e, ACT_Signal)->sig;
+  staleLateUs = lateUs;
+}
+
+static void post(uint16_t sig, uint32_t deadlineUs)
+{
+  ACT_Signal *s = ACT_Signal_new(&rx, sig);
+  ACT_Evt_setDeadline(EVT_UPCAST(s), deadlineUs);
+  ACT_postEvt(&rx, EVT_UPCAST(s));
+}
+
+void setUp(void)
+{
+  numProcessed = 0;
+  staleSig = 0;
+}
+
+static void test_edf_earliest_deadline_first()
+{
+  // Posted while the receiver does not run
+  post(A_SIG, 500000);
+  post(B_SIG, 100000);
+  post(C_SIG, 0);
+  post(D_SIG, 300000);
+  post(E_SIG, 100000);
+  TEST_ASSERT_EQUAL_UINT(5, ACT_getQueueUsed(&rx));
+
+  ACT_SLEEPMS(1);
+
+  const uint16_t expected[] = {B_SIG, E_SIG, D_SIG, A_SIG, C_SIG};
+  TEST_ASSERT_EQUAL_UINT(5, numProcessed);
+  TEST_ASSERT_EQUAL_MEMORY(expected, processed, sizeof(expected));
+}
+
+static void test_edf_stale_event_dropped()
+{
+  uint32_t staleBefore = ACT_EdfMbox_getStale(&rxQ);
+
+  post(BUSY_SIG, 1000);
+  post(A_SIG, 5000);  // Stale after BUSY_SIG is processed
+  post(B_SIG, 50000);
+  post(C_SIG, 0);     // Never stale
+  ACT_SLEEPMS(100);
+
+  const uint16_t expected[] = {BUSY_SIG, B_SIG, C_SIG};
+  TEST_ASSERT_EQUAL_UINT(3, numProcessed);
+  TEST_ASSERT_EQUAL_MEMORY(expected, processed, sizeof(expected));
+
+  TEST_ASSERT_EQUAL_UINT32(staleBefore + 1, ACT_EdfMbox_getStale(&rxQ));
+  TEST_ASSERT_EQUAL_UINT16(A_SIG, staleSig);
+  TEST_ASSERT_EQUAL_UINT32(15000, staleLateUs);
+
+  // Stale events are freed
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Signal_getUsed());
+}
+
+static void test_edf_full()
+{
+  for (int i = 0; i < MAX_MSG; i++)
+  {
+    post(A_SIG, 1000);
+  }
+  ACT_Signal *s = ACT_Signal_new(&rx, B_SIG);
+  TEST_ASSERT_EQUAL_INT(ACT_MBOX_ERR_FULL, ACT_EdfMbox_put(&rxQ, &(ACT_QEntry){ACT_QENTRY_FROM_EVT(EVT_UPCAST(s))}));
+  ACT_mem_gc(EVT_UPCAST(s));
+
+  ACT_SLEEPMS(1);
+  TEST_ASSERT_EQUAL_UINT(MAX_MSG, numProcessed);
+}
+
+void main()
+{
+  UNITY_BEGIN();
+
+  ACT_init(&rx, rx_dispatch, &qdrx, &tdrx);
+  ACT_EdfMbox_setStaleFn(&rxQ, onStale);
+  ACT_start(&rx);
+  ACT_SLEEPMS(1);
+
+  RUN_TEST(test_edf_earliest_deadline_first);
+  RUN_TEST(test_edf_stale_event_dropped);
+  RUN_TEST(test_edf_full);
+
+  UNITY_END();
+}
@@ -0,0 +1,139 @@
+#include <string.h>
+
+#include <active.h>
+#include <unity.h>
+
+/* Runs on the simulation port. Events posted by the test are processed when it sleeps */
+
+#define MAX_MSG 4
+#define NUM_SAMPLES 2
+
+static ACT_QBUF(sinkQBuf, MAX_MSG);
+static ACT_Q(sinkQ);
+static ACT_THREAD(sinkT);
+static ACT_THREAD_STACK_DEFINE(sinkStack, 512);
+static ACT_THREAD_STACK_SIZE(sinkStackSz, sinkStack);
+
+const static ACT_QueueData qdsink = {.maxMsg = MAX_MSG, .queBuf = sinkQBuf, .queue = &sinkQ};
+const static ACT_ThreadData tdsink = {.thread = &sinkT, .pri = 1, .stack = sinkStack, .stack_size = sinkStackSz};
+
+#define SAMPLE_EVT ((ACT_EvtType)(ACT_USER_EVT + 0))
+
+/* Application event type, stored by value in its own pool */
+typedef struct
+{
+  ACT_Evt super;
+  uint32_t timestamp;
+  int16_t axis[16];
+} SampleEvt;
+
+static ACT_EVT_POOL_DEFINE(Sample_Mem, SampleEvt, NUM_SAMPLES);
+
+Active sink;
+
+static size_t numReceived;
+static uint32_t lastTimestamp;
+static size_t numDestroyed;
+static uint32_t lastDestroyed;
+
+static void sink_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type == SAMPLE_EVT)
+  {
+    numReceived++;
+    lastTimestamp = EVT_CAST(e, SampleEvt)->timestamp;
+  }
+}
+
+static void sample_destroy(ACT_Evt *e)
+{
+  numDestroyed++;
+  lastDestroyed = EVT_CAST(e, SampleEvt)->timestamp;
+}
+
+static SampleEvt *sample_new(uint32_t timestamp)
+{
+  SampleEvt *s = (SampleEvt *)ACT_Evt_new(SAMPLE_EVT, &sink);
+  s->timestamp = timestamp;
+  memset(s->axis, 0, sizeof(s->axis));
+  return s;
+}
+
+void setUp(void)
+{
+  numReceived = 0;
+  lastTimestamp = 0;
+  numDestroyed = 0;
+  lastDestroyed = 0;
+}
+
+void test_pool_blocks_fit_event()
+{
+  TEST_ASSERT_EQUAL(sizeof(SampleEvt), Sample_Mem.blockSize);
+  TEST_ASSERT_EQUAL(NUM_SAMPLES, Sample_Mem.numBlocks);
+}
+
+void test_evt_new()
+{
+  SampleEvt *s = sample_new(42);
+
+  TEST_ASSERT_EQUAL(SAMPLE_EVT, s->super.type);
+  TEST_ASSERT_TRUE(s->super._dynamic);
+  TEST_ASSERT_EQUAL_UINT16(0, s->super._refcnt);
+  TEST_ASSERT_EQUAL_UINT32(1, ACT_mem_getUsed(SAMPLE_EVT));
+
+  ACT_mem_gc(EVT_UPCAST(s));
+
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_getUsed(SAMPLE_EVT));
+  TEST_ASSERT_EQUAL(1, numDestroyed);
+  TEST_ASSERT_EQUAL_UINT32(42, lastDestroyed);
+}
+
+void test_post_and_free_after_dispatch()
+{
+  ACT_postEvt(&sink, EVT_UPCAST(sample_new(1)));
+  ACT_postEvt(&sink, EVT_UPCAST(sample_new(2)));
+
+  // Built-in pools are not used by application event types
+  TEST_ASSERT_EQUAL_UINT32(NUM_SAMPLES, ACT_mem_getUsed(SAMPLE_EVT));
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_getUsed(ACT_MESSAGE));
+  TEST_ASSERT_EQUAL(0, numDestroyed);
+
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(2, numReceived);
+  TEST_ASSERT_EQUAL_UINT32(2, lastTimestamp);
+  TEST_ASSERT_EQUAL(2, numDestroyed);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_getUsed(SAMPLE_EVT));
+}
+
+void test_static_evt_not_freed()
+{
+  static SampleEvt s;
+  ACT_Evt_init(EVT_UPCAST(&s), &sink, SAMPLE_EVT);
+  s.timestamp = 7;
+
+  ACT_postEvt(&sink, EVT_UPCAST(&s));
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(1, numReceived);
+  TEST_ASSERT_EQUAL_UINT32(7, lastTimestamp);
+  TEST_ASSERT_EQUAL(0, numDestroyed);
+}
+
+void main()
+{
+  UNITY_BEGIN();
+
+  ACT_EvtType_register(SAMPLE_EVT, &Sample_Mem, sample_destroy);
+
+  ACT_init(&sink, sink_dispatch, &qdsink, &tdsink);
+  ACT_start(&sink);
+
+  RUN_TEST(test_pool_blocks_fit_event);
+  RUN_TEST(test_evt_new);
+  RUN_TEST(test_post_and_free_after_dispatch);
+  RUN_TEST(test_static_evt_not_freed);
+
+  UNITY_END();
+}
@@ -0,0 +1 @@
+#define ACT_CFG_EVT_HANDLES 1
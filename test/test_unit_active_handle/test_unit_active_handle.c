@@ -0,0 +1,128 @@
+#include <active.h>
+#include <unity.h>
+
+static ACT_QBUF(testQBuf, 1);
+static ACT_Q(testQ);
+static ACT_THREAD(testT);
+static ACT_THREAD_STACK_DEFINE(testTStack, 512);
+static ACT_THREAD_STACK_SIZE(testTStackSz, testTStack);
+
+const static ACT_QueueData qdtest = {.maxMsg = 1,
+                                     .queBuf = testQBuf,
+                                     .queue = &testQ};
+
+const static ACT_ThreadData tdtest = {.thread = &testT,
+                                      .pri = 1,
+                                      .stack = testTStack,
+                                      .stack_size = testTStackSz};
+
+enum TestUserSignal
+{
+  TEST_SIG = ACT_USER_SIG
+};
+
+Active ao;
+
+static ACT_SIGNAL_DEFINE(staticSig, TEST_SIG);
+
+static uint32_t processed;
+
+static void ao_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type == ACT_SIGNAL && EVT_CAST(e, ACT_Signal)->sig == TEST_SIG)
+  {
+    processed++;
+  }
+}
+
+void test_handle_queue_entry_size()
+{
+  TEST_ASSERT_EQUAL(sizeof(uint16_t), sizeof(ACT_QEntry));
+}
+
+void test_handle_active()
+{
+  ACT_Handle h = ACT_getHandle(&ao);
+
+  TEST_ASSERT_NOT_EQUAL(ACT_SENDER_NONE, h);
+  TEST_ASSERT_EQUAL_PTR(&ao, ACT_fromHandle(h));
+  TEST_ASSERT_NULL(ACT_fromHandle(ACT_SENDER_NONE));
+}
+
+void test_handle_sender()
+{
+  ACT_Signal s;
+  ACT_Signal_init(&s, &ao, TEST_SIG);
+
+  TEST_ASSERT_EQUAL_PTR(&ao, ACT_EVT_SENDER(&s));
+  TEST_ASSERT_NULL(ACT_EVT_SENDER(&staticSig));
+}
+
+void test_handle_dynamic_event()
+{
+  ACT_Signal *s = ACT_Signal_new(&ao, TEST_SIG);
+  ACT_Message *m = ACT_Message_new(&ao, 0xBABA, NULL, 0);
+
+  ACT_Handle hs = ACT_mem_toHandle(EVT_UPCAST(s));
+  ACT_Handle hm = ACT_mem_toHandle(EVT_UPCAST(m));
+
+  TEST_ASSERT_NOT_EQUAL(hs, hm);
+  TEST_ASSERT_EQUAL_PTR(s, ACT_mem_fromHandle(hs));
+  TEST_ASSERT_EQUAL_PTR(m, ACT_mem_fromHandle(hm));
+
+  ACT_mem_gc(EVT_UPCAST(s));
+  ACT_mem_gc(EVT_UPCAST(m));
+}
+
+void test_handle_static_event()
+{
+  ACT_Handle h = ACT_mem_toHandle(EVT_UPCAST(&staticSig));
+
+  /* Same static event gives same handle */
+  TEST_ASSERT_EQUAL_UINT16(h, ACT_mem_toHandle(EVT_UPCAST(&staticSig)));
+  TEST_ASSERT_EQUAL_PTR(&staticSig, ACT_mem_fromHandle(h));
+
+  ACT_mem_releaseHandle(h);
+  ACT_mem_releaseHandle(h);
+}
+
+void test_handle_static_event_released()
+{
+  static ACT_Signal sigs[ACT_CFG_HANDLE_NUM_STATIC + 1];
+
+  /* More distinct static events than handle entries, each released before the next one is queued */
+  for (size_t i = 0; i < ACT_CFG_HANDLE_NUM_STATIC + 1; i++)
+  {
+    ACT_Signal_init(&sigs[i], &ao, TEST_SIG);
+    ACT_Handle h = ACT_mem_toHandle(EVT_UPCAST(&sigs[i]));
+    TEST_ASSERT_EQUAL_PTR(&sigs[i], ACT_mem_fromHandle(h));
+    ACT_mem_releaseHandle(h);
+  }
+
+  /* Posted and taken static events release their entry */
+  for (size_t i = 0; i < ACT_CFG_HANDLE_NUM_STATIC + 1; i++)
+  {
+    ACT_postEvt(&ao, EVT_UPCAST(&sigs[i]));
+    ACT_SLEEPMS(10);
+  }
+  TEST_ASSERT_EQUAL_UINT32(ACT_CFG_HANDLE_NUM_STATIC + 1, processed);
+}
+
+void main()
+{
+  ACT_SLEEPMS(2000);
+
+  UNITY_BEGIN();
+
+  ACT_init(&ao, ao_dispatch, &qdtest, &tdtest);
+  ACT_start(&ao);
+
+  RUN_TEST(test_handle_queue_entry_size);
+  RUN_TEST(test_handle_active);
+  RUN_TEST(test_handle_sender);
+  RUN_TEST(test_handle_dynamic_event);
+  RUN_TEST(test_handle_static_event);
+  RUN_TEST(test_handle_static_event_released);
+
+  UNITY_END();
+}
@@ -0,0 +1 @@
+#define ACT_CFG_HSM_MAX_DEPTH 3
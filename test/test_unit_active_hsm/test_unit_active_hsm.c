@@ -0,0 +1,244 @@
+#include <string.h>
+
+#include <active.h>
+#include <unity.h>
+
+/* Events are dispatched directly, the state machine Active object is never started */
+
+#define MAX_MSG 4
+
+static ACT_QBUF(qBuf, MAX_MSG);
+static ACT_Q(q);
+static ACT_THREAD(t);
+static ACT_THREAD_STACK_DEFINE(stack, 512);
+static ACT_THREAD_STACK_SIZE(stackSz, stack);
+
+const static ACT_QueueData qd = {.maxMsg = MAX_MSG, .queBuf = qBuf, .queue = &q};
+const static ACT_ThreadData td = {.thread = &t, .pri = 1, .stack = stack, .stack_size = stackSz};
+
+enum TestUserSignal
+{
+  GO_SIG = ACT_USER_SIG,
+  STOP_SIG,
+  PAUSE_SIG,
+  RESUME_SIG,
+  KICK_SIG,
+  RESET_SIG,
+  UNKNOWN_SIG
+};
+
+enum TestUserHeader
+{
+  DATA_MSG = 1
+};
+
+/*
+ * top
+ * ├── idle (initial)
+ * └── active
+ *     ├── running (initial)
+ *     └── paused
+ */
+typedef struct
+{
+  ACT_Hsm super;
+  bool kickAllowed; // Guard of KICK_SIG in running
+  uint32_t activeKicks;
+  uint32_t runningKicks;
+  uint32_t data;
+} Motor;
+
+static Motor motor;
+
+/* Entry (upper case) and exit (lower case) actions in order */
+static char actions[32];
+
+static void logAction(char c)
+{
+  size_t len = strlen(actions);
+  TEST_ASSERT_LESS_THAN(sizeof(actions) - 1, len);
+  actions[len] = c;
+}
+
+static ACT_HsmState top, idle, active, running, paused;
+
+static void Top_entry(Active *me) { logAction('T'); }
+static void Top_exit(Active *me) { logAction('t'); }
+static void Idle_entry(Active *me) { logAction('I'); }
+static void Idle_exit(Active *me) { logAction('i'); }
+static void Active_entry(Active *me) { logAction('A'); }
+static void Active_exit(Active *me) { logAction('a'); }
+static void Running_entry(Active *me) { logAction('R'); }
+static void Running_exit(Active *me) { logAction('r'); }
+static void Paused_entry(Active *me) { logAction('P'); }
+static void Paused_exit(Active *me) { logAction('p'); }
+
+static ACT_HsmState *Top_reset(Active *me, ACT_Evt const *const e) { return &top; }
+static ACT_HsmState *Idle_go(Active *me, ACT_Evt const *const e) { return &active; }
+static ACT_HsmState *Active_stop(Active *me, ACT_Evt const *const e) { return &idle; }
+static ACT_HsmState *Running_pause(Active *me, ACT_Evt const *const e) { return &paused; }
+static ACT_HsmState *Paused_resume(Active *me, ACT_Evt const *const e) { return &running; }
+
+static ACT_HsmState *Active_kick(Active *me, ACT_Evt const *const e)
+{
+  ((Motor *)me)->activeKicks++;
+  return ACT_HSM_HANDLED;
+}
+
+static ACT_HsmState *Running_kick(Active *me, ACT_Evt const *const e)
+{
+  Motor *m = (Motor *)me;
+  if (!m->kickAllowed)
+  {
+    return ACT_HSM_UNHANDLED;
+  }
+  m->runningKicks++;
+  return ACT_HSM_HANDLED;
+}
+
+static ACT_HsmState *Running_data(Active *me, ACT_Evt const *const e)
+{
+  ((Motor *)me)->data += *(uint32_t *)EVT_CAST(e, ACT_Message)->payload;
+  return ACT_HSM_HANDLED;
+}
+
+static ACT_HsmHandler const topHandlers[] = {[RESET_SIG] = Top_reset};
+static ACT_HsmHandler const idleHandlers[] = {[GO_SIG] = Idle_go};
+static ACT_HsmHandler const activeHandlers[] = {[STOP_SIG] = Active_stop, [KICK_SIG] = Active_kick};
+static ACT_HsmHandler const runningHandlers[] = {[DATA_MSG] = Running_data, [PAUSE_SIG] = Running_pause, [KICK_SIG] = Running_kick};
+static ACT_HsmHandler const pausedHandlers[] = {[RESUME_SIG] = Paused_resume};
+
+static ACT_HSM_STATE_DEFINE(top, NULL, &idle, topHandlers, Top_entry, Top_exit);
+static ACT_HSM_STATE_DEFINE(idle, &top, NULL, idleHandlers, Idle_entry, Idle_exit);
+static ACT_HSM_STATE_DEFINE(active, &top, &running, activeHandlers, Active_entry, Active_exit);
+static ACT_HSM_STATE_DEFINE(running, &active, NULL, runningHandlers, Running_entry, Running_exit);
+static ACT_HSM_STATE_DEFINE(paused, &active, NULL, pausedHandlers, Paused_entry, Paused_exit);
+
+static ACT_HsmState *const states[] = {&idle, &running, &top, &paused, &active};
+
+static const ACT_SIGNAL_DEFINE(startSig, ACT_START_SIG);
+
+static void dispatch(uint16_t sig)
+{
+  ACT_Signal s;
+  ACT_Signal_init(&s, ACT_UPCAST(&motor), sig);
+  ACT_Hsm_dispatch(ACT_UPCAST(&motor), EVT_UPCAST(&s));
+}
+
+static void expectLog(char const *expected)
+{
+  TEST_ASSERT_EQUAL_STRING(expected, actions);
+  memset(actions, 0, sizeof(actions));
+}
+
+void setUp(void)
+{
+  memset(&motor, 0, sizeof(motor));
+  memset(actions, 0, sizeof(actions));
+
+  ACT_Hsm_init(&motor.super, states, sizeof(states) / sizeof(states[0]), &top, &qd, &td);
+  ACT_Hsm_dispatch(ACT_UPCAST(&motor), EVT_UPCAST(&startSig));
+}
+
+void test_hsm_start_enters_initial_leaf()
+{
+  expectLog("TI");
+  TEST_ASSERT_TRUE(ACT_Hsm_isIn(&motor.super, &top));
+  TEST_ASSERT_TRUE(ACT_Hsm_isIn(&motor.super, &idle));
+  TEST_ASSERT_FALSE(ACT_Hsm_isIn(&motor.super, &active));
+}
+
+void test_hsm_transitions_exit_and_enter_up_to_common_ancestor()
+{
+  expectLog("TI");
+
+  dispatch(GO_SIG);
+  expectLog("iAR");
+  TEST_ASSERT_TRUE(ACT_Hsm_isIn(&motor.super, &active));
+  TEST_ASSERT_TRUE(ACT_Hsm_isIn(&motor.super, &running));
+
+  dispatch(PAUSE_SIG);
+  expectLog("rP");
+
+  dispatch(RESUME_SIG);
+  expectLog("pR");
+}
+
+void test_hsm_superstate_handles_event()
+{
+  dispatch(GO_SIG);
+  dispatch(PAUSE_SIG);
+  expectLog("TIiARrP");
+
+  // Stop is handled by active, while in paused
+  dispatch(STOP_SIG);
+  expectLog("paI");
+  TEST_ASSERT_TRUE(ACT_Hsm_isIn(&motor.super, &idle));
+}
+
+void test_hsm_transition_to_superstate_reenters_it()
+{
+  dispatch(GO_SIG);
+  expectLog("TIiAR");
+
+  dispatch(RESET_SIG);
+  expectLog("ratTI");
+  TEST_ASSERT_TRUE(ACT_Hsm_isIn(&motor.super, &idle));
+}
+
+void test_hsm_unhandled_goes_to_parent()
+{
+  dispatch(GO_SIG);
+
+  dispatch(KICK_SIG);
+  TEST_ASSERT_EQUAL_UINT32(1, motor.activeKicks);
+  TEST_ASSERT_EQUAL_UINT32(0, motor.runningKicks);
+
+  motor.kickAllowed = true;
+  dispatch(KICK_SIG);
+  TEST_ASSERT_EQUAL_UINT32(1, motor.activeKicks);
+  TEST_ASSERT_EQUAL_UINT32(1, motor.runningKicks);
+}
+
+void test_hsm_ignores_events_without_handler()
+{
+  expectLog("TI");
+
+  // Signals beyond all tables, and signals with no handler in any state
+  dispatch(UNKNOWN_SIG);
+  dispatch(PAUSE_SIG);
+  ACT_Hsm_dispatch(ACT_UPCAST(&motor), EVT_UPCAST(&startSig));
+
+  expectLog("");
+  TEST_ASSERT_TRUE(ACT_Hsm_isIn(&motor.super, &idle));
+}
+
+void test_hsm_messages_use_header_as_key()
+{
+  uint32_t value = 42;
+  ACT_Message m;
+  ACT_Message_init(&m, ACT_UPCAST(&motor), DATA_MSG, &value, sizeof(value));
+
+  // Not handled in idle
+  ACT_Hsm_dispatch(ACT_UPCAST(&motor), EVT_UPCAST(&m));
+  TEST_ASSERT_EQUAL_UINT32(0, motor.data);
+
+  dispatch(GO_SIG);
+  ACT_Hsm_dispatch(ACT_UPCAST(&motor), EVT_UPCAST(&m));
+  TEST_ASSERT_EQUAL_UINT32(42, motor.data);
+}
+
+void main()
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_hsm_start_enters_initial_leaf);
+  RUN_TEST(test_hsm_transitions_exit_and_enter_up_to_common_ancestor);
+  RUN_TEST(test_hsm_superstate_handles_event);
+  RUN_TEST(test_hsm_transition_to_superstate_reenters_it);
+  RUN_TEST(test_hsm_unhandled_goes_to_parent);
+  RUN_TEST(test_hsm_ignores_events_without_handler);
+  RUN_TEST(test_hsm_messages_use_header_as_key);
+
+  UNITY_END();
+}
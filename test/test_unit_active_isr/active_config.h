@@ -0,0 +1,3 @@
+#define ACT_CFG_PORT_SIM 1
+#define ACT_CFG_ISR_POST 1
+#define ACT_CFG_ISR_MAX_SOURCES 2
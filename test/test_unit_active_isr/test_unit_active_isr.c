@@ -0,0 +1,141 @@
+#include <string.h>
+
+#include <active.h>
+#include <unity.h>
+
+/* Runs on the simulation port. The test thread stands in for the ISRs, events are processed when it sleeps */
+
+#define MAX_MSG 4
+
+static ACT_QBUF(drvQBuf, MAX_MSG);
+static ACT_Q(drvQ);
+static ACT_THREAD(drvT);
+static ACT_THREAD_STACK_DEFINE(drvStack, 512);
+static ACT_THREAD_STACK_SIZE(drvStackSz, drvStack);
+
+const static ACT_QueueData qddrv = {.maxMsg = MAX_MSG, .queBuf = drvQBuf, .queue = &drvQ};
+const static ACT_ThreadData tddrv = {.thread = &drvT, .pri = 1, .stack = drvStack, .stack_size = drvStackSz};
+
+enum TestUserSignal
+{
+  BUTTON_SIG = ACT_USER_SIG
+};
+
+enum TestUserHeader
+{
+  RX_MSG = 1
+};
+
+Active drv;
+
+/* Button interrupt posts a signal, UART interrupt a message with the received byte */
+static ACT_IsrSource buttonIrq, uartIrq;
+static const ACT_SIGNAL_DEFINE(buttonSignal, BUTTON_SIG);
+static uint8_t rxByte;
+static ACT_MESSAGE_DEFINE(rxMessage, RX_MSG, &rxByte, sizeof(rxByte));
+
+static uint32_t buttons;
+static uint8_t received[4];
+static size_t numReceived;
+
+static void drv_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type == ACT_SIGNAL && EVT_CAST(e, ACT_Signal)->sig == BUTTON_SIG)
+  {
+    buttons++;
+  }
+  else if (e->type == ACT_MESSAGE && EVT_CAST(e, ACT_Message)->header == RX_MSG)
+  {
+    received[numReceived++] = *(uint8_t *)EVT_CAST(e, ACT_Message)->payload;
+  }
+}
+
+/* UART ISR: write the byte into the slot only when the previous one was processed */
+static int uartIsr(uint8_t byte)
+{
+  if (ACT_IsrSource_isFree(&uartIrq))
+  {
+    rxByte = byte;
+  }
+  return ACT_postFromISR(&uartIrq);
+}
+
+void setUp(void)
+{
+  buttons = 0;
+  numReceived = 0;
+  memset(received, 0, sizeof(received));
+}
+
+void test_isr_burst_queues_one_doorbell()
+{
+  TEST_ASSERT_EQUAL_INT(ACT_ISR_OK, ACT_postFromISR(&buttonIrq));
+  TEST_ASSERT_EQUAL(1, ACT_getQueueUsed(&drv));
+
+  TEST_ASSERT_EQUAL_INT(ACT_ISR_OK, uartIsr(0x55));
+  TEST_ASSERT_EQUAL(1, ACT_getQueueUsed(&drv));
+
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL_UINT32(1, buttons);
+  TEST_ASSERT_EQUAL(1, numReceived);
+  TEST_ASSERT_EQUAL_HEX8(0x55, received[0]);
+  TEST_ASSERT_EQUAL(0, ACT_getQueueUsed(&drv));
+  TEST_ASSERT_TRUE(ACT_IsrSource_isFree(&buttonIrq));
+  TEST_ASSERT_TRUE(ACT_IsrSource_isFree(&uartIrq));
+}
+
+void test_isr_busy_slot_overflows()
+{
+  uint32_t overflow = ACT_IsrSource_getOverflow(&uartIrq);
+
+  TEST_ASSERT_EQUAL_INT(ACT_ISR_OK, uartIsr(0x01));
+  TEST_ASSERT_FALSE(ACT_IsrSource_isFree(&uartIrq));
+
+  // Payload of the pending event is not overwritten
+  TEST_ASSERT_EQUAL_INT(ACT_ISR_ERR_OVERFLOW, uartIsr(0x02));
+  TEST_ASSERT_EQUAL_UINT32(overflow + 1, ACT_IsrSource_getOverflow(&uartIrq));
+
+  ACT_SLEEPMS(1);
+  TEST_ASSERT_EQUAL(1, numReceived);
+  TEST_ASSERT_EQUAL_HEX8(0x01, received[0]);
+
+  // Slot is free again after processing
+  TEST_ASSERT_EQUAL_INT(ACT_ISR_OK, uartIsr(0x03));
+  ACT_SLEEPMS(1);
+  TEST_ASSERT_EQUAL(2, numReceived);
+  TEST_ASSERT_EQUAL_HEX8(0x03, received[1]);
+}
+
+void test_isr_events_are_not_allocated()
+{
+  uint32_t signalsUsed = ACT_mem_Signal_getUsed();
+  uint32_t messagesUsed = ACT_mem_Message_getUsed();
+
+  for (int i = 0; i < 10; i++)
+  {
+    ACT_postFromISR(&buttonIrq);
+    ACT_SLEEPMS(1);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(10, buttons);
+  TEST_ASSERT_EQUAL_UINT32(signalsUsed, ACT_mem_Signal_getUsed());
+  TEST_ASSERT_EQUAL_UINT32(messagesUsed, ACT_mem_Message_getUsed());
+}
+
+void main()
+{
+  UNITY_BEGIN();
+
+  ACT_init(&drv, drv_dispatch, &qddrv, &tddrv);
+  ACT_IsrSource_init(&buttonIrq, &drv, EVT_UPCAST(&buttonSignal));
+  ACT_IsrSource_init(&uartIrq, &drv, EVT_UPCAST(&rxMessage));
+  ACT_start(&drv);
+  ACT_SLEEPMS(1);
+
+  RUN_TEST(test_isr_burst_queues_one_doorbell);
+  RUN_TEST(test_isr_busy_slot_overflows);
+  RUN_TEST(test_isr_events_are_not_allocated);
+
+  UNITY_END();
+}
@@ -0,0 +1,2 @@
+#define ACT_CFG_MAILBOX ACT_MAILBOX_LINKED
+#define ACT_MEM_NUM_QNODES 4
@@ -0,0 +1,89 @@
+#include <active.h>
+#include <unity.h>
+
+void test_mbox_fifo_order()
+{
+  ACT_Mbox mb;
+  ACT_Signal s[3];
+  ACT_QEntry entry;
+
+  ACT_Mbox_init(&mb, 0);
+
+  for (uint16_t i = 0; i < 3; i++)
+  {
+    entry = ACT_QENTRY_FROM_EVT(EVT_UPCAST(&s[i]));
+    TEST_ASSERT_EQUAL_INT(0, ACT_Mbox_put(&mb, &entry));
+  }
+
+  TEST_ASSERT_EQUAL(3, ACT_Mbox_getUsed(&mb));
+  TEST_ASSERT_EQUAL_UINT32(3, ACT_mem_QNode_getUsed());
+
+  for (uint16_t i = 0; i < 3; i++)
+  {
+    TEST_ASSERT_EQUAL_INT(0, ACT_Mbox_get(&mb, &entry));
+    TEST_ASSERT_EQUAL_PTR(&s[i], ACT_QENTRY_TO_EVT(entry));
+  }
+
+  TEST_ASSERT_EQUAL(0, ACT_Mbox_getUsed(&mb));
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_QNode_getUsed());
+}
+
+void test_mbox_cap()
+{
+  ACT_Mbox mb;
+  ACT_Signal s;
+  ACT_QEntry entry = ACT_QENTRY_FROM_EVT(EVT_UPCAST(&s));
+
+  ACT_Mbox_init(&mb, 2);
+
+  TEST_ASSERT_EQUAL_INT(0, ACT_Mbox_put(&mb, &entry));
+  TEST_ASSERT_EQUAL_INT(0, ACT_Mbox_put(&mb, &entry));
+  TEST_ASSERT_EQUAL_INT(ACT_MBOX_ERR_FULL, ACT_Mbox_put(&mb, &entry));
+
+  /* Rejected entry does not hold a node */
+  TEST_ASSERT_EQUAL_UINT32(2, ACT_mem_QNode_getUsed());
+
+  ACT_Mbox_get(&mb, &entry);
+  ACT_Mbox_get(&mb, &entry);
+}
+
+void test_mbox_shared_node_pool()
+{
+  ACT_Mbox mb1, mb2;
+  ACT_Signal s;
+  ACT_QEntry entry = ACT_QENTRY_FROM_EVT(EVT_UPCAST(&s));
+
+  ACT_Mbox_init(&mb1, 0);
+  ACT_Mbox_init(&mb2, 0);
+
+  /* Mailboxes share ACT_MEM_NUM_QNODES nodes */
+  TEST_ASSERT_EQUAL_INT(0, ACT_Mbox_put(&mb1, &entry));
+  TEST_ASSERT_EQUAL_INT(0, ACT_Mbox_put(&mb1, &entry));
+  TEST_ASSERT_EQUAL_INT(0, ACT_Mbox_put(&mb2, &entry));
+  TEST_ASSERT_EQUAL_INT(0, ACT_Mbox_put(&mb2, &entry));
+  TEST_ASSERT_EQUAL_INT(ACT_MBOX_ERR_NOMEM, ACT_Mbox_put(&mb2, &entry));
+  TEST_ASSERT_EQUAL(2, ACT_Mbox_getUsed(&mb2));
+
+  /* Node freed by one mailbox can be used by another */
+  ACT_Mbox_get(&mb1, &entry);
+  TEST_ASSERT_EQUAL_INT(0, ACT_Mbox_put(&mb2, &entry));
+
+  ACT_Mbox_get(&mb1, &entry);
+  ACT_Mbox_get(&mb2, &entry);
+  ACT_Mbox_get(&mb2, &entry);
+  ACT_Mbox_get(&mb2, &entry);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_QNode_getUsed());
+}
+
+void main()
+{
+  ACT_SLEEPMS(2000);
+
+  UNITY_BEGIN();
+
+  RUN_TEST(test_mbox_fifo_order);
+  RUN_TEST(test_mbox_cap);
+  RUN_TEST(test_mbox_shared_node_pool);
+
+  UNITY_END();
+}
@@ -0,0 +1,83 @@
+#include <active.h>
+#include <unity.h>
+
+#define TEST_NUM_BLOCKS 4
+
+typedef struct
+{
+  uint32_t a;
+  uint16_t b;
+} TestObj;
+
+static ACT_MEMPOOL_LOCKFREE_DEFINE(testPool, sizeof(TestObj), _Alignof(TestObj), TEST_NUM_BLOCKS);
+
+void test_mempool_alloc_all()
+{
+  void *blocks[TEST_NUM_BLOCKS];
+
+  for (uint16_t i = 0; i < TEST_NUM_BLOCKS; i++)
+  {
+    TEST_ASSERT_EQUAL_INT(0, ACT_Mempool_alloc(&testPool, &blocks[i]));
+    TEST_ASSERT_NOT_NULL(blocks[i]);
+    TEST_ASSERT_EQUAL_UINT32(0, (uintptr_t)blocks[i] % _Alignof(TestObj));
+    TEST_ASSERT_EQUAL_UINT32(i + 1, ACT_Mempool_getUsed(&testPool));
+  }
+
+  /* Pool is empty */
+  void *block = (void *)&testPool;
+  TEST_ASSERT_EQUAL_INT(ACT_MEMPOOL_ERR_NOMEM, ACT_Mempool_alloc(&testPool, &block));
+  TEST_ASSERT_NULL(block);
+
+  for (uint16_t i = 0; i < TEST_NUM_BLOCKS; i++)
+  {
+    ACT_Mempool_free(&testPool, &blocks[i]);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_Mempool_getUsed(&testPool));
+  TEST_ASSERT_EQUAL_UINT32(TEST_NUM_BLOCKS, ACT_Mempool_getMaxUsed(&testPool));
+}
+
+void test_mempool_reuse_freed_block()
+{
+  void *first, *second;
+
+  TEST_ASSERT_EQUAL_INT(0, ACT_Mempool_alloc(&testPool, &first));
+  ACT_Mempool_free(&testPool, &first);
+
+  /* Last freed block is handed out first */
+  TEST_ASSERT_EQUAL_INT(0, ACT_Mempool_alloc(&testPool, &second));
+  TEST_ASSERT_EQUAL_PTR(first, second);
+
+  ACT_Mempool_free(&testPool, &second);
+}
+
+void test_mempool_runtime_init()
+{
+  static _Alignas(TestObj) char buf[2 * sizeof(TestObj)];
+  ACT_Mempool pool;
+  void *a, *b, *c;
+
+  ACT_Mempool_init(&pool, buf, sizeof(TestObj), 2);
+
+  TEST_ASSERT_EQUAL_INT(0, ACT_Mempool_alloc(&pool, &a));
+  TEST_ASSERT_EQUAL_INT(0, ACT_Mempool_alloc(&pool, &b));
+  TEST_ASSERT_NOT_EQUAL(a, b);
+  TEST_ASSERT_EQUAL_INT(ACT_MEMPOOL_ERR_NOMEM, ACT_Mempool_alloc(&pool, &c));
+
+  ACT_Mempool_free(&pool, &a);
+  ACT_Mempool_free(&pool, &b);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_Mempool_getUsed(&pool));
+}
+
+void main()
+{
+  ACT_SLEEPMS(2000);
+
+  UNITY_BEGIN();
+
+  RUN_TEST(test_mempool_alloc_all);
+  RUN_TEST(test_mempool_reuse_freed_block);
+  RUN_TEST(test_mempool_runtime_init);
+
+  UNITY_END();
+}
@@ -0,0 +1,162 @@
+#include <string.h>
+
+#include <active.h>
+#include <unity.h>
+
+/* Runs on the simulation port. Jobs submitted by the test run when it sleeps, one at a time */
+
+#define MAX_MSG 4
+#define MAX_PENDING 3
+#define MAX_LOG 4
+#define JOB_MS 10
+
+static ACT_QBUF(clientQBuf, MAX_MSG);
+static ACT_QBUF(workerQBuf, MAX_PENDING);
+static ACT_Q(clientQ);
+static ACT_Q(workerQ);
+static ACT_THREAD(clientT);
+static ACT_THREAD(workerT);
+static ACT_THREAD_STACK_DEFINE(clientStack, 512);
+static ACT_THREAD_STACK_DEFINE(workerStack, 512);
+static ACT_THREAD_STACK_SIZE(clientStackSz, clientStack);
+static ACT_THREAD_STACK_SIZE(workerStackSz, workerStack);
+
+const static ACT_QueueData qdclient = {.maxMsg = MAX_MSG, .queBuf = clientQBuf, .queue = &clientQ};
+const static ACT_QueueData qdworker[1] = {{.maxMsg = MAX_PENDING, .queBuf = workerQBuf, .queue = &workerQ}};
+
+// Worker runs below the client
+const static ACT_ThreadData tdclient = {.thread = &clientT, .pri = 1, .stack = clientStack, .stack_size = clientStackSz};
+const static ACT_ThreadData tdworker[1] = {{.thread = &workerT, .pri = 5, .stack = workerStack, .stack_size = workerStackSz}};
+
+enum TestUserHeader
+{
+  A_DONE_MSG = 1,
+  B_DONE_MSG,
+  C_DONE_MSG,
+  D_DONE_MSG
+};
+
+Active client;
+static ACT_Offload pool;
+static ACT_OffloadWorker workers[1];
+static ACT_Job jobA, jobB, jobC, jobD;
+static int32_t ctxA = 1, ctxB = 2, ctxC = 3, ctxD = 4;
+
+static int32_t ran[MAX_LOG];
+static size_t numRan;
+static uint16_t done[MAX_LOG];
+static int32_t results[MAX_LOG];
+static size_t numDone;
+
+/* Blocking job, returns its context doubled plus payload */
+static int32_t slowJob(void *ctx, void *payload, uint16_t payloadLen)
+{
+  int32_t value = *(int32_t *)ctx;
+  ran[numRan++] = value;
+  ACT_SLEEPMS(JOB_MS);
+  return 2 * value + (payload != NULL ? *(int32_t *)payload : 0);
+}
+
+static void client_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_MESSAGE)
+  {
+    return;
+  }
+
+  ACT_Job *jobs[] = {&jobA, &jobB, &jobC, &jobD};
+  uint16_t header = EVT_CAST(e, ACT_Message)->header;
+  done[numDone] = header;
+  results[numDone++] = ACT_Job_getResult(jobs[header - A_DONE_MSG]);
+}
+
+void setUp(void)
+{
+  numRan = 0;
+  numDone = 0;
+  memset(ran, 0, sizeof(ran));
+  memset(done, 0, sizeof(done));
+}
+
+void test_offload_runs_highest_priority_first()
+{
+  TEST_ASSERT_EQUAL_INT(ACT_OFFLOAD_OK, ACT_Offload_submit(&pool, &jobA, NULL, 0, 2));
+  TEST_ASSERT_EQUAL_INT(ACT_OFFLOAD_OK, ACT_Offload_submit(&pool, &jobB, NULL, 0, 0));
+  TEST_ASSERT_EQUAL_INT(ACT_OFFLOAD_OK, ACT_Offload_submit(&pool, &jobC, NULL, 0, 1));
+
+  ACT_SLEEPMS(3 * JOB_MS);
+
+  TEST_ASSERT_EQUAL(3, numRan);
+  TEST_ASSERT_EQUAL_INT32(ctxB, ran[0]);
+  TEST_ASSERT_EQUAL_INT32(ctxC, ran[1]);
+  TEST_ASSERT_EQUAL_INT32(ctxA, ran[2]);
+
+  TEST_ASSERT_EQUAL(3, numDone);
+  TEST_ASSERT_EQUAL_UINT16(B_DONE_MSG, done[0]);
+  TEST_ASSERT_EQUAL_INT32(2 * ctxB, results[0]);
+  TEST_ASSERT_EQUAL_UINT16(A_DONE_MSG, done[2]);
+  TEST_ASSERT_EQUAL_INT32(2 * ctxA, results[2]);
+}
+
+void test_offload_payload_and_result()
+{
+  int32_t payload = 100;
+  TEST_ASSERT_EQUAL_INT(ACT_OFFLOAD_OK, ACT_Offload_submit(&pool, &jobD, &payload, sizeof(payload), 0));
+  TEST_ASSERT_EQUAL(0, numRan);
+
+  ACT_SLEEPMS(JOB_MS);
+
+  TEST_ASSERT_EQUAL(1, numDone);
+  TEST_ASSERT_EQUAL_UINT16(D_DONE_MSG, done[0]);
+  TEST_ASSERT_EQUAL_INT32(2 * ctxD + payload, results[0]);
+}
+
+void test_offload_bounded_and_busy()
+{
+  ACT_OffloadStats before = ACT_Offload_getStats(&pool);
+
+  TEST_ASSERT_EQUAL_INT(ACT_OFFLOAD_OK, ACT_Offload_submit(&pool, &jobA, NULL, 0, 1));
+  TEST_ASSERT_EQUAL_INT(ACT_OFFLOAD_ERR_BUSY, ACT_Offload_submit(&pool, &jobA, NULL, 0, 1));
+  TEST_ASSERT_EQUAL_INT(ACT_OFFLOAD_OK, ACT_Offload_submit(&pool, &jobB, NULL, 0, 1));
+  TEST_ASSERT_EQUAL_INT(ACT_OFFLOAD_OK, ACT_Offload_submit(&pool, &jobC, NULL, 0, 1));
+  TEST_ASSERT_EQUAL_INT(ACT_OFFLOAD_ERR_FULL, ACT_Offload_submit(&pool, &jobD, NULL, 0, 0));
+
+  ACT_SLEEPMS(3 * JOB_MS);
+
+  // Same priority runs in submission order
+  TEST_ASSERT_EQUAL(3, numDone);
+  TEST_ASSERT_EQUAL_UINT16(A_DONE_MSG, done[0]);
+  TEST_ASSERT_EQUAL_UINT16(B_DONE_MSG, done[1]);
+  TEST_ASSERT_EQUAL_UINT16(C_DONE_MSG, done[2]);
+
+  ACT_OffloadStats stats = ACT_Offload_getStats(&pool);
+  TEST_ASSERT_EQUAL_UINT32(before.submitted + 3, stats.submitted);
+  TEST_ASSERT_EQUAL_UINT32(stats.submitted, stats.completed);
+  TEST_ASSERT_EQUAL_UINT32(before.rejected + 1, stats.rejected);
+  TEST_ASSERT_EQUAL_UINT32(MAX_PENDING, stats.maxPending);
+
+  // Completed jobs can be submitted again
+  TEST_ASSERT_EQUAL_INT(ACT_OFFLOAD_OK, ACT_Offload_submit(&pool, &jobD, NULL, 0, 0));
+  ACT_SLEEPMS(JOB_MS);
+}
+
+void main()
+{
+  UNITY_BEGIN();
+
+  ACT_init(&client, client_dispatch, &qdclient, &tdclient);
+  ACT_Offload_init(&pool, workers, 1, MAX_PENDING, qdworker, tdworker);
+  ACT_Job_init(&jobA, &client, slowJob, &ctxA, A_DONE_MSG);
+  ACT_Job_init(&jobB, &client, slowJob, &ctxB, B_DONE_MSG);
+  ACT_Job_init(&jobC, &client, slowJob, &ctxC, C_DONE_MSG);
+  ACT_Job_init(&jobD, &client, slowJob, &ctxD, D_DONE_MSG);
+  ACT_start(&client);
+  ACT_Offload_start(&pool);
+  ACT_SLEEPMS(1);
+
+  RUN_TEST(test_offload_runs_highest_priority_first);
+  RUN_TEST(test_offload_payload_and_result);
+  RUN_TEST(test_offload_bounded_and_busy);
+
+  UNITY_END();
+}
@@ -0,0 +1,4 @@
+#define ACT_CFG_PORT_SIM 1
+#define ACT_CFG_MEM_QUOTA 1
+#define ACT_CFG_MEM_CLASSES 2
+#define ACT_MEM_NUM_MESSAGES 4
@@ -0,0 +1,141 @@
+#include <active.h>
+#include <unity.h>
+
+#define NUM_MSG 4
+
+enum TestMemClass
+{
+  CRITICAL_CLASS = 0,
+  LOGGER_CLASS
+};
+
+enum TestUserSignal
+{
+  TEST_SIG = ACT_USER_SIG
+};
+
+static Active safety;
+static Active logger;
+
+static ACT_Message *msgs[NUM_MSG];
+static size_t numMsgs;
+
+static ACT_Message *tryNew(Active const *me)
+{
+  ACT_Message *m = ACT_Message_tryNew(me, TEST_SIG, NULL, 0);
+  if (m != NULL)
+  {
+    msgs[numMsgs++] = m;
+  }
+  return m;
+}
+
+void setUp(void)
+{
+  numMsgs = 0;
+}
+
+void tearDown(void)
+{
+  for (size_t i = 0; i < numMsgs; i++)
+  {
+    ACT_mem_gc(EVT_UPCAST(msgs[i]));
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Message_getUsed());
+}
+
+void test_reserved_blocks_not_given_to_other_class()
+{
+  ACT_mem_setQuota(ACT_MESSAGE, CRITICAL_CLASS, 2, NUM_MSG);
+  ACT_mem_setQuota(ACT_MESSAGE, LOGGER_CLASS, 0, NUM_MSG);
+  uint32_t failed = ACT_mem_getFailed(ACT_MESSAGE);
+
+  TEST_ASSERT_NOT_NULL(tryNew(&logger));
+  TEST_ASSERT_NOT_NULL(tryNew(&logger));
+  TEST_ASSERT_NULL(tryNew(&logger));
+
+  // Logger flooding does not starve the critical class
+  TEST_ASSERT_NOT_NULL(tryNew(&safety));
+  TEST_ASSERT_NOT_NULL(tryNew(&safety));
+
+  ACT_MemClassStats stats = ACT_mem_getClassStats(ACT_MESSAGE, LOGGER_CLASS);
+  TEST_ASSERT_EQUAL_UINT16(2, stats.used);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.rejected);
+  TEST_ASSERT_EQUAL_UINT32(failed + 1, ACT_mem_getFailed(ACT_MESSAGE));
+}
+
+void test_class_uses_shared_blocks_after_reserve()
+{
+  ACT_mem_setQuota(ACT_MESSAGE, CRITICAL_CLASS, 2, NUM_MSG);
+  ACT_mem_setQuota(ACT_MESSAGE, LOGGER_CLASS, 0, NUM_MSG);
+
+  TEST_ASSERT_NOT_NULL(tryNew(&safety));
+  TEST_ASSERT_NOT_NULL(tryNew(&safety));
+  TEST_ASSERT_NOT_NULL(tryNew(&safety));
+
+  TEST_ASSERT_NOT_NULL(tryNew(&logger));
+  TEST_ASSERT_NULL(tryNew(&logger));
+
+  ACT_MemClassStats stats = ACT_mem_getClassStats(ACT_MESSAGE, CRITICAL_CLASS);
+  TEST_ASSERT_EQUAL_UINT16(3, stats.used);
+  TEST_ASSERT_EQUAL_UINT16(3, stats.maxUsed);
+}
+
+void test_class_capped_at_max()
+{
+  ACT_mem_setQuota(ACT_MESSAGE, CRITICAL_CLASS, 0, NUM_MSG);
+  ACT_mem_setQuota(ACT_MESSAGE, LOGGER_CLASS, 0, 1);
+
+  TEST_ASSERT_NOT_NULL(tryNew(&logger));
+  TEST_ASSERT_NULL(tryNew(&logger));
+
+  // Freed block is available to the class again
+  ACT_mem_gc(EVT_UPCAST(msgs[--numMsgs]));
+  TEST_ASSERT_NOT_NULL(tryNew(&logger));
+
+  TEST_ASSERT_NOT_NULL(tryNew(&safety));
+  TEST_ASSERT_NOT_NULL(tryNew(&safety));
+  TEST_ASSERT_NOT_NULL(tryNew(&safety));
+}
+
+void test_no_sender_charged_to_class_0()
+{
+  ACT_mem_setQuota(ACT_MESSAGE, CRITICAL_CLASS, 0, 1);
+  ACT_mem_setQuota(ACT_MESSAGE, LOGGER_CLASS, 0, NUM_MSG);
+
+  TEST_ASSERT_NOT_NULL(tryNew(NULL));
+  TEST_ASSERT_NULL(tryNew(NULL));
+
+  ACT_MemClassStats stats = ACT_mem_getClassStats(ACT_MESSAGE, CRITICAL_CLASS);
+  TEST_ASSERT_EQUAL_UINT16(1, stats.used);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.rejected);
+}
+
+void test_types_without_quota_not_limited()
+{
+  ACT_Signal *s[2];
+  s[0] = ACT_Signal_tryNew(&logger, TEST_SIG);
+  s[1] = ACT_Signal_tryNew(&logger, TEST_SIG);
+
+  TEST_ASSERT_NOT_NULL(s[0]);
+  TEST_ASSERT_NOT_NULL(s[1]);
+
+  ACT_mem_gc(EVT_UPCAST(s[0]));
+  ACT_mem_gc(EVT_UPCAST(s[1]));
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Signal_getUsed());
+}
+
+void main()
+{
+  UNITY_BEGIN();
+
+  ACT_setMemClass(&logger, LOGGER_CLASS);
+
+  RUN_TEST(test_reserved_blocks_not_given_to_other_class);
+  RUN_TEST(test_class_uses_shared_blocks_after_reserve);
+  RUN_TEST(test_class_capped_at_max);
+  RUN_TEST(test_no_sender_charged_to_class_0);
+  RUN_TEST(test_types_without_quota_not_limited);
+
+  UNITY_END();
+}
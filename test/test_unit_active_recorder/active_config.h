@@ -0,0 +1,8 @@
+#define ACT_CFG_PORT_SIM 1
+#define ACT_CFG_RECORDER 1
+#define ACT_CFG_RECORDER_LEN 8
+
+/* Asserts are checked by the test */
+struct active_assertinfo;
+void Recorder_assertHandler(struct active_assertinfo *info);
+#define ACT_ASSERT_FN Recorder_assertHandler
@@ -0,0 +1,151 @@
+#include <string.h>
+
+#include <active.h>
+#include <unity.h>
+
+/* Runs on the simulation port. Events posted by the test are processed when it sleeps */
+
+#define MAX_MSG 4
+
+static ACT_QBUF(nodeQBuf, MAX_MSG);
+static ACT_Q(nodeQ);
+static ACT_THREAD(nodeT);
+static ACT_THREAD_STACK_DEFINE(nodeStack, 512);
+static ACT_THREAD_STACK_SIZE(nodeStackSz, nodeStack);
+
+const static ACT_QueueData qdnode = {.maxMsg = MAX_MSG, .queBuf = nodeQBuf, .queue = &nodeQ};
+const static ACT_ThreadData tdnode = {.thread = &nodeT, .pri = 1, .stack = nodeStack, .stack_size = nodeStackSz};
+
+enum TestUserSignal
+{
+  PING_SIG = ACT_USER_SIG,
+  TICK_SIG
+};
+
+Active node;
+
+static ACT_SIGNAL_DEFINE(tickSig, TICK_SIG);
+static ACT_TimEvt tickEvt;
+
+static ACT_Record recs[ACT_CFG_RECORDER_LEN];
+static Active_AssertInfo assertInfo;
+static uint32_t numAsserts;
+
+void Recorder_assertHandler(Active_AssertInfo *info)
+{
+  assertInfo = *info;
+  numAsserts++;
+}
+
+static void node_dispatch(Active *me, ACT_Evt const *const e)
+{
+  ACT_ARG_UNUSED(me);
+  ACT_ARG_UNUSED(e);
+}
+
+static void assertRecord(ACT_Record const *rec, ACT_RecKind kind, Active const *me, ACT_Evt const *e, uint16_t sig)
+{
+  TEST_ASSERT_EQUAL_UINT8(kind, rec->kind);
+  TEST_ASSERT_EQUAL_PTR(me, rec->me);
+  TEST_ASSERT_EQUAL_PTR(e, rec->e);
+  TEST_ASSERT_EQUAL_UINT16(sig, rec->sig);
+}
+
+void setUp(void)
+{
+  numAsserts = 0;
+  memset(recs, 0, sizeof(recs));
+  ACT_Recorder_reset();
+}
+
+void test_post_dispatch_and_free_recorded()
+{
+  ACT_Signal *ping = ACT_Signal_new(&node, PING_SIG);
+  ACT_postEvt(&node, EVT_UPCAST(ping));
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(5, ACT_Recorder_copy(recs, ACT_CFG_RECORDER_LEN));
+  assertRecord(&recs[0], ACT_REC_ALLOC, &node, EVT_UPCAST(ping), 0);
+  TEST_ASSERT_EQUAL_UINT8(ACT_SIGNAL, recs[0].type);
+  assertRecord(&recs[1], ACT_REC_POST, &node, EVT_UPCAST(ping), PING_SIG);
+  assertRecord(&recs[2], ACT_REC_DISPATCH, &node, EVT_UPCAST(ping), PING_SIG);
+  assertRecord(&recs[3], ACT_REC_FREE, &node, EVT_UPCAST(ping), PING_SIG);
+  assertRecord(&recs[4], ACT_REC_DISPATCH_END, &node, EVT_UPCAST(ping), 0);
+  TEST_ASSERT_EQUAL_UINT8(ACT_SIGNAL, recs[4].type);
+}
+
+void test_timer_expiry_recorded()
+{
+  ACT_TimEvt_init(&tickEvt, &node, EVT_UPCAST(&tickSig), &node, NULL);
+  ACT_TimeEvt_start(&tickEvt, 10, 0);
+  ACT_SLEEPMS(20);
+
+  // Expiry, time event processed by node, then the attached signal
+  TEST_ASSERT_EQUAL(7, ACT_Recorder_copy(recs, ACT_CFG_RECORDER_LEN));
+  assertRecord(&recs[0], ACT_REC_TIMER, &node, EVT_UPCAST(&tickEvt), 0);
+  assertRecord(&recs[1], ACT_REC_POST, &node, EVT_UPCAST(&tickEvt), 0);
+  assertRecord(&recs[2], ACT_REC_DISPATCH, &node, EVT_UPCAST(&tickEvt), 0);
+  assertRecord(&recs[3], ACT_REC_POST, &node, EVT_UPCAST(&tickSig), TICK_SIG);
+  assertRecord(&recs[4], ACT_REC_DISPATCH_END, &node, EVT_UPCAST(&tickEvt), 0);
+  assertRecord(&recs[5], ACT_REC_DISPATCH, &node, EVT_UPCAST(&tickSig), TICK_SIG);
+  assertRecord(&recs[6], ACT_REC_DISPATCH_END, &node, EVT_UPCAST(&tickSig), 0);
+  // Simulated time does not pass while events are processed
+  TEST_ASSERT_EQUAL_UINT32(recs[0].cycles, recs[6].cycles);
+}
+
+void test_newest_records_kept()
+{
+  for (uint16_t i = 0; i < ACT_CFG_RECORDER_LEN; i++)
+  {
+    ACT_postEvt(&node, EVT_UPCAST(&tickSig));
+    ACT_SLEEPMS(1);
+  }
+
+  // Three records per post, oldest first
+  TEST_ASSERT_EQUAL(ACT_CFG_RECORDER_LEN, ACT_Recorder_copy(recs, ACT_CFG_RECORDER_LEN));
+  assertRecord(&recs[ACT_CFG_RECORDER_LEN - 1], ACT_REC_DISPATCH_END, &node, EVT_UPCAST(&tickSig), 0);
+  assertRecord(&recs[ACT_CFG_RECORDER_LEN - 2], ACT_REC_DISPATCH, &node, EVT_UPCAST(&tickSig), TICK_SIG);
+  for (size_t i = 1; i < ACT_CFG_RECORDER_LEN; i++)
+  {
+    TEST_ASSERT_TRUE(recs[i].cycles >= recs[i - 1].cycles);
+  }
+
+  TEST_ASSERT_EQUAL(2, ACT_Recorder_copy(recs, 2));
+  TEST_ASSERT_EQUAL_UINT8(ACT_REC_DISPATCH_END, recs[1].kind);
+}
+
+void test_assert_passes_frozen_log()
+{
+  ACT_postEvt(&node, EVT_UPCAST(&tickSig));
+  ACT_SLEEPMS(1);
+
+  ACT_Signal bad;
+  ACT_Signal_init(&bad, &node, ACT_START_SIG);
+  TEST_ASSERT_EQUAL_UINT32(1, numAsserts);
+
+  // Last record before the assert precedes the next record index
+  ACT_Record const *last = &assertInfo.records[(assertInfo.nextRecord - 1u) & (ACT_CFG_RECORDER_LEN - 1u)];
+  assertRecord(last, ACT_REC_DISPATCH_END, &node, EVT_UPCAST(&tickSig), 0);
+  TEST_ASSERT_EQUAL_UINT8(ACT_REC_POST, assertInfo.records[assertInfo.nextRecord - 3u].kind);
+  TEST_ASSERT_EQUAL_UINT8(ACT_REC_NONE, assertInfo.records[assertInfo.nextRecord].kind);
+
+  // Not recorded while frozen
+  ACT_postEvt(&node, EVT_UPCAST(&tickSig));
+  ACT_SLEEPMS(1);
+  TEST_ASSERT_EQUAL(3, ACT_Recorder_copy(recs, ACT_CFG_RECORDER_LEN));
+}
+
+void main()
+{
+  UNITY_BEGIN();
+
+  ACT_init(&node, node_dispatch, &qdnode, &tdnode);
+  ACT_start(&node);
+
+  RUN_TEST(test_post_dispatch_and_free_recorded);
+  RUN_TEST(test_timer_expiry_recorded);
+  RUN_TEST(test_newest_records_kept);
+  RUN_TEST(test_assert_passes_frozen_log);
+
+  UNITY_END();
+}
@@ -0,0 +1,4 @@
+#define ACT_CFG_PORT_SIM 1
+#define ACT_CFG_RPC 1
+#define ACT_CFG_RPC_MAX_PENDING 4
+#define ACT_MEM_NUM_SIGNALS 8
@@ -0,0 +1,200 @@
+#include <active.h>
+#include <unity.h>
+
+/* Runs on the simulation port, so time outs expire at exact virtual times */
+
+#define MAX_MSG 8
+#define TIMEOUT_MS 100
+
+static ACT_QBUF(clientQBuf, MAX_MSG);
+static ACT_QBUF(serverQBuf, MAX_MSG);
+static ACT_Q(clientQ);
+static ACT_Q(serverQ);
+static ACT_THREAD(clientT);
+static ACT_THREAD(serverT);
+static ACT_THREAD_STACK_DEFINE(clientStack, 512);
+static ACT_THREAD_STACK_DEFINE(serverStack, 512);
+static ACT_THREAD_STACK_SIZE(clientStackSz, clientStack);
+static ACT_THREAD_STACK_SIZE(serverStackSz, serverStack);
+
+const static ACT_QueueData qdclient = {.maxMsg = MAX_MSG, .queBuf = clientQBuf, .queue = &clientQ};
+const static ACT_QueueData qdserver = {.maxMsg = MAX_MSG, .queBuf = serverQBuf, .queue = &serverQ};
+
+const static ACT_ThreadData tdclient = {.thread = &clientT, .pri = 1, .stack = clientStack, .stack_size = clientStackSz};
+const static ACT_ThreadData tdserver = {.thread = &serverT, .pri = 2, .stack = serverStack, .stack_size = serverStackSz};
+
+enum TestUserSignal
+{
+  REQ_SIG = ACT_USER_SIG,
+  RSP_SIG
+};
+
+Active client, server;
+
+/* Server replies at once, or keeps the request to reply later */
+static bool serverHolds;
+static ACT_Evt const *heldRequest;
+
+/* Answers received by the client */
+static uint16_t lastSig;
+static uint16_t lastCorrId;
+static int64_t lastAnswerMs;
+static uint32_t answers;
+
+static void server_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_SIGNAL || EVT_CAST(e, ACT_Signal)->sig != REQ_SIG)
+  {
+    return;
+  }
+
+  if (serverHolds)
+  {
+    ACT_mem_refinc(e);
+    heldRequest = e;
+    return;
+  }
+  ACT_reply(e, EVT_UPCAST(ACT_Signal_new(me, RSP_SIG)));
+}
+
+static void client_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_SIGNAL || EVT_CAST(e, ACT_Signal)->sig == ACT_START_SIG)
+  {
+    return;
+  }
+
+  lastSig = EVT_CAST(e, ACT_Signal)->sig;
+  lastCorrId = ACT_getCorrId(e);
+  lastAnswerMs = ACT_TIMEMS_GET();
+  answers++;
+}
+
+static int request()
+{
+  return ACT_request(&server, EVT_UPCAST(ACT_Signal_new(&client, REQ_SIG)), TIMEOUT_MS);
+}
+
+static int replyHeld()
+{
+  int status = ACT_reply(heldRequest, EVT_UPCAST(ACT_Signal_new(&server, RSP_SIG)));
+  ACT_mem_refdec(heldRequest);
+  heldRequest = NULL;
+  return status;
+}
+
+void setUp(void)
+{
+  serverHolds = false;
+  answers = 0;
+  lastSig = 0;
+  lastCorrId = ACT_CORR_NONE;
+}
+
+void tearDown(void)
+{
+  // Let pending time outs expire, then all events and slots are free
+  ACT_SLEEPMS(2 * TIMEOUT_MS);
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Signal_getUsed());
+}
+
+static void test_rpc_reply_is_correlated()
+{
+  int corrId = request();
+  TEST_ASSERT_GREATER_THAN(0, corrId);
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL_UINT32(1, answers);
+  TEST_ASSERT_EQUAL_UINT16(RSP_SIG, lastSig);
+  TEST_ASSERT_EQUAL_UINT16(corrId, lastCorrId);
+
+  // The time out was stopped
+  ACT_SLEEPMS(2 * TIMEOUT_MS);
+  TEST_ASSERT_EQUAL_UINT32(1, answers);
+}
+
+static void test_rpc_timeout_and_late_reply()
+{
+  serverHolds = true;
+  int64_t startMs = ACT_TIMEMS_GET();
+  int corrId = request();
+  ACT_SLEEPMS(2 * TIMEOUT_MS);
+
+  TEST_ASSERT_EQUAL_UINT32(1, answers);
+  TEST_ASSERT_EQUAL_UINT16(ACT_TIMEOUT_SIG, lastSig);
+  TEST_ASSERT_EQUAL_UINT16(corrId, lastCorrId);
+  TEST_ASSERT_EQUAL_INT64(startMs + TIMEOUT_MS, lastAnswerMs);
+
+  // The late reply is dropped and freed
+  TEST_ASSERT_EQUAL_INT(ACT_RPC_ERR_STALE, replyHeld());
+  ACT_SLEEPMS(1);
+  TEST_ASSERT_EQUAL_UINT32(1, answers);
+}
+
+static void test_rpc_pending_table_full()
+{
+  serverHolds = true;
+  for (int i = 0; i < ACT_CFG_RPC_MAX_PENDING; i++)
+  {
+    TEST_ASSERT_GREATER_THAN(0, request());
+    ACT_SLEEPMS(1);
+    // Only the last held request is replied to, the others time out
+    if (heldRequest != NULL && i < ACT_CFG_RPC_MAX_PENDING - 1)
+    {
+      ACT_mem_refdec(heldRequest);
+      heldRequest = NULL;
+    }
+  }
+
+  TEST_ASSERT_EQUAL_INT(ACT_RPC_ERR_FULL, request());
+
+  TEST_ASSERT_EQUAL_INT(ACT_RPC_OK, replyHeld());
+  ACT_SLEEPMS(2 * TIMEOUT_MS);
+  TEST_ASSERT_EQUAL_UINT32(ACT_CFG_RPC_MAX_PENDING, answers);
+
+  // Slots are reused with new correlation IDs
+  for (int i = 0; i < 2 * ACT_CFG_RPC_MAX_PENDING; i++)
+  {
+    serverHolds = false;
+    int corrId = request();
+    ACT_SLEEPMS(1);
+    TEST_ASSERT_EQUAL_UINT16(corrId, lastCorrId);
+    TEST_ASSERT_EQUAL_UINT16(RSP_SIG, lastSig);
+  }
+}
+
+static void test_rpc_call()
+{
+  ACT_Evt const *reply = NULL;
+
+  TEST_ASSERT_EQUAL_INT(ACT_RPC_OK, ACT_call(&server, EVT_UPCAST(ACT_Signal_new(&client, REQ_SIG)), TIMEOUT_MS, &reply));
+  TEST_ASSERT_NOT_NULL(reply);
+  TEST_ASSERT_EQUAL_UINT16(RSP_SIG, EVT_CAST(reply, ACT_Signal)->sig);
+  ACT_mem_refdec(reply);
+
+  serverHolds = true;
+  int64_t startMs = ACT_TIMEMS_GET();
+  TEST_ASSERT_EQUAL_INT(ACT_RPC_ERR_TIMEOUT, ACT_call(&server, EVT_UPCAST(ACT_Signal_new(&client, REQ_SIG)), TIMEOUT_MS, &reply));
+  TEST_ASSERT_EQUAL_INT64(startMs + TIMEOUT_MS, ACT_TIMEMS_GET());
+  TEST_ASSERT_EQUAL_INT(ACT_RPC_ERR_STALE, replyHeld());
+
+  // Replies from plain threads never reach Active objects
+  TEST_ASSERT_EQUAL_UINT32(0, answers);
+}
+
+void main()
+{
+  UNITY_BEGIN();
+
+  ACT_init(&client, client_dispatch, &qdclient, &tdclient);
+  ACT_init(&server, server_dispatch, &qdserver, &tdserver);
+  ACT_start(&client);
+  ACT_start(&server);
+
+  RUN_TEST(test_rpc_reply_is_correlated);
+  RUN_TEST(test_rpc_timeout_and_late_reply);
+  RUN_TEST(test_rpc_pending_table_full);
+  RUN_TEST(test_rpc_call);
+
+  UNITY_END();
+}
@@ -0,0 +1,144 @@
+#include <active.h>
+#include <unity.h>
+
+#define MAX_MSG 4
+
+static ACT_QBUF(hiQBuf, MAX_MSG);
+static ACT_QBUF(loQBuf, MAX_MSG);
+static ACT_Q(hiQ);
+static ACT_Q(loQ);
+static ACT_THREAD(hiT);
+static ACT_THREAD(loT);
+static ACT_THREAD_STACK_DEFINE(hiStack, 512);
+static ACT_THREAD_STACK_DEFINE(loStack, 512);
+static ACT_THREAD_STACK_SIZE(hiStackSz, hiStack);
+static ACT_THREAD_STACK_SIZE(loStackSz, loStack);
+
+const static ACT_QueueData qdhi = {.maxMsg = MAX_MSG, .queBuf = hiQBuf, .queue = &hiQ};
+const static ACT_QueueData qdlo = {.maxMsg = MAX_MSG, .queBuf = loQBuf, .queue = &loQ};
+
+const static ACT_ThreadData tdhi = {.thread = &hiT, .pri = 1, .stack = hiStack, .stack_size = hiStackSz};
+const static ACT_ThreadData tdlo = {.thread = &loT, .pri = 2, .stack = loStack, .stack_size = loStackSz};
+
+enum TestUserSignal
+{
+  TICK_SIG = ACT_USER_SIG,
+  ORDER_SIG
+};
+
+Active hi, lo;
+ACT_Signal tickSig, hiOrderSig, loOrderSig;
+ACT_TimEvt tickEvt;
+ACT_SEM(tickSem);
+
+static uint32_t ticks;
+static int64_t lastTickMs;
+static Active *order[2];
+static size_t numOrder;
+
+static void dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_SIGNAL)
+  {
+    return;
+  }
+
+  switch (EVT_CAST(e, ACT_Signal)->sig)
+  {
+  case TICK_SIG:
+    ticks++;
+    lastTickMs = ACT_TIMEMS_GET();
+    ACT_SEM_GIVE(&tickSem);
+    break;
+  case ORDER_SIG:
+    order[numOrder++] = me;
+    break;
+  }
+}
+
+static void reset()
+{
+  ticks = 0;
+  numOrder = 0;
+  ACT_SEM_INIT(&tickSem);
+}
+
+static void test_sim_oneshot_exact_time()
+{
+  reset();
+  int64_t start = ACT_TIMEMS_GET();
+
+  ACT_TimeEvt_start(&tickEvt, 1000, 0);
+  ACT_SLEEPMS(999);
+  TEST_ASSERT_EQUAL_UINT32(0, ticks);
+
+  ACT_SLEEPMS(1);
+  TEST_ASSERT_EQUAL_UINT32(1, ticks);
+  TEST_ASSERT_EQUAL(start + 1000, lastTickMs);
+}
+
+static void test_sim_periodic_hour()
+{
+  reset();
+  int64_t start = ACT_TIMEMS_GET();
+
+  /* One hour of a 1 s periodic timer runs in virtual time */
+  ACT_TimeEvt_start(&tickEvt, 1000, 1000);
+  ACT_SLEEPMS(3600 * 1000);
+  ACT_TimeEvt_stop(&tickEvt);
+
+  TEST_ASSERT_EQUAL_UINT32(3600, ticks);
+  TEST_ASSERT_EQUAL(start + 3600 * 1000, lastTickMs);
+  TEST_ASSERT_EQUAL(start + 3600 * 1000, ACT_TIMEMS_GET());
+}
+
+static void test_sim_sem_jumps_to_expiry()
+{
+  reset();
+  int64_t start = ACT_TIMEMS_GET();
+
+  /* Waiting on a semaphore with all Active objects idle jumps to the next timer expiry */
+  ACT_TimeEvt_start(&tickEvt, 5000, 0);
+  ACT_SEM_TAKE(&tickSem);
+
+  TEST_ASSERT_EQUAL_UINT32(1, ticks);
+  TEST_ASSERT_EQUAL(start + 5000, ACT_TIMEMS_GET());
+}
+
+static void test_sim_priority_order()
+{
+  reset();
+
+  /* Higher priority Active object runs first, independent of posting order */
+  ACT_postEvt(&lo, EVT_UPCAST(&loOrderSig));
+  ACT_postEvt(&hi, EVT_UPCAST(&hiOrderSig));
+  TEST_ASSERT_EQUAL_UINT32(0, numOrder);
+
+  ACT_SLEEPMS(0);
+
+  TEST_ASSERT_EQUAL_UINT32(2, numOrder);
+  TEST_ASSERT_EQUAL_PTR(&hi, order[0]);
+  TEST_ASSERT_EQUAL_PTR(&lo, order[1]);
+}
+
+int main(void)
+{
+  UNITY_BEGIN();
+
+  ACT_init(&hi, dispatch, &qdhi, &tdhi);
+  ACT_init(&lo, dispatch, &qdlo, &tdlo);
+  ACT_start(&hi);
+  ACT_start(&lo);
+
+  ACT_Signal_init(&tickSig, &hi, TICK_SIG);
+  ACT_Signal_init(&hiOrderSig, &hi, ORDER_SIG);
+  ACT_Signal_init(&loOrderSig, &lo, ORDER_SIG);
+  ACT_TimEvt_init(&tickEvt, &hi, EVT_UPCAST(&tickSig), &hi, NULL);
+
+  RUN_TEST(test_sim_oneshot_exact_time);
+  RUN_TEST(test_sim_periodic_hour);
+  RUN_TEST(test_sim_sem_jumps_to_expiry);
+  RUN_TEST(test_sim_priority_order);
+
+  return UNITY_END();
+}
@@ -0,0 +1 @@
+#define ACT_CFG_PORT_SIM 1
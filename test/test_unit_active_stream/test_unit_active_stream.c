@@ -0,0 +1,204 @@
+#include <string.h>
+
+#include <active.h>
+#include <unity.h>
+
+/* Runs on the simulation port. The test writes to the streams as producer, consumers read when it sleeps */
+
+#define MAX_MSG 4
+#define RING_SIZE 16
+#define FRAME_SIZE 4
+
+static ACT_QBUF(readerQBuf, MAX_MSG);
+static ACT_Q(readerQ);
+static ACT_THREAD(readerT);
+static ACT_THREAD_STACK_DEFINE(readerStack, 512);
+static ACT_THREAD_STACK_SIZE(readerStackSz, readerStack);
+
+static ACT_QBUF(framerQBuf, MAX_MSG);
+static ACT_Q(framerQ);
+static ACT_THREAD(framerT);
+static ACT_THREAD_STACK_DEFINE(framerStack, 512);
+static ACT_THREAD_STACK_SIZE(framerStackSz, framerStack);
+
+const static ACT_QueueData qdreader = {.maxMsg = MAX_MSG, .queBuf = readerQBuf, .queue = &readerQ};
+const static ACT_ThreadData tdreader = {.thread = &readerT, .pri = 1, .stack = readerStack, .stack_size = readerStackSz};
+const static ACT_QueueData qdframer = {.maxMsg = MAX_MSG, .queBuf = framerQBuf, .queue = &framerQ};
+const static ACT_ThreadData tdframer = {.thread = &framerT, .pri = 1, .stack = framerStack, .stack_size = framerStackSz};
+
+enum TestUserSignal
+{
+  RX_SIG = ACT_USER_SIG
+};
+
+Active producer;
+Active reader;
+Active framer;
+
+static ACT_STREAM_BUF(readerRing, RING_SIZE);
+static ACT_STREAM_BUF(framerRing, RING_SIZE);
+static ACT_Stream readerStream;
+static ACT_Stream framerStream;
+
+static uint8_t received[64];
+static size_t numReceived;
+static size_t numWakes;
+static size_t numFrames;
+
+/* Reads all unread bytes */
+static void reader_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_SIGNAL || EVT_CAST(e, ACT_Signal)->sig != RX_SIG)
+  {
+    return;
+  }
+
+  numWakes++;
+  uint32_t len;
+  uint8_t const *bytes;
+  while ((bytes = ACT_Stream_peek(&readerStream, &len)) != NULL)
+  {
+    memcpy(&received[numReceived], bytes, len);
+    numReceived += len;
+    ACT_Stream_consume(&readerStream, len);
+  }
+}
+
+/* Reads whole frames only, woken when a frame is unread */
+static void framer_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (e->type != ACT_SIGNAL || EVT_CAST(e, ACT_Signal)->sig != RX_SIG)
+  {
+    return;
+  }
+
+  numWakes++;
+  uint32_t len;
+  while (ACT_Stream_peek(&framerStream, &len) != NULL && ACT_Stream_getUnread(&framerStream) >= FRAME_SIZE)
+  {
+    // Frame may wrap around the end of the ring
+    uint32_t left = FRAME_SIZE;
+    while (left > 0)
+    {
+      ACT_Stream_peek(&framerStream, &len);
+      len = len < left ? len : left;
+      ACT_Stream_consume(&framerStream, len);
+      left -= len;
+    }
+    numFrames++;
+  }
+}
+
+/* Writes bytes as producer, wrapping around the end of the ring. Returns number of bytes written */
+static size_t produce(ACT_Stream *s, uint8_t first, size_t n)
+{
+  size_t written = 0;
+  while (written < n)
+  {
+    uint32_t len;
+    uint8_t *region = ACT_Stream_reserve(s, &len);
+    if (region == NULL)
+    {
+      break;
+    }
+    len = (n - written) < len ? (uint32_t)(n - written) : len;
+    for (uint32_t i = 0; i < len; i++)
+    {
+      region[i] = (uint8_t)(first + written + i);
+    }
+    ACT_Stream_commit(s, len);
+    written += len;
+  }
+  return written;
+}
+
+void setUp(void)
+{
+  numReceived = 0;
+  numWakes = 0;
+  numFrames = 0;
+  memset(received, 0, sizeof(received));
+}
+
+void test_commits_wake_idle_reader_once()
+{
+  produce(&readerStream, 0, 3);
+  produce(&readerStream, 3, 3);
+  produce(&readerStream, 6, 3);
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(1, numWakes);
+  TEST_ASSERT_EQUAL(9, numReceived);
+  for (size_t i = 0; i < numReceived; i++)
+  {
+    TEST_ASSERT_EQUAL_UINT8(i, received[i]);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_Stream_getUnread(&readerStream));
+}
+
+void test_wraps_around_ring()
+{
+  // Ring has 9 bytes written from the previous test, so this wraps
+  TEST_ASSERT_EQUAL(12, produce(&readerStream, 100, 12));
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(1, numWakes);
+  TEST_ASSERT_EQUAL(12, numReceived);
+  for (size_t i = 0; i < numReceived; i++)
+  {
+    TEST_ASSERT_EQUAL_UINT8(100 + i, received[i]);
+  }
+}
+
+void test_full_ring_rejects_reserve()
+{
+  TEST_ASSERT_EQUAL(RING_SIZE, produce(&readerStream, 0, RING_SIZE + 4));
+
+  uint32_t len;
+  TEST_ASSERT_NULL(ACT_Stream_reserve(&readerStream, &len));
+  TEST_ASSERT_EQUAL_UINT32(0, len);
+  ACT_SLEEPMS(1);
+
+  TEST_ASSERT_EQUAL(RING_SIZE, numReceived);
+  TEST_ASSERT_NOT_NULL(ACT_Stream_reserve(&readerStream, &len));
+}
+
+void test_threshold_wakes_on_whole_frames()
+{
+  produce(&framerStream, 0, FRAME_SIZE - 1);
+  ACT_SLEEPMS(1);
+  TEST_ASSERT_EQUAL(0, numWakes);
+
+  produce(&framerStream, 0, 1);
+  produce(&framerStream, 0, FRAME_SIZE + 2);
+  ACT_SLEEPMS(1);
+
+  // Partial frame stays unread until completed
+  TEST_ASSERT_EQUAL(1, numWakes);
+  TEST_ASSERT_EQUAL(2, numFrames);
+  TEST_ASSERT_EQUAL_UINT32(2, ACT_Stream_getUnread(&framerStream));
+
+  produce(&framerStream, 0, 2);
+  ACT_SLEEPMS(1);
+  TEST_ASSERT_EQUAL(2, numWakes);
+  TEST_ASSERT_EQUAL(3, numFrames);
+}
+
+void main()
+{
+  UNITY_BEGIN();
+
+  ACT_init(&reader, reader_dispatch, &qdreader, &tdreader);
+  ACT_init(&framer, framer_dispatch, &qdframer, &tdframer);
+  ACT_Stream_init(&readerStream, &producer, &reader, readerRing, RING_SIZE, 1, RX_SIG);
+  ACT_Stream_init(&framerStream, &producer, &framer, framerRing, RING_SIZE, FRAME_SIZE, RX_SIG);
+  ACT_start(&reader);
+  ACT_start(&framer);
+
+  RUN_TEST(test_commits_wake_idle_reader_once);
+  RUN_TEST(test_wraps_around_ring);
+  RUN_TEST(test_full_ring_rejects_reserve);
+  RUN_TEST(test_threshold_wakes_on_whole_frames);
+
+  UNITY_END();
+}
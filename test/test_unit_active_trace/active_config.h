@@ -0,0 +1,4 @@
+#define ACT_CFG_PORT_SIM 1
+#define ACT_CFG_TRACE 1
+#define ACT_MEM_NUM_SIGNALS 4
+#define ACT_MEM_NUM_MESSAGES 4
@@ -0,0 +1,206 @@
+#include <string.h>
+
+#include <active.h>
+#include <unity.h>
+
+/* Runs on the simulation port, so recorded and replayed time stamps are exact */
+
+#define MAX_MSG 4
+#define MAX_LOG 8
+
+static ACT_QBUF(rxQBuf, MAX_MSG);
+static ACT_QBUF(txQBuf, MAX_MSG);
+static ACT_Q(rxQ);
+static ACT_Q(txQ);
+static ACT_THREAD(rxT);
+static ACT_THREAD(txT);
+static ACT_THREAD_STACK_DEFINE(rxStack, 512);
+static ACT_THREAD_STACK_DEFINE(txStack, 512);
+static ACT_THREAD_STACK_SIZE(rxStackSz, rxStack);
+static ACT_THREAD_STACK_SIZE(txStackSz, txStack);
+
+const static ACT_QueueData qdrx = {.maxMsg = MAX_MSG, .queBuf = rxQBuf, .queue = &rxQ};
+const static ACT_QueueData qdtx = {.maxMsg = MAX_MSG, .queBuf = txQBuf, .queue = &txQ};
+
+const static ACT_ThreadData tdrx = {.thread = &rxT, .pri = 1, .stack = rxStack, .stack_size = rxStackSz};
+const static ACT_ThreadData tdtx = {.thread = &txT, .pri = 1, .stack = txStack, .stack_size = txStackSz};
+
+enum TestUserSignal
+{
+  A_SIG = ACT_USER_SIG,
+  B_SIG,
+  DATA_MSG
+};
+
+Active rx, tx;
+ACT_Signal aSig, bSig;
+ACT_Message dataMsg;
+static char payload[] = "hello";
+
+static _Alignas(4) char traceBuf[256];
+
+typedef struct
+{
+  int64_t timeMs;
+  uint16_t sig;
+  char data[8];
+} LogEntry;
+
+static LogEntry rxLog[MAX_LOG];
+static size_t numLog;
+
+static void rx_dispatch(Active *me, ACT_Evt const *const e)
+{
+  if (numLog == MAX_LOG)
+  {
+    return;
+  }
+
+  LogEntry *l = &rxLog[numLog];
+  memset(l, 0, sizeof(*l));
+  l->timeMs = ACT_TIMEMS_GET();
+
+  if (e->type == ACT_SIGNAL && EVT_CAST(e, ACT_Signal)->sig != ACT_START_SIG)
+  {
+    l->sig = EVT_CAST(e, ACT_Signal)->sig;
+    numLog++;
+  }
+  else if (e->type == ACT_MESSAGE)
+  {
+    ACT_Message const *m = EVT_CAST(e, ACT_Message);
+    l->sig = m->header;
+    memcpy(l->data, m->payload, m->payloadLen < sizeof(l->data) ? m->payloadLen : sizeof(l->data));
+    numLog++;
+  }
+}
+
+static void tx_dispatch(Active *me, ACT_Evt const *const e)
+{
+}
+
+static void record(void)
+{
+  ACT_Trace_start(traceBuf, sizeof(traceBuf));
+
+  ACT_postEvt(&rx, EVT_UPCAST(&aSig));
+  ACT_SLEEPMS(100);
+  ACT_postEvt(&rx, EVT_UPCAST(&dataMsg));
+  ACT_SLEEPMS(150);
+  ACT_postEvt(&rx, EVT_UPCAST(&bSig));
+  ACT_SLEEPMS(10);
+
+  ACT_Trace_stop();
+}
+
+static void test_trace_record()
+{
+  record();
+
+  /* Two signals and a message with 6 payload bytes padded to 8 */
+  TEST_ASSERT_EQUAL(3 * sizeof(ACT_TraceRecord) + 8, ACT_Trace_getLen());
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_Trace_getDropped());
+
+  ACT_TraceRecord rec;
+  memcpy(&rec, traceBuf, sizeof(rec));
+  TEST_ASSERT_EQUAL_UINT32(0, rec.timeUs);
+  TEST_ASSERT_EQUAL_UINT8(ACT_SIGNAL, rec.type);
+  TEST_ASSERT_EQUAL_UINT16(A_SIG, rec.sig);
+  TEST_ASSERT_EQUAL_UINT16(ACT_getHandle(&tx), rec.sender);
+  TEST_ASSERT_EQUAL_UINT16(ACT_getHandle(&rx), rec.receiver);
+
+  memcpy(&rec, traceBuf + sizeof(rec), sizeof(rec));
+  TEST_ASSERT_EQUAL_UINT32(100000, rec.timeUs);
+  TEST_ASSERT_EQUAL_UINT8(ACT_MESSAGE, rec.type);
+  TEST_ASSERT_EQUAL_UINT16(DATA_MSG, rec.sig);
+  TEST_ASSERT_EQUAL_UINT8(sizeof(payload), rec.payloadLen);
+  TEST_ASSERT_EQUAL_MEMORY(payload, traceBuf + 2 * sizeof(rec), sizeof(payload));
+}
+
+static void test_trace_replay_speedup()
+{
+  numLog = 0;
+  int64_t start = ACT_TIMEMS_GET();
+
+  /* Replay 10 times faster than recorded */
+  TEST_ASSERT_EQUAL_UINT32(3, ACT_Trace_replay(traceBuf, ACT_Trace_getLen(), 10, NULL));
+  ACT_SLEEPMS(10);
+
+  TEST_ASSERT_EQUAL_UINT32(3, numLog);
+  TEST_ASSERT_EQUAL_UINT16(A_SIG, rxLog[0].sig);
+  TEST_ASSERT_EQUAL(start, rxLog[0].timeMs);
+  TEST_ASSERT_EQUAL_UINT16(DATA_MSG, rxLog[1].sig);
+  TEST_ASSERT_EQUAL(start + 10, rxLog[1].timeMs);
+  TEST_ASSERT_EQUAL_MEMORY(payload, rxLog[1].data, sizeof(payload));
+  TEST_ASSERT_EQUAL_UINT16(B_SIG, rxLog[2].sig);
+  TEST_ASSERT_EQUAL(start + 25, rxLog[2].timeMs);
+
+  /* Replayed events are freed after processing */
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Signal_getUsed());
+  TEST_ASSERT_EQUAL_UINT32(0, ACT_mem_Message_getUsed());
+}
+
+static bool only_signals(ACT_TraceRecord const *rec)
+{
+  return rec->type == ACT_SIGNAL;
+}
+
+static void test_trace_replay_filter()
+{
+  numLog = 0;
+
+  TEST_ASSERT_EQUAL_UINT32(2, ACT_Trace_replay(traceBuf, ACT_Trace_getLen(), 0, only_signals));
+  ACT_SLEEPMS(10);
+
+  TEST_ASSERT_EQUAL_UINT32(2, numLog);
+}
+
+static void test_trace_stats()
+{
+  ACT_Trace_resetStats();
+
+  ACT_postEvt(&rx, EVT_UPCAST(&aSig));
+  ACT_postEvt(&rx, EVT_UPCAST(&bSig));
+  ACT_postEvt(&rx, EVT_UPCAST(&aSig));
+  ACT_SLEEPMS(10);
+
+  ACT_TraceStats stats;
+  ACT_Trace_getStats(&rx, &stats);
+  TEST_ASSERT_EQUAL_UINT32(3, stats.events);
+  TEST_ASSERT_EQUAL_UINT32(3, stats.maxQueueDepth);
+}
+
+static void test_trace_dropped()
+{
+  /* Room for one signal record only */
+  ACT_Trace_start(traceBuf, sizeof(ACT_TraceRecord) + 4);
+
+  ACT_postEvt(&rx, EVT_UPCAST(&aSig));
+  ACT_postEvt(&rx, EVT_UPCAST(&bSig));
+  ACT_SLEEPMS(10);
+  ACT_Trace_stop();
+
+  TEST_ASSERT_EQUAL(sizeof(ACT_TraceRecord), ACT_Trace_getLen());
+  TEST_ASSERT_EQUAL_UINT32(1, ACT_Trace_getDropped());
+}
+
+int main(void)
+{
+  UNITY_BEGIN();
+
+  ACT_init(&rx, rx_dispatch, &qdrx, &tdrx);
+  ACT_init(&tx, tx_dispatch, &qdtx, &tdtx);
+  ACT_start(&rx);
+  ACT_start(&tx);
+
+  ACT_Signal_init(&aSig, &tx, A_SIG);
+  ACT_Signal_init(&bSig, &tx, B_SIG);
+  ACT_Message_init(&dataMsg, &tx, DATA_MSG, payload, sizeof(payload));
+
+  RUN_TEST(test_trace_record);
+  RUN_TEST(test_trace_replay_speedup);
+  RUN_TEST(test_trace_replay_filter);
+  RUN_TEST(test_trace_stats);
+  RUN_TEST(test_trace_dropped);
+
+  return UNITY_END();
+}